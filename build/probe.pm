@@ -430,6 +430,30 @@ EOT
     $config->{has_fn_malloc_trim} = $can || 0
 }
 
+# Only checks that the kernel headers know about io_uring; whether the
+# running kernel supports it (and lets us use it) is found out at startup.
+sub check_io_uring {
+    my ($config) = @_;
+    my $restore = _to_probe_dir();
+    _spew('try.c', <<'EOT');
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+int main(int argc, char **argv) {
+    struct io_uring_params p = { 0 };
+    (void)p;
+    return __NR_io_uring_setup && __NR_io_uring_enter && __NR_io_uring_register
+        && IORING_OP_READ && IORING_OP_WRITE && IORING_REGISTER_PROBE ? 0 : 1;
+}
+EOT
+
+    print ::dots('    probing existance of optional io_uring');
+    my $can = compile($config, 'try');
+    print $can ? "YES\n": "NO\n";
+    $config->{has_io_uring} = $can || 0
+}
+
 sub C_type_bool {
     my ($config) = @_;
     my $restore = _to_probe_dir();
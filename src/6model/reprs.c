@@ -255,6 +255,9 @@ void MVM_repr_initialize_registry(MVMThreadContext *tc) {
     register_core_repr(Decoder);
     register_core_repr(SpeshLog);
     register_core_repr(StaticFrameSpesh);
+    register_core_repr(StringBuilder);
+    register_core_repr(MultiSearch);
+    register_core_repr(MappedBuffer);
 
     tc->instance->num_reprs = MVM_REPR_CORE_COUNT;
 }
@@ -239,6 +239,16 @@ void MVM_decoder_add_bytes(MVMThreadContext *tc, MVMDecoder *decoder, MVMObject
         MVM_string_decodestream_add_bytes(tc, ds, copy, output_size);
         exit_single_user(tc, decoder);
     }
+    else if (REPR(buffer)->ID == MVM_REPR_ID_MappedBuffer) {
+        /* The decode stream takes ownership of the bytes it is given, so
+         * they are copied out of the mapping, but only the once. */
+        MVMMappedBufferBody *body = &((MVMMappedBuffer *)buffer)->body;
+        char *copy = MVM_malloc(body->length ? body->length : 1);
+        memcpy(copy, body->data, body->length);
+        enter_single_user(tc, decoder);
+        MVM_string_decodestream_add_bytes(tc, ds, copy, body->length);
+        exit_single_user(tc, decoder);
+    }
     else {
         MVM_exception_throw_adhoc(tc, "Cannot add bytes to a decoder with a %s",
             REPR(buffer)->name);
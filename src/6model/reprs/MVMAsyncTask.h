@@ -23,6 +23,10 @@ struct MVMAsyncTaskBody {
     /* The cancellation notification handler, if any. */
     MVMObject *cancel_notify_schedulee;
 
+    /* The event loop the task runs on; set when it is first queued, unless
+     * it was pinned to a loop before that. */
+    MVMEventLoop *loop;
+
     /* The current state of the task. */
     MVMint32 state;
 };
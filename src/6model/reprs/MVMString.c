@@ -33,6 +33,13 @@ static void copy_to(MVMThreadContext *tc, MVMSTable *st, void *src, MVMObject *d
                     dest_body->num_graphs * sizeof(MVMGrapheme32));
             }
             break;
+        case MVM_STRING_GRAPHEME_16:
+            if (dest_body->num_graphs) {
+                dest_body->storage.blob_16 = MVM_malloc(dest_body->num_graphs * sizeof(MVMGrapheme16));
+                memcpy(dest_body->storage.blob_16, src_body->storage.blob_16,
+                    dest_body->num_graphs * sizeof(MVMGrapheme16));
+            }
+            break;
         case MVM_STRING_GRAPHEME_ASCII:
         case MVM_STRING_GRAPHEME_8:
             if (dest_body->num_graphs) {
@@ -94,6 +101,8 @@ static MVMuint64 unmanaged_size(MVMThreadContext *tc, MVMSTable *st, void *data)
     switch (body->storage_type) {
         case MVM_STRING_GRAPHEME_32:
             return sizeof(MVMGrapheme32) * body->num_graphs;
+        case MVM_STRING_GRAPHEME_16:
+            return sizeof(MVMGrapheme16) * body->num_graphs;
         case MVM_STRING_STRAND:
             return sizeof(MVMStringStrand) * body->num_strands;
         default:
@@ -1,7 +1,9 @@
 /* Representation used by VM-level strings.
  *
- * Strings come in one of 3 forms today, with 1 expected future form:
+ * Strings come in one of 4 forms today, with 1 expected future form:
  *   - 32-bit buffer of graphemes (Unicode codepoints or synthetic codepoints)
+ *   - 16-bit buffer of codepoints that all fall in the Basic Multilingual
+ *     Plane; there are no synthetics in this form, so it is unsigned
  *   - 8-bit buffer of codepoints that all fall in the ASCII range
  *   - Buffer of strands
  *   - (LATER) 8-bit buffer of codepoints with negatives as synthetics (we
@@ -19,12 +21,14 @@
 typedef MVMint32 MVMGrapheme32;
 typedef MVMint8  MVMGraphemeASCII;
 typedef MVMint8  MVMGrapheme8;       /* Future use */
+typedef MVMuint16 MVMGrapheme16;
 
 /* What kind of data is a string storing? */
 #define MVM_STRING_GRAPHEME_32      0
 #define MVM_STRING_GRAPHEME_ASCII   1
 #define MVM_STRING_GRAPHEME_8       2
 #define MVM_STRING_STRAND           3
+#define MVM_STRING_GRAPHEME_16      4
 
 /* String index data type, for when we talk about indexes. */
 typedef MVMuint32 MVMStringIndex;
@@ -39,6 +43,7 @@ typedef MVMint32 MVMCodepoint;
 struct MVMStringBody {
     union {
         MVMGrapheme32    *blob_32;
+        MVMGrapheme16    *blob_16;
         MVMGraphemeASCII *blob_ascii;
         MVMGrapheme8     *blob_8;
         MVMStringStrand  *strands;
@@ -0,0 +1,342 @@
+#include "moar.h"
+#include "platform/mmap.h"
+
+/* This representation's function pointer table. */
+static const MVMREPROps MappedBuffer_this_repr;
+
+/* Creates a new type object of this representation, and associates it with
+ * the given HOW. */
+static MVMObject * type_object_for(MVMThreadContext *tc, MVMObject *HOW) {
+    MVMSTable *st  = MVM_gc_allocate_stable(tc, &MappedBuffer_this_repr, HOW);
+
+    MVMROOT(tc, st, {
+        MVMObject *obj = MVM_gc_allocate_type_object(tc, st);
+        MVM_ASSIGN_REF(tc, &(st->header), st->WHAT, obj);
+        st->size = sizeof(MVMMappedBuffer);
+    });
+
+    return st->WHAT;
+}
+
+/* Copies the body of one object to another. */
+static void copy_to(MVMThreadContext *tc, MVMSTable *st, void *src, MVMObject *dest_root, void *dest) {
+    MVM_exception_throw_adhoc(tc, "Cannot copy object with representation MappedBuffer");
+}
+
+/* Adds held objects to the GC worklist. */
+static void gc_mark(MVMThreadContext *tc, MVMSTable *st, void *data, MVMGCWorklist *worklist) {
+    MVMMappedBufferBody *body = (MVMMappedBufferBody *)data;
+    MVM_gc_worklist_add(tc, worklist, &body->owner);
+}
+
+/* Called by the VM in order to free memory associated with this object. */
+static void gc_free(MVMThreadContext *tc, MVMObject *obj) {
+    MVMMappedBufferBody *body = &((MVMMappedBuffer *)obj)->body;
+    if (body->block)
+        MVM_platform_unmap_file(body->block, body->handle, body->block_size);
+}
+
+static const MVMStorageSpec storage_spec = {
+    MVM_STORAGE_SPEC_REFERENCE, /* inlineable */
+    0,                          /* bits */
+    0,                          /* align */
+    MVM_STORAGE_SPEC_BP_NONE,   /* boxed_primitive */
+    0,                          /* can_box */
+    0,                          /* is_unsigned */
+};
+
+/* Gets the storage specification for this representation. */
+static const MVMStorageSpec * get_storage_spec(MVMThreadContext *tc, MVMSTable *st) {
+    return &storage_spec;
+}
+
+/* Reads a byte; like a native array, reading past the end gives 0. */
+static void at_pos(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMint64 index, MVMRegister *value, MVMuint16 kind) {
+    MVMMappedBufferBody *body = (MVMMappedBufferBody *)data;
+    if (kind != MVM_reg_int64)
+        MVM_exception_throw_adhoc(tc, "MappedBuffer: atpos expected int register");
+    if (index < 0) {
+        index += body->length;
+        if (index < 0)
+            MVM_exception_throw_adhoc(tc, "MappedBuffer: Index out of bounds");
+    }
+    value->i64 = (MVMuint64)index < body->length ? (MVMint64)body->data[index] : 0;
+}
+
+static void read_only(MVMThreadContext *tc) {
+    MVM_exception_throw_adhoc(tc, "Cannot modify a MappedBuffer, which is read-only");
+}
+static void bind_pos(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMint64 index, MVMRegister value, MVMuint16 kind) {
+    read_only(tc);
+}
+static void set_elems(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMuint64 count) {
+    read_only(tc);
+}
+static void push(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMRegister value, MVMuint16 kind) {
+    read_only(tc);
+}
+static void pop(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMRegister *value, MVMuint16 kind) {
+    read_only(tc);
+}
+static void unshift(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMRegister value, MVMuint16 kind) {
+    read_only(tc);
+}
+static void shift(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMRegister *value, MVMuint16 kind) {
+    read_only(tc);
+}
+static void asplice(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMObject *from, MVMint64 offset, MVMuint64 count) {
+    read_only(tc);
+}
+
+static MVMuint64 elems(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data) {
+    return ((MVMMappedBufferBody *)data)->length;
+}
+
+/* The elements are unsigned bytes. */
+static MVMStorageSpec get_elem_storage_spec(MVMThreadContext *tc, MVMSTable *st) {
+    MVMStorageSpec spec;
+    spec.inlineable      = MVM_STORAGE_SPEC_INLINED;
+    spec.bits            = 8;
+    spec.align           = 1;
+    spec.boxed_primitive = MVM_STORAGE_SPEC_BP_INT;
+    spec.can_box         = MVM_STORAGE_SPEC_CAN_BOX_INT;
+    spec.is_unsigned     = 1;
+    return spec;
+}
+
+/* Compose the representation. */
+static void compose(MVMThreadContext *tc, MVMSTable *st, MVMObject *info) {
+    /* Nothing to do for this REPR. */
+}
+
+/* Set the size of the STable. */
+static void deserialize_stable_size(MVMThreadContext *tc, MVMSTable *st, MVMSerializationReader *reader) {
+    st->size = sizeof(MVMMappedBuffer);
+}
+
+/* Calculates the non-GC-managed memory we hold on to. The mapping is backed
+ * by the file rather than by memory of our own, so it isn't counted. */
+static MVMuint64 unmanaged_size(MVMThreadContext *tc, MVMSTable *st, void *data) {
+    return 0;
+}
+
+/* Initializes the representation. */
+const MVMREPROps * MVMMappedBuffer_initialize(MVMThreadContext *tc) {
+    return &MappedBuffer_this_repr;
+}
+
+static const MVMREPROps MappedBuffer_this_repr = {
+    type_object_for,
+    MVM_gc_allocate_object,
+    NULL, /* initialize */
+    copy_to,
+    MVM_REPR_DEFAULT_ATTR_FUNCS,
+    MVM_REPR_DEFAULT_BOX_FUNCS,
+    {
+        at_pos,
+        bind_pos,
+        set_elems,
+        push,
+        pop,
+        unshift,
+        shift,
+        MVM_REPR_DEFAULT_SLICE,
+        asplice,
+        MVM_REPR_DEFAULT_AT_POS_MULTIDIM,
+        MVM_REPR_DEFAULT_BIND_POS_MULTIDIM,
+        MVM_REPR_DEFAULT_DIMENSIONS,
+        MVM_REPR_DEFAULT_SET_DIMENSIONS,
+        get_elem_storage_spec,
+        MVM_REPR_DEFAULT_POS_AS_ATOMIC,
+        MVM_REPR_DEFAULT_POS_AS_ATOMIC_MULTIDIM
+    },    /* pos_funcs */
+    MVM_REPR_DEFAULT_ASS_FUNCS,
+    elems,
+    get_storage_spec,
+    NULL, /* change_type */
+    NULL, /* serialize */
+    NULL, /* deserialize */
+    NULL, /* serialize_repr_data */
+    NULL, /* deserialize_repr_data */
+    deserialize_stable_size,
+    gc_mark,
+    gc_free,
+    NULL, /* gc_cleanup */
+    NULL, /* gc_mark_repr_data */
+    NULL, /* gc_free_repr_data */
+    compose,
+    NULL, /* spesh */
+    "MappedBuffer", /* name */
+    MVM_REPR_ID_MappedBuffer,
+    unmanaged_size,
+    NULL, /* describe_refs */
+};
+
+/* Assert that the passed object really is a mapped buffer; throw if not. */
+void MVM_mapped_buffer_ensure(MVMThreadContext *tc, MVMObject *buf, const char *op) {
+    if (MVM_UNLIKELY(REPR(buf)->ID != MVM_REPR_ID_MappedBuffer || !IS_CONCRETE(buf)))
+        MVM_exception_throw_adhoc(tc,
+            "Operation '%s' can only work on an object with the MappedBuffer representation",
+            op);
+}
+
+/* Checks that a range lies within a buffer of the given length, resolving a
+ * negative length to mean the rest of it. */
+static MVMuint64 check_range(MVMThreadContext *tc, MVMuint64 available, MVMint64 offset,
+        MVMint64 length, const char *op) {
+    if (offset < 0 || (MVMuint64)offset > available)
+        MVM_exception_throw_adhoc(tc, "%s: offset %"PRId64" is out of range", op, offset);
+    if (length < 0)
+        return available - offset;
+    if ((MVMuint64)length > available - offset)
+        MVM_exception_throw_adhoc(tc, "%s: range of %"PRId64" bytes at offset %"PRId64" goes past the end",
+            op, length, offset);
+    return (MVMuint64)length;
+}
+
+/* Maps length bytes of a file, starting at offset, into a new buffer of the
+ * given type; a negative length means up to the end of the file. */
+MVMObject * MVM_mapped_buffer_open(MVMThreadContext *tc, MVMObject *type, MVMString *filename,
+        MVMint64 offset, MVMint64 length) {
+    MVMMappedBuffer *result;
+    char      *fname;
+    uv_fs_t    req;
+    uv_file    fd;
+    MVMuint64  size;
+    MVMuint64  map_offset;
+    size_t     slack;
+    void      *block  = NULL;
+    void      *handle = NULL;
+
+    if (REPR(type)->ID != MVM_REPR_ID_MappedBuffer)
+        MVM_exception_throw_adhoc(tc, "mmapfile requires a type with REPR MappedBuffer");
+    MVM_string_check_arg(tc, filename, "mmapfile");
+
+    fname = MVM_string_utf8_c8_encode_C_string(tc, filename);
+    if ((fd = uv_fs_open(NULL, &req, fname, O_RDONLY, 0, NULL)) < 0) {
+        char *waste[] = { fname, NULL };
+        MVM_exception_throw_adhoc_free(tc, waste, "While trying to open '%s': %s",
+            fname, uv_strerror(req.result));
+    }
+    if (uv_fs_fstat(NULL, &req, fd, NULL) < 0) {
+        char *waste[] = { fname, NULL };
+        uv_fs_close(NULL, &req, fd, NULL);
+        MVM_exception_throw_adhoc_free(tc, waste, "While trying to stat '%s': %s",
+            fname, uv_strerror(req.result));
+    }
+    size = req.statbuf.st_size;
+    if (offset < 0 || (MVMuint64)offset > size || (length >= 0 && (MVMuint64)length > size - offset)) {
+        char *waste[] = { fname, NULL };
+        uv_fs_close(NULL, &req, fd, NULL);
+        MVM_exception_throw_adhoc_free(tc, waste,
+            "Cannot map %"PRId64" bytes at offset %"PRId64" of '%s', which is %"PRIu64" bytes long",
+            length, offset, fname, size);
+    }
+    if (length < 0)
+        length = size - offset;
+    if ((MVMuint64)length > (size_t)-1 - MVM_platform_map_granularity()) {
+        char *waste[] = { fname, NULL };
+        uv_fs_close(NULL, &req, fd, NULL);
+        MVM_exception_throw_adhoc_free(tc, waste, "Cannot map %"PRId64" bytes of '%s' at once",
+            length, fname);
+    }
+
+    /* Mappings must start at a multiple of the granularity, so take in the
+     * bytes before the offset that are needed for that. */
+    slack      = (size_t)((MVMuint64)offset % MVM_platform_map_granularity());
+    map_offset = (MVMuint64)offset - slack;
+    if (length > 0 && (block = MVM_platform_map_file_at(fd, &handle, map_offset, slack + (size_t)length)) == NULL) {
+        char *waste[] = { fname, NULL };
+        uv_fs_close(NULL, &req, fd, NULL);
+        MVM_exception_throw_adhoc_free(tc, waste, "Could not map '%s' into memory", fname);
+    }
+    uv_fs_close(NULL, &req, fd, NULL);
+    MVM_free(fname);
+
+    result = (MVMMappedBuffer *)MVM_repr_alloc_init(tc, type);
+    result->body.data       = block ? (MVMuint8 *)block + slack : NULL;
+    result->body.length     = (MVMuint64)length;
+    result->body.block      = block;
+    result->body.handle     = handle;
+    result->body.block_size = block ? slack + (size_t)length : 0;
+    return (MVMObject *)result;
+}
+
+/* Makes a buffer that is a view of part of another one, without copying. */
+MVMObject * MVM_mapped_buffer_slice(MVMThreadContext *tc, MVMObject *buf, MVMint64 offset, MVMint64 length) {
+    MVMMappedBuffer *result;
+    MVMObject *owner;
+    MVMuint64 count;
+    MVM_mapped_buffer_ensure(tc, buf, "mmapslice");
+    count = check_range(tc, ((MVMMappedBuffer *)buf)->body.length, offset, length, "mmapslice");
+    MVMROOT(tc, buf, {
+        result = (MVMMappedBuffer *)MVM_repr_alloc_init(tc, STABLE(buf)->WHAT);
+    });
+    owner = ((MVMMappedBuffer *)buf)->body.owner;
+    MVM_ASSIGN_REF(tc, &(result->common.header), result->body.owner, owner ? owner : buf);
+    result->body.data   = count ? ((MVMMappedBuffer *)buf)->body.data + offset : NULL;
+    result->body.length = count;
+    return (MVMObject *)result;
+}
+
+/* Passes on a hint about how part of the buffer will be accessed, such as
+ * that it will be read sequentially or soon. */
+void MVM_mapped_buffer_advise(MVMThreadContext *tc, MVMObject *buf, MVMint64 offset, MVMint64 length,
+        MVMint64 advice) {
+    MVMMappedBufferBody *body;
+    MVMuint64 count;
+    MVM_mapped_buffer_ensure(tc, buf, "mmapadvise");
+    body  = &((MVMMappedBuffer *)buf)->body;
+    count = check_range(tc, body->length, offset, length, "mmapadvise");
+    if (advice < MVM_MAP_ADVISE_NORMAL || advice > MVM_MAP_ADVISE_DONTNEED)
+        MVM_exception_throw_adhoc(tc, "mmapadvise: unknown advice %"PRId64, advice);
+    if (count && !MVM_platform_advise_mapping(body->data + offset, (size_t)count, (int)advice))
+        MVM_exception_throw_adhoc(tc, "mmapadvise: failed to advise on mapping");
+}
+
+/* Finds the first occurrence of a sequence of bytes, given as a byte array
+ * or another mapped buffer, at or after start; returns -1 if there is
+ * none. */
+MVMint64 MVM_mapped_buffer_index(MVMThreadContext *tc, MVMObject *buf, MVMObject *needle, MVMint64 start) {
+    MVMMappedBufferBody *body;
+    const MVMuint8 *pattern;
+    const MVMuint8 *pos;
+    const MVMuint8 *last;
+    MVMuint64 pattern_length;
+    MVM_mapped_buffer_ensure(tc, buf, "mmapindex");
+    body = &((MVMMappedBuffer *)buf)->body;
+
+    if (IS_CONCRETE(needle) && REPR(needle)->ID == MVM_REPR_ID_MappedBuffer) {
+        pattern        = ((MVMMappedBuffer *)needle)->body.data;
+        pattern_length = ((MVMMappedBuffer *)needle)->body.length;
+    }
+    else if (IS_CONCRETE(needle) && REPR(needle)->ID == MVM_REPR_ID_VMArray
+            && (((MVMArrayREPRData *)STABLE(needle)->REPR_data)->slot_type == MVM_ARRAY_U8
+             || ((MVMArrayREPRData *)STABLE(needle)->REPR_data)->slot_type == MVM_ARRAY_I8)) {
+        pattern        = ((MVMArray *)needle)->body.slots.u8 + ((MVMArray *)needle)->body.start;
+        pattern_length = ((MVMArray *)needle)->body.elems;
+    }
+    else {
+        MVM_exception_throw_adhoc(tc, "mmapindex requires a byte array or MappedBuffer to search for");
+    }
+
+    if (start < 0)
+        start = 0;
+    if ((MVMuint64)start > body->length || pattern_length > body->length - start)
+        return -1;
+    if (pattern_length == 0)
+        return start;
+
+    /* Look for the first byte with memchr, then check the rest. */
+    pos  = body->data + start;
+    last = body->data + body->length - pattern_length;
+    while (pos <= last) {
+        pos = memchr(pos, pattern[0], last - pos + 1);
+        if (!pos)
+            break;
+        if (memcmp(pos + 1, pattern + 1, pattern_length - 1) == 0)
+            return pos - body->data;
+        pos++;
+    }
+    return -1;
+}
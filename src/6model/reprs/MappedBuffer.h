@@ -0,0 +1,33 @@
+/* Representation used for a read-only buffer of bytes that is a file, or
+ * part of one, mapped into memory. A slice of a buffer is a view onto the
+ * same mapping, which stays mapped until every view of it is gone. */
+struct MVMMappedBufferBody {
+    /* The bytes, and how many of them there are. */
+    MVMuint8  *data;
+    MVMuint64  length;
+
+    /* The mapping, which may start a little before the data since it has to
+     * start on a page boundary. NULL for a view, or an empty buffer. */
+    void      *block;
+    void      *handle;
+    size_t     block_size;
+
+    /* For a view, the buffer that owns the mapping. */
+    MVMObject *owner;
+};
+struct MVMMappedBuffer {
+    MVMObject common;
+    MVMMappedBufferBody body;
+};
+
+/* Function for REPR setup. */
+const MVMREPROps * MVMMappedBuffer_initialize(MVMThreadContext *tc);
+
+/* Operations on a MappedBuffer object. */
+void MVM_mapped_buffer_ensure(MVMThreadContext *tc, MVMObject *buf, const char *op);
+MVMObject * MVM_mapped_buffer_open(MVMThreadContext *tc, MVMObject *type, MVMString *filename,
+    MVMint64 offset, MVMint64 length);
+MVMObject * MVM_mapped_buffer_slice(MVMThreadContext *tc, MVMObject *buf, MVMint64 offset, MVMint64 length);
+void MVM_mapped_buffer_advise(MVMThreadContext *tc, MVMObject *buf, MVMint64 offset, MVMint64 length,
+    MVMint64 advice);
+MVMint64 MVM_mapped_buffer_index(MVMThreadContext *tc, MVMObject *buf, MVMObject *needle, MVMint64 start);
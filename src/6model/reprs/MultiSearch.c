@@ -0,0 +1,187 @@
+#include "moar.h"
+
+/* This representation's function pointer table. */
+static const MVMREPROps MultiSearch_this_repr;
+
+/* Creates a new type object of this representation, and associates it with
+ * the given HOW. */
+static MVMObject * type_object_for(MVMThreadContext *tc, MVMObject *HOW) {
+    MVMSTable *st  = MVM_gc_allocate_stable(tc, &MultiSearch_this_repr, HOW);
+
+    MVMROOT(tc, st, {
+        MVMObject *obj = MVM_gc_allocate_type_object(tc, st);
+        MVM_ASSIGN_REF(tc, &(st->header), st->WHAT, obj);
+        st->size = sizeof(MVMMultiSearch);
+    });
+
+    return st->WHAT;
+}
+
+/* Initializes a new instance. */
+static void initialize(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data) {
+    MVMMultiSearchBody *body = (MVMMultiSearchBody *)data;
+    body->last_needle = -1;
+}
+
+/* Copies the body of one object to another. */
+static void copy_to(MVMThreadContext *tc, MVMSTable *st, void *src, MVMObject *dest_root, void *dest) {
+    MVM_exception_throw_adhoc(tc, "Cannot copy object with representation MultiSearch");
+}
+
+/* Called by the VM in order to free memory associated with this object. */
+static void gc_free(MVMThreadContext *tc, MVMObject *obj) {
+    MVMMultiSearch *ms = (MVMMultiSearch *)obj;
+    MVM_string_multi_search_destroy(tc, ms->body.ms);
+}
+
+static const MVMStorageSpec storage_spec = {
+    MVM_STORAGE_SPEC_REFERENCE, /* inlineable */
+    0,                          /* bits */
+    0,                          /* align */
+    MVM_STORAGE_SPEC_BP_NONE,   /* boxed_primitive */
+    0,                          /* can_box */
+    0,                          /* is_unsigned */
+};
+
+/* Gets the storage specification for this representation. */
+static const MVMStorageSpec * get_storage_spec(MVMThreadContext *tc, MVMSTable *st) {
+    return &storage_spec;
+}
+
+/* Compose the representation. */
+static void compose(MVMThreadContext *tc, MVMSTable *st, MVMObject *info) {
+    /* Nothing to do for this REPR. */
+}
+
+/* Set the size of the STable. */
+static void deserialize_stable_size(MVMThreadContext *tc, MVMSTable *st, MVMSerializationReader *reader) {
+    st->size = sizeof(MVMMultiSearch);
+}
+
+/* Calculates the non-GC-managed memory we hold on to. */
+static MVMuint64 unmanaged_size(MVMThreadContext *tc, MVMSTable *st, void *data) {
+    MVMStringMultiSearch *ms = ((MVMMultiSearchBody *)data)->ms;
+    if (!ms)
+        return 0;
+    return sizeof(MVMStringMultiSearch)
+        + ms->num_nodes * sizeof(MVMStringMultiSearchNode)
+        + (ms->num_nodes - 1) * sizeof(MVMStringMultiSearchEdge)
+        + ms->num_needles * sizeof(MVMint32);
+}
+
+/* Initializes the representation. */
+const MVMREPROps * MVMMultiSearch_initialize(MVMThreadContext *tc) {
+    return &MultiSearch_this_repr;
+}
+
+static const MVMREPROps MultiSearch_this_repr = {
+    type_object_for,
+    MVM_gc_allocate_object,
+    initialize,
+    copy_to,
+    MVM_REPR_DEFAULT_ATTR_FUNCS,
+    MVM_REPR_DEFAULT_BOX_FUNCS,
+    MVM_REPR_DEFAULT_POS_FUNCS,
+    MVM_REPR_DEFAULT_ASS_FUNCS,
+    MVM_REPR_DEFAULT_ELEMS,
+    get_storage_spec,
+    NULL, /* change_type */
+    NULL, /* serialize */
+    NULL, /* deserialize */
+    NULL, /* serialize_repr_data */
+    NULL, /* deserialize_repr_data */
+    deserialize_stable_size,
+    NULL, /* gc_mark */
+    gc_free,
+    NULL, /* gc_cleanup */
+    NULL, /* gc_mark_repr_data */
+    NULL, /* gc_free_repr_data */
+    compose,
+    NULL, /* spesh */
+    "MultiSearch", /* name */
+    MVM_REPR_ID_MultiSearch,
+    unmanaged_size,
+    NULL, /* describe_refs */
+};
+
+/* Assert that the passed object really is a multi-search; throw if not. */
+void MVM_multi_search_ensure(MVMThreadContext *tc, MVMObject *ms, const char *op) {
+    if (MVM_UNLIKELY(REPR(ms)->ID != MVM_REPR_ID_MultiSearch || !IS_CONCRETE(ms)))
+        MVM_exception_throw_adhoc(tc,
+            "Operation '%s' can only work on an object with the MultiSearch representation",
+            op);
+}
+
+/* Obtains the matcher provided it's been configured, throwing if not. */
+static MVMStringMultiSearch * get_matcher(MVMThreadContext *tc, MVMMultiSearch *ms) {
+    MVMStringMultiSearch *matcher = ms->body.ms;
+    if (!matcher)
+        MVM_exception_throw_adhoc(tc, "MultiSearch not yet configured");
+    return matcher;
+}
+
+/* Compiles the list of needles to search for, replacing any earlier ones. */
+void MVM_multi_search_configure(MVMThreadContext *tc, MVMMultiSearch *ms, MVMObject *needles) {
+    MVMStringMultiSearch *matcher = MVM_string_multi_search_from_strings(tc, needles);
+    MVM_string_multi_search_destroy(tc, ms->body.ms);
+    ms->body.ms          = matcher;
+    ms->body.last_needle = -1;
+}
+
+/* Finds the leftmost occurrence of any of the needles at or after start,
+ * returning -1 if there is none. */
+MVMint64 MVM_multi_search_index(MVMThreadContext *tc, MVMMultiSearch *ms, MVMString *haystack, MVMint64 start) {
+    MVMStringMultiSearch *matcher = get_matcher(tc, ms);
+    MVMint32 needle;
+    MVMint64 index;
+    MVM_string_check_arg(tc, haystack, "msindex");
+    index = MVM_string_multi_search_index(tc, matcher, haystack, start, &needle);
+    ms->body.last_needle = needle;
+    return index;
+}
+
+/* Gets the index of the needle that the last search found, or -1 if it found
+ * nothing. */
+MVMint64 MVM_multi_search_last_needle(MVMThreadContext *tc, MVMMultiSearch *ms) {
+    get_matcher(tc, ms);
+    return ms->body.last_needle;
+}
+
+/* Splits the input on any of the needles, in a single pass over it. Like
+ * split, an occurrence at the very end gives a trailing empty string. */
+MVMObject * MVM_multi_search_split(MVMThreadContext *tc, MVMMultiSearch *ms, MVMString *input) {
+    MVMObject *result = NULL;
+    MVMHLLConfig *hll = MVM_hll_current(tc);
+    MVMint64 start, end;
+
+    get_matcher(tc, ms);
+    MVM_string_check_arg(tc, input, "mssplit");
+
+    MVMROOT3(tc, ms, input, result, {
+        result = MVM_repr_alloc_init(tc, hll->slurpy_array_type);
+        start = 0;
+        end = MVM_string_graphs_nocheck(tc, input);
+
+        while (start < end) {
+            MVMString *portion;
+            MVMint32 needle;
+            MVMint64 index = MVM_string_multi_search_index(tc, ms->body.ms, input, start, &needle);
+            MVMint64 length = (index == -1 ? end : index) - start;
+            portion = MVM_string_substring(tc, input, start, length);
+            MVMROOT(tc, portion, {
+                MVMObject *pobj = MVM_repr_alloc_init(tc, hll->str_box_type);
+                MVM_repr_set_str(tc, pobj, portion);
+                MVM_repr_push_o(tc, result, pobj);
+            });
+            start += length + (index == -1 ? 0 : ms->body.ms->needle_lengths[needle]);
+            /* Gather an empty string if a needle is found at the end. */
+            if (index != -1 && start == end) {
+                MVMObject *pobj = MVM_repr_alloc_init(tc, hll->str_box_type);
+                MVM_repr_set_str(tc, pobj, tc->instance->str_consts.empty);
+                MVM_repr_push_o(tc, result, pobj);
+            }
+        }
+    });
+
+    return result;
+}
@@ -0,0 +1,21 @@
+/* Representation used for a VM-provided set of needles that are searched for
+ * all at once. It holds the compiled matcher, along with the index of the
+ * needle that the last successful search found. */
+struct MVMMultiSearchBody {
+    MVMStringMultiSearch *ms;
+    MVMint64 last_needle;
+};
+struct MVMMultiSearch {
+    MVMObject common;
+    MVMMultiSearchBody body;
+};
+
+/* Function for REPR setup. */
+const MVMREPROps * MVMMultiSearch_initialize(MVMThreadContext *tc);
+
+/* Operations on a MultiSearch object. */
+void MVM_multi_search_ensure(MVMThreadContext *tc, MVMObject *ms, const char *op);
+void MVM_multi_search_configure(MVMThreadContext *tc, MVMMultiSearch *ms, MVMObject *needles);
+MVMint64 MVM_multi_search_index(MVMThreadContext *tc, MVMMultiSearch *ms, MVMString *haystack, MVMint64 start);
+MVMint64 MVM_multi_search_last_needle(MVMThreadContext *tc, MVMMultiSearch *ms);
+MVMObject * MVM_multi_search_split(MVMThreadContext *tc, MVMMultiSearch *ms, MVMString *input);
@@ -50,6 +50,8 @@ static void gc_free(MVMThreadContext *tc, MVMObject *obj) {
             MVM_fixed_size_free(tc, tc->instance->fsa, nfa->body.num_state_edges[i] * sizeof(MVMNFAStateInfo), nfa->body.states[i]);
     MVM_fixed_size_free(tc, tc->instance->fsa, nfa->body.num_states * sizeof(MVMNFAStateInfo *), nfa->body.states);
     MVM_fixed_size_free(tc, tc->instance->fsa, nfa->body.num_states * sizeof(MVMint64), nfa->body.num_state_edges);
+    if (nfa->body.dfa)
+        MVM_nfa_dfa_destroy(tc, nfa->body.dfa);
 }
 
 
@@ -313,6 +315,18 @@ static MVMuint64 unmanaged_size(MVMThreadContext *tc, MVMSTable *st, void *data)
     for (i = 0; i < body->num_states; i++)
         total += body->num_state_edges[i] * sizeof(MVMNFAStateInfo);
 
+    if (body->dfa) {
+        MVMuint32 j, k;
+        total += sizeof(MVMNFADFA);
+        for (j = 0; j < body->dfa->num_states; j++) {
+            MVMNFADFAState *ds = body->dfa->states[j];
+            total += sizeof(MVMNFADFAState) + ds->num_nfa_states * sizeof(MVMuint32);
+            for (k = 0; k <= MVM_NFA_DFA_TABLE_SIZE; k++)
+                if (ds->trans[k])
+                    total += sizeof(MVMNFADFATransition) + ds->trans[k]->num_events * sizeof(MVMint64);
+        }
+    }
+
     return total;
 }
 
@@ -481,6 +495,168 @@ static MVMint32 in_done(MVMuint32 *done, MVMuint32 numdone, MVMuint32 st) {
     return 0;
 }
 
+/* The fates found so far during a run of the NFA, along with the longest
+ * literal lengths seen for each fate. */
+typedef struct {
+    MVMint64 *fates;
+    MVMint64  fate_arr_len;
+    MVMint64  total_fates;
+    MVMint64  prev_fates;
+    MVMint64 *longlit;
+    MVMint64  usedlonglit;
+} NFAFates;
+
+/* Crossed a fate edge. Check if we already saw this fate, and if so remove
+ * the entry so we can re-add at the new token length. */
+static void cross_fate(MVMThreadContext *tc, NFAFates *f, MVMint64 arg) {
+    MVMint64 *fates = f->fates;
+    MVMint64 j;
+    MVMint64 found_fate = 0;
+    for (j = 0; j < f->total_fates; j++) {
+        if (found_fate)
+            fates[j - found_fate] = fates[j];
+        if ((fates[j] & 0xffffff) == arg) {
+            found_fate++;
+            if (j < f->prev_fates)
+                f->prev_fates--;
+        }
+    }
+    f->total_fates -= found_fate;
+    if (arg < f->usedlonglit)
+        arg -= f->longlit[arg] << 24;
+    if (MVM_UNLIKELY(++f->total_fates > f->fate_arr_len)) {
+        /* should never happen if nfa->fates is correct and dedup above works right */
+        fprintf(stderr, "oops adding %016llx to\n", (long long unsigned int)arg);
+        for (j = 0; j < f->total_fates - 1; j++) {
+            fprintf(stderr, "  %016llx\n", (long long unsigned int)fates[j]);
+        }
+        f->fate_arr_len   = f->total_fates + 10;
+        tc->nfa_fates     = (MVMint64 *)MVM_realloc(tc->nfa_fates,
+            sizeof(MVMint64) * f->fate_arr_len);
+        tc->nfa_fates_len = f->fate_arr_len;
+        fates = f->fates  = tc->nfa_fates;
+    }
+    /* a small insertion sort */
+    j = f->total_fates - 1;
+    while (--j >= f->prev_fates && fates[j] < arg) {
+        fates[j + 1] = fates[j];
+    }
+    fates[++j] = arg;
+}
+
+/* Passed through the final char of a literal that influences a fate. */
+MVM_STATIC_INLINE void note_longlit(NFAFates *f, MVMint64 fate, MVMint64 length) {
+    while (f->usedlonglit <= fate)
+        f->longlit[f->usedlonglit++] = 0;
+    f->longlit[fate] = length;
+}
+
+/* Hashes a list of NFA states, for quicker DFA state lookup. */
+static MVMuint32 hash_nfa_states(MVMuint32 *states, MVMint64 num_states) {
+    MVMuint32 hash = 2166136261u;
+    MVMint64 i;
+    for (i = 0; i < num_states; i++)
+        hash = (hash ^ states[i]) * 16777619u;
+    return hash;
+}
+
+/* Creates a DFA state for a list of NFA states. */
+static MVMNFADFAState * new_dfa_state(MVMuint32 *states, MVMint64 num_states, MVMuint32 hash) {
+    MVMNFADFAState *ds = MVM_calloc(1, sizeof(MVMNFADFAState));
+    ds->nfa_states = MVM_malloc(num_states * sizeof(MVMuint32));
+    memcpy(ds->nfa_states, states, num_states * sizeof(MVMuint32));
+    ds->num_nfa_states = (MVMuint32)num_states;
+    ds->hash = hash;
+    return ds;
+}
+
+/* Gets the DFA for an NFA, if it is hot enough to have one. */
+static MVMNFADFA * get_dfa(MVMThreadContext *tc, MVMNFABody *nfa) {
+    MVMNFADFA *dfa = nfa->dfa;
+    MVMuint32 start = 1;
+    if (dfa)
+        return dfa;
+    if (!tc->instance->nfa_dfa_enabled || tc->instance->nfa_debug_enabled)
+        return NULL;
+    if (++nfa->runs < MVM_NFA_DFA_THRESHOLD)
+        return NULL;
+
+    /* Hot enough; create it with the start state, which every run begins
+     * in, and try to install it. */
+    dfa = MVM_calloc(1, sizeof(MVMNFADFA));
+    dfa->states[0] = new_dfa_state(&start, 1, hash_nfa_states(&start, 1));
+    dfa->num_states = 1;
+    if (!MVM_trycas(&(nfa->dfa), NULL, dfa)) {
+        MVM_nfa_dfa_destroy(tc, dfa);
+        dfa = nfa->dfa;
+    }
+    return dfa;
+}
+
+/* Finds the DFA state for a list of NFA states, adding it if it's not there
+ * yet. Returns -1 if there's no such state and no room to add it. */
+static MVMint32 dfa_state_for(MVMThreadContext *tc, MVMNFADFA *dfa, MVMuint32 *states,
+        MVMint64 num_states) {
+    MVMuint32 hash = hash_nfa_states(states, num_states);
+    MVMuint32 num  = (MVMuint32)MVM_load(&(dfa->num_states));
+    MVMuint32 i;
+    for (i = 0; i < num; i++) {
+        MVMNFADFAState *ds = dfa->states[i];
+        if (ds->hash == hash && ds->num_nfa_states == num_states &&
+                memcmp(ds->nfa_states, states, num_states * sizeof(MVMuint32)) == 0)
+            return i;
+    }
+    if (num == MVM_NFA_DFA_MAX_STATES)
+        return -1;
+
+    /* Not found; take the lock and check again for any state another thread
+     * added meanwhile, then add it. */
+    uv_mutex_lock(&(tc->instance->mutex_nfa_dfa));
+    for (; i < dfa->num_states; i++) {
+        MVMNFADFAState *ds = dfa->states[i];
+        if (ds->hash == hash && ds->num_nfa_states == num_states &&
+                memcmp(ds->nfa_states, states, num_states * sizeof(MVMuint32)) == 0) {
+            uv_mutex_unlock(&(tc->instance->mutex_nfa_dfa));
+            return i;
+        }
+    }
+    if (i < MVM_NFA_DFA_MAX_STATES) {
+        dfa->states[i] = new_dfa_state(states, num_states, hash);
+        MVM_store(&(dfa->num_states), i + 1);
+    }
+    else {
+        i = -1;
+    }
+    uv_mutex_unlock(&(tc->instance->mutex_nfa_dfa));
+    return (MVMint32)i;
+}
+
+/* Installs a transition that was recorded while interpreting. */
+static void add_dfa_transition(MVMThreadContext *tc, MVMNFADFAState *ds, MVMint32 slot,
+        MVMint32 target, MVMint64 *events, MVMuint32 num_events) {
+    MVMNFADFATransition *t = MVM_malloc(sizeof(MVMNFADFATransition) +
+        (num_events ? num_events - 1 : 0) * sizeof(MVMint64));
+    t->target     = target;
+    t->num_events = num_events;
+    if (num_events)
+        memcpy(t->events, events, num_events * sizeof(MVMint64));
+    if (!MVM_trycas(&(ds->trans[slot]), NULL, t))
+        MVM_free(t);
+}
+
+/* Frees the memory associated with a DFA. */
+void MVM_nfa_dfa_destroy(MVMThreadContext *tc, MVMNFADFA *dfa) {
+    MVMuint32 i, j;
+    for (i = 0; i < dfa->num_states; i++) {
+        MVMNFADFAState *ds = dfa->states[i];
+        for (j = 0; j <= MVM_NFA_DFA_TABLE_SIZE; j++)
+            MVM_free(ds->trans[j]);
+        MVM_free(ds->nfa_states);
+        MVM_free(ds);
+    }
+    MVM_free(dfa);
+}
+
 static MVMint64 * nqp_nfa_run(MVMThreadContext *tc, MVMNFABody *nfa, MVMString *target, MVMint64 offset, MVMint64 *total_fates_out) {
     MVMint64  eos     = MVM_string_graphs(tc, target);
     MVMuint32 gen     = 1;
@@ -488,15 +664,23 @@ static MVMint64 * nqp_nfa_run(MVMThreadContext *tc, MVMNFABody *nfa, MVMString *
     MVMint64  numnext = 0;
     MVMint64  numdone = 0;
     MVMuint32 *done, *curst, *nextst;
-    MVMint64  *fates, *longlit;
-    MVMint64  i, fate_arr_len, num_states, total_fates, prev_fates, usedlonglit;
+    MVMint64  i, fate_arr_len, num_states;
     MVMint64  orig_offset = offset;
+    NFAFates  f;
     /* We used a cached grapheme iterator since we often request the same
      * grapheme multiple times, most common after that is requesting the next
      * grapheme. */
     MVMGraphemeIter_cached gic;
     int nfadeb = tc->instance->nfa_debug_enabled;
 
+    /* If the NFA is hot, we have a DFA to follow as far as we can, and the
+     * state we're currently in (or -1 if we're only interpreting). Events
+     * are recorded while interpreting a step we'll add to the DFA. */
+    MVMNFADFA *dfa = get_dfa(tc, nfa);
+    MVMint32   dfa_state = -1;
+    MVM_VECTOR_DECL(MVMint64, events);
+    MVM_VECTOR_INIT(events, 0);
+
     /* Obtain or (re)allocate "done states", "current states" and "next
      * states" arrays. */
     num_states = nfa->num_states;
@@ -517,8 +701,9 @@ static MVMint64 * nqp_nfa_run(MVMThreadContext *tc, MVMNFABody *nfa, MVMString *
         tc->nfa_fates     = (MVMint64 *)MVM_realloc(tc->nfa_fates, sizeof(MVMint64) * fate_arr_len);
         tc->nfa_fates_len = fate_arr_len;
     }
-    fates = tc->nfa_fates;
-    total_fates = 0;
+    f.fates        = tc->nfa_fates;
+    f.fate_arr_len = fate_arr_len;
+    f.total_fates  = 0;
     if (MVM_UNLIKELY(nfadeb)) fprintf(stderr,"======================================\nStarting with %d fates in %d states\n", (int)fate_arr_len, (int)num_states) ;
 
     /* longlit will be updated on a fate whenever NFA passes through final char of a literal. */
@@ -527,25 +712,74 @@ static MVMint64 * nqp_nfa_run(MVMThreadContext *tc, MVMNFABody *nfa, MVMString *
         tc->nfa_longlit = (MVMint64 *)MVM_realloc(tc->nfa_longlit, sizeof(MVMint64) * fate_arr_len);
         tc->nfa_longlit_len  = fate_arr_len;
     }
-    longlit = tc->nfa_longlit;
-    usedlonglit = 0;
+    f.longlit     = tc->nfa_longlit;
+    f.usedlonglit = 0;
 
     nextst[numnext++] = 1;
+    if (dfa)
+        dfa_state = 0;
     /* In NFA could be called with a string that has 0 graphemes in it. Guard
      * against this so we don't init for the empty string. */
     if (target->body.num_graphs) MVM_string_gi_cached_init(tc, &gic, target, 0);
 
     while (numnext && offset <= eos) {
-        /* Swap next and current */
-        MVMuint32 *temp = curst;
-        curst   = nextst;
-        nextst  = temp;
-        numcur  = numnext;
+        MVMint32 from_state = dfa_state;
+        MVMint32 slot       = -1;
+        MVMint32 record;
+
+        /* If we've a DFA, see if this grapheme has a jump table slot, and if
+         * we have a transition for it already just replay it. */
+        if (dfa) {
+            if (offset < eos) {
+                MVMGrapheme32 g = MVM_string_gi_cached_get_grapheme(tc, &gic, offset);
+                if (g >= 0 && g < MVM_NFA_DFA_TABLE_SIZE)
+                    slot = g;
+            }
+            else {
+                slot = MVM_NFA_DFA_EOS_SLOT;
+            }
+            if (dfa_state >= 0 && slot >= 0) {
+                MVMNFADFATransition *t = (MVMNFADFATransition *)MVM_load(
+                    &(dfa->states[dfa_state]->trans[slot]));
+                if (t) {
+                    MVMuint32 e;
+                    f.prev_fates = f.total_fates;
+                    for (e = 0; e < t->num_events; e++) {
+                        MVMint64 event = t->events[e];
+                        if (event >= 0)
+                            cross_fate(tc, &f, event);
+                        else
+                            note_longlit(&f, -1 - event, offset - orig_offset + 1);
+                    }
+                    dfa_state = t->target;
+                    numnext   = dfa_state >= 0 ? dfa->states[dfa_state]->num_nfa_states : 0;
+                    offset++;
+                    gen++;
+                    continue;
+                }
+            }
+        }
+
+        /* Make the next states the current ones; if we were following the
+         * DFA then they live in the DFA state. */
+        if (dfa_state >= 0) {
+            MVMNFADFAState *ds = dfa->states[dfa_state];
+            memcpy(curst, ds->nfa_states, ds->num_nfa_states * sizeof(MVMuint32));
+            numcur = ds->num_nfa_states;
+        }
+        else {
+            MVMuint32 *temp = curst;
+            curst   = nextst;
+            nextst  = temp;
+            numcur  = numnext;
+        }
         numnext = 0;
         numdone = 0;
+        record  = from_state >= 0 && slot >= 0;
+        MVM_VECTOR_CLEAR(events);
 
         /* Save how many fates we have before this position is considered. */
-        prev_fates = total_fates;
+        f.prev_fates = f.total_fates;
 
         if (MVM_UNLIKELY(nfadeb)) {
             if (offset < eos) {
@@ -583,43 +817,12 @@ static MVMint64 * nqp_nfa_run(MVMThreadContext *tc, MVMNFABody *nfa, MVMString *
                         act &= 0xff;
                     }
                     else if (act == MVM_NFA_EDGE_FATE) {
-                        /* Crossed a fate edge. Check if we already saw this fate, and
-                         * if so remove the entry so we can re-add at the new token length. */
                         MVMint64 arg = edge_info[i].arg.i;
-                        MVMint64 j;
-                        MVMint64 found_fate = 0;
                         if (MVM_UNLIKELY(nfadeb))
                             fprintf(stderr, "fate(%016llx) ", (long long unsigned int)arg);
-                        for (j = 0; j < total_fates; j++) {
-                            if (found_fate)
-                                fates[j - found_fate] = fates[j];
-                            if ((fates[j] & 0xffffff) == arg) {
-                                found_fate++;
-                                if (j < prev_fates)
-                                    prev_fates--;
-                            }
-                        }
-                        total_fates -= found_fate;
-                        if (arg < usedlonglit)
-                            arg -= longlit[arg] << 24;
-                        if (MVM_UNLIKELY(++total_fates > fate_arr_len)) {
-                            /* should never happen if nfa->fates is correct and dedup above works right */
-                            fprintf(stderr, "oops adding %016llx to\n", (long long unsigned int)arg);
-                            for (j = 0; j < total_fates - 1; j++) {
-                                fprintf(stderr, "  %016llx\n", (long long unsigned int)fates[j]);
-                            }
-                            fate_arr_len      = total_fates + 10;
-                            tc->nfa_fates     = (MVMint64 *)MVM_realloc(tc->nfa_fates,
-                                sizeof(MVMint64) * fate_arr_len);
-                            tc->nfa_fates_len = fate_arr_len;
-                            fates             = tc->nfa_fates;
-                        }
-                        /* a small insertion sort */
-                        j = total_fates - 1;
-                        while (--j >= prev_fates && fates[j] < arg) {
-                            fates[j + 1] = fates[j];
-                        }
-                        fates[++j] = arg;
+                        cross_fate(tc, &f, arg);
+                        if (record)
+                            MVM_VECTOR_PUSH(events, arg);
                         continue;
                     }
                     else if (act == MVM_NFA_EDGE_EPSILON && to <= num_states &&
@@ -643,9 +846,9 @@ static MVMint64 * nqp_nfa_run(MVMThreadContext *tc, MVMNFABody *nfa, MVMString *
                             if (MVM_string_gi_cached_get_grapheme(tc, &gic, offset) == arg) {
                                 MVMint64 fate = (edge_info[i].act >> 8) & 0xfffff;
                                 nextst[numnext++] = to;
-                                while (usedlonglit <= fate)
-                                    longlit[usedlonglit++] = 0;
-                                longlit[fate] = offset - orig_offset + 1;
+                                note_longlit(&f, fate, offset - orig_offset + 1);
+                                if (record)
+                                    MVM_VECTOR_PUSH(events, -1 - fate);
                                 if (MVM_UNLIKELY(nfadeb))
                                     fprintf(stderr, "%d->%d ", (int)i, (int)to);
                             }
@@ -699,9 +902,9 @@ static MVMint64 * nqp_nfa_run(MVMThreadContext *tc, MVMNFABody *nfa, MVMString *
                             if (ord == lc_arg || ord == uc_arg) {
                                 MVMint64 fate = (edge_info[i].act >> 8) & 0xfffff;
                                 nextst[numnext++] = to;
-                                while (usedlonglit <= fate)
-                                    longlit[usedlonglit++] = 0;
-                                longlit[fate] = offset - orig_offset + 1;
+                                note_longlit(&f, fate, offset - orig_offset + 1);
+                                if (record)
+                                    MVM_VECTOR_PUSH(events, -1 - fate);
                             }
                             continue;
                         }
@@ -844,9 +1047,9 @@ static MVMint64 * nqp_nfa_run(MVMThreadContext *tc, MVMNFABody *nfa, MVMString *
                                     else {
                                         const MVMint64 fate = (edge_info[found].act >> 8) & 0xfffff;
                                         nextst[numnext++] = to;
-                                        while (usedlonglit <= fate)
-                                            longlit[usedlonglit++] = 0;
-                                        longlit[fate] = offset - orig_offset + 1;
+                                        note_longlit(&f, fate, offset - orig_offset + 1);
+                                        if (record)
+                                            MVM_VECTOR_PUSH(events, -1 - fate);
                                         if (MVM_UNLIKELY(nfadeb))
                                             fprintf(stderr, "%d->%d ", (int)found, (int)to);
                                     }
@@ -862,21 +1065,32 @@ static MVMint64 * nqp_nfa_run(MVMThreadContext *tc, MVMNFABody *nfa, MVMString *
             if (MVM_UNLIKELY(nfadeb)) fprintf(stderr,"\n");
         }
 
+        /* If we have a DFA, find the state for where we ended up, and if we
+         * were in a DFA state before then remember how we got here. */
+        if (dfa) {
+            dfa_state = numnext ? dfa_state_for(tc, dfa, nextst, numnext) : -1;
+            if (record && (dfa_state >= 0 || !numnext))
+                add_dfa_transition(tc, dfa->states[from_state], slot, dfa_state,
+                    events, MVM_VECTOR_ELEMS(events));
+        }
+
         /* Move to next character and generation. */
         offset++;
         gen++;
     }
+    MVM_VECTOR_DESTROY(events);
+
     /* strip any literal lengths, leaving only fates */
-    if (usedlonglit || nfadeb) {
+    if (f.usedlonglit || nfadeb) {
         if (MVM_UNLIKELY(nfadeb)) fprintf(stderr,"Final\n");
-        for (i = 0; i < total_fates; i++) {
-            if (MVM_UNLIKELY(nfadeb)) fprintf(stderr, "  %08llx\n", (long long unsigned int)fates[i]);
-            fates[i] &= 0xffffff;
+        for (i = 0; i < f.total_fates; i++) {
+            if (MVM_UNLIKELY(nfadeb)) fprintf(stderr, "  %08llx\n", (long long unsigned int)f.fates[i]);
+            f.fates[i] &= 0xffffff;
         }
     }
 
-    *total_fates_out = total_fates;
-    return fates;
+    *total_fates_out = f.total_fates;
+    return f.fates;
 }
 
 /* Takes an NFA, a target string in and an offset. Runs the NFA and returns
@@ -47,12 +47,60 @@ struct MVMNFAStateInfo {
     } arg;
 };
 
+/* Once an NFA has been run MVM_NFA_DFA_THRESHOLD times, we start building a
+ * DFA for it lazily. Each DFA state stands for the exact list of NFA states
+ * that the interpreter would have at the start of a generation, and has a
+ * jump table indexed by grapheme (for graphemes below MVM_NFA_DFA_TABLE_SIZE)
+ * plus a slot for the end of the string. A filled slot holds the resulting
+ * DFA state along with the fate and longest literal events the interpreter
+ * produced, so running it again is just replaying them. Graphemes outside of
+ * the table, and any transition not yet seen, fall back to interpreting the
+ * NFA. The number of DFA states is bounded, so pathological NFAs just stay
+ * interpreted once the limit is reached. */
+#define MVM_NFA_DFA_THRESHOLD   50
+#define MVM_NFA_DFA_MAX_STATES  64
+#define MVM_NFA_DFA_TABLE_SIZE  128
+#define MVM_NFA_DFA_EOS_SLOT    MVM_NFA_DFA_TABLE_SIZE
+
+/* A transition between DFA states. Events are fate edges crossed (the fate
+ * itself, which is non-negative) and longest literal updates (encoded as
+ * -1 - fate), in the order the interpreter saw them. */
+struct MVMNFADFATransition {
+    /* The DFA state we end up in, or -1 if no NFA states remain. */
+    MVMint32 target;
+
+    /* Number of events to replay, and the events. */
+    MVMuint32 num_events;
+    MVMint64  events[1];
+};
+
+/* A DFA state. The transitions are filled in at most once each, and never
+ * changed after that, so they can be read without taking any locks. */
+struct MVMNFADFAState {
+    MVMuint32           *nfa_states;
+    MVMuint32            num_nfa_states;
+    MVMuint32            hash;
+    MVMNFADFATransition *trans[MVM_NFA_DFA_TABLE_SIZE + 1];
+};
+
+/* The DFA built for an NFA. States are only ever appended (under the
+ * instance's mutex_nfa_dfa), and state 0 is always the start state. */
+struct MVMNFADFA {
+    MVMNFADFAState *states[MVM_NFA_DFA_MAX_STATES];
+    AO_t            num_states;
+};
+
 /* Body of an NFA. */
 struct MVMNFABody {
     MVMObject        *fates;
     MVMint64          num_states;
     MVMint64         *num_state_edges;
     MVMNFAStateInfo **states;
+
+    /* Number of runs so far, until we decide to build a DFA, and the DFA
+     * itself once we have. */
+    MVMuint32         runs;
+    MVMNFADFA        *dfa;
 };
 
 struct MVMNFA {
@@ -68,3 +116,4 @@ MVMObject * MVM_nfa_from_statelist(MVMThreadContext *tc, MVMObject *states, MVMO
 MVMObject * MVM_nfa_run_proto(MVMThreadContext *tc, MVMObject *nfa, MVMString *target, MVMint64 offset);
 void MVM_nfa_run_alt(MVMThreadContext *tc, MVMObject *nfa, MVMString *target,
     MVMint64 offset, MVMObject *bstack, MVMObject *cstack, MVMObject *labels);
+void MVM_nfa_dfa_destroy(MVMThreadContext *tc, MVMNFADFA *dfa);
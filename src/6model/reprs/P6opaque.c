@@ -1438,6 +1438,29 @@ static MVMString * spesh_attr_name(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSp
         return MVM_spesh_get_string(tc, g, o);
     }
 }
+
+/* Picks the op to read or write a flattened native int attribute directly,
+ * based on its size. As with P6int's get_int, reads sign-extend. Sizes below
+ * 8 bits are left to the REPR. */
+static MVMint32 p6int_get_op(const MVMStorageSpec *ss) {
+    switch (ss->bits) {
+        case 64: return MVM_OP_sp_p6oget_i;
+        case 32: return MVM_OP_sp_p6oget_i32;
+        case 16: return MVM_OP_sp_p6oget_i16;
+        case 8:  return MVM_OP_sp_p6oget_i8;
+        default: return -1;
+    }
+}
+static MVMint32 p6int_bind_op(const MVMStorageSpec *ss) {
+    switch (ss->bits) {
+        case 64: return MVM_OP_sp_p6obind_i;
+        case 32: return MVM_OP_sp_p6obind_i32;
+        case 16: return MVM_OP_sp_p6obind_i16;
+        case 8:  return MVM_OP_sp_p6obind_i8;
+        default: return -1;
+    }
+}
+
 static void spesh(MVMThreadContext *tc, MVMSTable *st, MVMSpeshGraph *g, MVMSpeshBB *bb, MVMSpeshIns *ins) {
     MVMP6opaqueREPRData * repr_data = (MVMP6opaqueREPRData *)st->REPR_data;
     MVMuint16             opcode    = ins->info->opcode;
@@ -1529,15 +1552,11 @@ static void spesh(MVMThreadContext *tc, MVMSTable *st, MVMSpeshGraph *g, MVMSpes
                 MVMSTable      *flat_st = repr_data->flattened_stables[slot];
                 const MVMStorageSpec *flat_ss = flat_st->REPR->get_storage_spec(tc, flat_st);
                 add_slot_name_comment(tc, g, ins, name, ch_facts, st);
-                if (flat_st->REPR->ID == MVM_REPR_ID_P6int &&
-                        (flat_ss->bits == 64 || flat_ss->bits == 32)) {
+                if (flat_st->REPR->ID == MVM_REPR_ID_P6int && p6int_get_op(flat_ss) >= 0) {
                     if (opcode == MVM_OP_getattrs_i)
                         MVM_spesh_usages_delete_by_reg(tc, g, ins->operands[3], ins);
                     MVM_spesh_usages_delete_by_reg(tc, g, ins->operands[2], ins);
-                    ins->info = MVM_op_get_op(
-                            flat_ss->bits == 64 ? MVM_OP_sp_p6oget_i
-                                                : MVM_OP_sp_p6oget_i32
-                            );
+                    ins->info = MVM_op_get_op(p6int_get_op(flat_ss));
                     ins->operands[2].lit_i16 = repr_data->attribute_offsets[slot];
                 }
             }
@@ -1555,12 +1574,15 @@ static void spesh(MVMThreadContext *tc, MVMSTable *st, MVMSpeshGraph *g, MVMSpes
             if (slot >= 0 && repr_data->flattened_stables[slot]) {
                 MVMSTable      *flat_st = repr_data->flattened_stables[slot];
                 const MVMStorageSpec *flat_ss = flat_st->REPR->get_storage_spec(tc, flat_st);
-                if (flat_st->REPR->ID == MVM_REPR_ID_P6num && flat_ss->bits == 64) {
+                if (flat_st->REPR->ID == MVM_REPR_ID_P6num &&
+                        (flat_ss->bits == 64 || flat_ss->bits == 32)) {
                     add_slot_name_comment(tc, g, ins, name, ch_facts, st);
                     if (opcode == MVM_OP_getattrs_n)
                         MVM_spesh_usages_delete_by_reg(tc, g, ins->operands[3], ins);
                     MVM_spesh_usages_delete_by_reg(tc, g, ins->operands[2], ins);
-                    ins->info = MVM_op_get_op(MVM_OP_sp_p6oget_n);
+                    ins->info = MVM_op_get_op(flat_ss->bits == 64
+                        ? MVM_OP_sp_p6oget_n
+                        : MVM_OP_sp_p6oget_n32);
                     ins->operands[2].lit_i16 = repr_data->attribute_offsets[slot];
                 }
             }
@@ -1627,16 +1649,12 @@ static void spesh(MVMThreadContext *tc, MVMSTable *st, MVMSpeshGraph *g, MVMSpes
             if (slot >= 0 && repr_data->flattened_stables[slot]) {
                 MVMSTable      *flat_st = repr_data->flattened_stables[slot];
                 const MVMStorageSpec *flat_ss = flat_st->REPR->get_storage_spec(tc, flat_st);
-                if (flat_st->REPR->ID == MVM_REPR_ID_P6int &&
-                        (flat_ss->bits == 64 || flat_ss->bits == 32)) {
+                if (flat_st->REPR->ID == MVM_REPR_ID_P6int && p6int_bind_op(flat_ss) >= 0) {
                     add_slot_name_comment(tc, g, ins, name, ch_facts, st);
                     if (opcode == MVM_OP_bindattrs_i)
                         MVM_spesh_usages_delete_by_reg(tc, g, ins->operands[2], ins);
                     MVM_spesh_usages_delete_by_reg(tc, g, ins->operands[1], ins);
-                    ins->info = MVM_op_get_op(
-                            flat_ss->bits == 64 ? MVM_OP_sp_p6obind_i
-                                                : MVM_OP_sp_p6obind_i32
-                            );
+                    ins->info = MVM_op_get_op(p6int_bind_op(flat_ss));
                     ins->operands[1].lit_i16 = repr_data->attribute_offsets[slot];
                     ins->operands[2] = ins->operands[3];
                 }
@@ -1655,12 +1673,15 @@ static void spesh(MVMThreadContext *tc, MVMSTable *st, MVMSpeshGraph *g, MVMSpes
             if (slot >= 0 && repr_data->flattened_stables[slot]) {
                 MVMSTable      *flat_st = repr_data->flattened_stables[slot];
                 const MVMStorageSpec *flat_ss = flat_st->REPR->get_storage_spec(tc, flat_st);
-                if (flat_st->REPR->ID == MVM_REPR_ID_P6num && flat_ss->bits == 64) {
+                if (flat_st->REPR->ID == MVM_REPR_ID_P6num &&
+                        (flat_ss->bits == 64 || flat_ss->bits == 32)) {
                     add_slot_name_comment(tc, g, ins, name, ch_facts, st);
                     if (opcode == MVM_OP_bindattrs_n)
                         MVM_spesh_usages_delete_by_reg(tc, g, ins->operands[2], ins);
                     MVM_spesh_usages_delete_by_reg(tc, g, ins->operands[1], ins);
-                    ins->info = MVM_op_get_op(MVM_OP_sp_p6obind_n);
+                    ins->info = MVM_op_get_op(flat_ss->bits == 64
+                        ? MVM_OP_sp_p6obind_n
+                        : MVM_OP_sp_p6obind_n32);
                     ins->operands[1].lit_i16 = repr_data->attribute_offsets[slot];
                     ins->operands[2] = ins->operands[3];
                 }
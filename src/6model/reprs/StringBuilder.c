@@ -0,0 +1,324 @@
+#include "moar.h"
+
+/* The number of graphemes we allocate room for on the first append. */
+#define MVM_STRING_BUILDER_INITIAL_GRAPHS 16
+
+/* This representation's function pointer table. */
+static const MVMREPROps StringBuilder_this_repr;
+
+/* Creates a new type object of this representation, and associates it with
+ * the given HOW. */
+static MVMObject * type_object_for(MVMThreadContext *tc, MVMObject *HOW) {
+    MVMSTable *st  = MVM_gc_allocate_stable(tc, &StringBuilder_this_repr, HOW);
+
+    MVMROOT(tc, st, {
+        MVMObject *obj = MVM_gc_allocate_type_object(tc, st);
+        MVM_ASSIGN_REF(tc, &(st->header), st->WHAT, obj);
+        st->size = sizeof(MVMStringBuilder);
+    });
+
+    return st->WHAT;
+}
+
+/* Copies the body of one object to another. */
+static void copy_to(MVMThreadContext *tc, MVMSTable *st, void *src, MVMObject *dest_root, void *dest) {
+    MVMStringBuilderBody *src_body  = (MVMStringBuilderBody *)src;
+    MVMStringBuilderBody *dest_body = (MVMStringBuilderBody *)dest;
+    size_t elem_size = src_body->wide ? sizeof(MVMGrapheme32) : sizeof(MVMGrapheme8);
+    *dest_body = *src_body;
+    if (src_body->alloc_graphs) {
+        dest_body->buffer.any = MVM_malloc(src_body->alloc_graphs * elem_size);
+        memcpy(dest_body->buffer.any, src_body->buffer.any,
+            src_body->num_graphs * elem_size);
+    }
+}
+
+/* Called by the VM in order to free memory associated with this object. */
+static void gc_free(MVMThreadContext *tc, MVMObject *obj) {
+    MVMStringBuilder *sb = (MVMStringBuilder *)obj;
+    MVM_free(sb->body.buffer.any);
+}
+
+static const MVMStorageSpec storage_spec = {
+    MVM_STORAGE_SPEC_REFERENCE, /* inlineable */
+    0,                          /* bits */
+    0,                          /* align */
+    MVM_STORAGE_SPEC_BP_NONE,   /* boxed_primitive */
+    0,                          /* can_box */
+    0,                          /* is_unsigned */
+};
+
+/* Gets the storage specification for this representation. */
+static const MVMStorageSpec * get_storage_spec(MVMThreadContext *tc, MVMSTable *st) {
+    return &storage_spec;
+}
+
+/* Compose the representation. */
+static void compose(MVMThreadContext *tc, MVMSTable *st, MVMObject *info) {
+    /* Nothing to do for this REPR. */
+}
+
+/* Set the size of the STable. */
+static void deserialize_stable_size(MVMThreadContext *tc, MVMSTable *st, MVMSerializationReader *reader) {
+    st->size = sizeof(MVMStringBuilder);
+}
+
+/* Calculates the non-GC-managed memory we hold on to. */
+static MVMuint64 unmanaged_size(MVMThreadContext *tc, MVMSTable *st, void *data) {
+    MVMStringBuilderBody *body = (MVMStringBuilderBody *)data;
+    return (MVMuint64)body->alloc_graphs
+        * (body->wide ? sizeof(MVMGrapheme32) : sizeof(MVMGrapheme8));
+}
+
+/* Initializes the representation. */
+const MVMREPROps * MVMStringBuilder_initialize(MVMThreadContext *tc) {
+    return &StringBuilder_this_repr;
+}
+
+static const MVMREPROps StringBuilder_this_repr = {
+    type_object_for,
+    MVM_gc_allocate_object,
+    NULL, /* initialize */
+    copy_to,
+    MVM_REPR_DEFAULT_ATTR_FUNCS,
+    MVM_REPR_DEFAULT_BOX_FUNCS,
+    MVM_REPR_DEFAULT_POS_FUNCS,
+    MVM_REPR_DEFAULT_ASS_FUNCS,
+    MVM_REPR_DEFAULT_ELEMS,
+    get_storage_spec,
+    NULL, /* change_type */
+    NULL, /* serialize */
+    NULL, /* deserialize */
+    NULL, /* serialize_repr_data */
+    NULL, /* deserialize_repr_data */
+    deserialize_stable_size,
+    NULL, /* gc_mark */
+    gc_free,
+    NULL, /* gc_cleanup */
+    NULL, /* gc_mark_repr_data */
+    NULL, /* gc_free_repr_data */
+    compose,
+    NULL, /* spesh */
+    "StringBuilder", /* name */
+    MVM_REPR_ID_StringBuilder,
+    unmanaged_size,
+    NULL, /* describe_refs */
+};
+
+/* Assert that the passed object really is a string builder; throw if not. */
+void MVM_string_builder_ensure(MVMThreadContext *tc, MVMObject *sb, const char *op) {
+    if (MVM_UNLIKELY(REPR(sb)->ID != MVM_REPR_ID_StringBuilder || !IS_CONCRETE(sb)))
+        MVM_exception_throw_adhoc(tc,
+            "Operation '%s' can only work on an object with the StringBuilder representation",
+            op);
+}
+
+/* Makes sure there is room for another `extra` graphemes, growing the buffer
+ * geometrically so that a long run of appends is amortized linear. */
+static void ensure_space(MVMThreadContext *tc, MVMStringBuilderBody *body, MVMuint64 extra) {
+    MVMuint64 needed = (MVMuint64)body->num_graphs + extra;
+    if (needed > body->alloc_graphs) {
+        MVMuint64 new_alloc = body->alloc_graphs
+            ? body->alloc_graphs
+            : MVM_STRING_BUILDER_INITIAL_GRAPHS;
+        if (needed > 0xFFFFFFFFLL)
+            MVM_exception_throw_adhoc(tc,
+                "Can't append to string builder, required number of graphemes %"PRIu64" > max allowed of %lld",
+                needed, 0xFFFFFFFFLL);
+        while (new_alloc < needed)
+            new_alloc *= 2;
+        if (new_alloc > 0xFFFFFFFFLL)
+            new_alloc = 0xFFFFFFFFLL;
+        body->buffer.any = MVM_realloc(body->buffer.any,
+            new_alloc * (body->wide ? sizeof(MVMGrapheme32) : sizeof(MVMGrapheme8)));
+        body->alloc_graphs = (MVMuint32)new_alloc;
+    }
+}
+
+/* Switches the buffer from 8-bit to 32-bit graphemes. */
+static void widen(MVMThreadContext *tc, MVMStringBuilderBody *body) {
+    MVMGrapheme8  *old_buf = body->buffer.blob_8;
+    MVMGrapheme32 *new_buf = MVM_malloc(
+        (body->alloc_graphs ? body->alloc_graphs : 1) * sizeof(MVMGrapheme32));
+    MVMuint32 i;
+    MVM_VECTORIZE_LOOP
+    for (i = 0; i < body->num_graphs; i++)
+        new_buf[i] = old_buf[i];
+    MVM_free(old_buf);
+    body->buffer.blob_32 = new_buf;
+    body->wide           = 1;
+}
+
+/* Notes whether the grapheme about to be appended could combine with the one
+ * currently at the end of the buffer. */
+static void check_boundary(MVMThreadContext *tc, MVMStringBuilderBody *body, MVMGrapheme32 first) {
+    if (body->num_graphs && !body->needs_renormalize) {
+        MVMGrapheme32 last = body->wide
+            ? body->buffer.blob_32[body->num_graphs - 1]
+            : body->buffer.blob_8[body->num_graphs - 1];
+        if (MVM_nfg_is_concat_stable_graphemes(tc, last, first) != 1)
+            body->needs_renormalize = 1;
+    }
+}
+
+/* Appends a single grapheme. */
+static void append_grapheme(MVMThreadContext *tc, MVMStringBuilderBody *body, MVMGrapheme32 g) {
+    check_boundary(tc, body, g);
+    ensure_space(tc, body, 1);
+    if (!body->wide && !(-128 <= g && g <= 127))
+        widen(tc, body);
+    if (body->wide)
+        body->buffer.blob_32[body->num_graphs++] = g;
+    else
+        body->buffer.blob_8[body->num_graphs++] = g;
+}
+
+/* Appends all graphemes of a string, a strand at a time. */
+void MVM_string_builder_append_str(MVMThreadContext *tc, MVMStringBuilder *sb, MVMString *s) {
+    MVMStringBuilderBody *body = &(sb->body);
+    MVMStringIndex remaining;
+    MVMGraphemeIter gi;
+    MVM_string_check_arg(tc, s, "string builder append");
+    remaining = MVM_string_graphs_nocheck(tc, s);
+    if (!remaining)
+        return;
+    check_boundary(tc, body, MVM_string_get_grapheme_at_nocheck(tc, s, 0));
+    ensure_space(tc, body, remaining);
+
+    MVM_string_gi_init(tc, &gi, s);
+    while (1) {
+        MVMStringIndex strand_len = MVM_string_gi_graphs_left_in_strand(tc, &gi);
+        MVMStringIndex to_copy    = remaining < strand_len ? remaining : strand_len;
+        MVMStringIndex i;
+        switch (MVM_string_gi_blob_type(tc, &gi)) {
+            case MVM_STRING_GRAPHEME_8:
+            case MVM_STRING_GRAPHEME_ASCII: {
+                MVMGrapheme8 *src = MVM_string_gi_active_blob_8_pos(tc, &gi);
+                if (body->wide) {
+                    MVMGrapheme32 *dest = body->buffer.blob_32 + body->num_graphs;
+                    MVM_VECTORIZE_LOOP
+                    for (i = 0; i < to_copy; i++)
+                        dest[i] = src[i];
+                }
+                else {
+                    memcpy(body->buffer.blob_8 + body->num_graphs, src,
+                        to_copy * sizeof(MVMGrapheme8));
+                }
+                break;
+            }
+            case MVM_STRING_GRAPHEME_16: {
+                MVMGrapheme16 *src = MVM_string_gi_active_blob_16_pos(tc, &gi);
+                if (!body->wide && MVM_string_buf16_can_fit_into_8bit(src, to_copy)) {
+                    MVMGrapheme8 *dest = body->buffer.blob_8 + body->num_graphs;
+                    MVM_VECTORIZE_LOOP
+                    for (i = 0; i < to_copy; i++)
+                        dest[i] = src[i];
+                }
+                else {
+                    MVMGrapheme32 *dest;
+                    if (!body->wide)
+                        widen(tc, body);
+                    dest = body->buffer.blob_32 + body->num_graphs;
+                    MVM_VECTORIZE_LOOP
+                    for (i = 0; i < to_copy; i++)
+                        dest[i] = src[i];
+                }
+                break;
+            }
+            case MVM_STRING_GRAPHEME_32: {
+                MVMGrapheme32 *src = MVM_string_gi_active_blob_32_pos(tc, &gi);
+                if (!body->wide && MVM_string_buf32_can_fit_into_8bit(src, to_copy)) {
+                    MVMGrapheme8 *dest = body->buffer.blob_8 + body->num_graphs;
+                    MVM_VECTORIZE_LOOP
+                    for (i = 0; i < to_copy; i++)
+                        dest[i] = src[i];
+                }
+                else {
+                    if (!body->wide)
+                        widen(tc, body);
+                    memcpy(body->buffer.blob_32 + body->num_graphs, src,
+                        to_copy * sizeof(MVMGrapheme32));
+                }
+                break;
+            }
+            default:
+                MVM_exception_throw_adhoc(tc,
+                    "Internal error, string corruption in string builder append");
+        }
+        body->num_graphs += to_copy;
+        remaining        -= to_copy;
+        if (!remaining)
+            break;
+        MVM_string_gi_next_strand_rep(tc, &gi);
+    }
+}
+
+/* Appends the string form of an integer. */
+void MVM_string_builder_append_int(MVMThreadContext *tc, MVMStringBuilder *sb, MVMint64 i) {
+    MVMString *s;
+    MVMROOT(tc, sb, {
+        s = MVM_coerce_i_s(tc, i);
+    });
+    MVM_string_builder_append_str(tc, sb, s);
+}
+
+/* Appends the string form of a number. */
+void MVM_string_builder_append_num(MVMThreadContext *tc, MVMStringBuilder *sb, MVMnum64 n) {
+    MVMString *s;
+    MVMROOT(tc, sb, {
+        s = MVM_coerce_n_s(tc, n);
+    });
+    MVM_string_builder_append_str(tc, sb, s);
+}
+
+/* Appends a codepoint. Those that may decompose go through chr so they are
+ * normalized the same way. */
+void MVM_string_builder_append_codepoint(MVMThreadContext *tc, MVMStringBuilder *sb, MVMint64 cp) {
+    if (cp < 0)
+        MVM_exception_throw_adhoc(tc, "chr codepoint cannot be negative");
+    if (cp < MVM_NORMALIZE_FIRST_SIG_NFC) {
+        append_grapheme(tc, &(sb->body), (MVMGrapheme32)cp);
+    }
+    else {
+        MVMString *s;
+        MVMROOT(tc, sb, {
+            s = MVM_string_chr(tc, cp);
+        });
+        MVM_string_builder_append_str(tc, sb, s);
+    }
+}
+
+/* Returns the number of graphemes appended so far (before any
+ * renormalization that finishing may do). */
+MVMint64 MVM_string_builder_elems(MVMThreadContext *tc, MVMStringBuilder *sb) {
+    return sb->body.num_graphs;
+}
+
+/* Hands the buffer over to a new string and leaves the builder empty. */
+MVMString * MVM_string_builder_finish(MVMThreadContext *tc, MVMStringBuilder *sb) {
+    MVMStringBuilderBody *body = &(sb->body);
+    MVMString *result;
+    void      *buffer      = body->buffer.any;
+    MVMuint32  num_graphs  = body->num_graphs;
+    MVMuint32  alloc       = body->alloc_graphs;
+    MVMuint8   wide        = body->wide;
+    MVMuint8   renormalize = body->needs_renormalize;
+
+    if (!num_graphs)
+        return tc->instance->str_consts.empty;
+
+    /* Detach the buffer before allocating, so we needn't root the builder. */
+    memset(body, 0, sizeof(MVMStringBuilderBody));
+
+    /* Give back any large amount of slack. */
+    if (alloc - num_graphs > MVM_STRING_BUILDER_INITIAL_GRAPHS)
+        buffer = MVM_realloc(buffer,
+            num_graphs * (wide ? sizeof(MVMGrapheme32) : sizeof(MVMGrapheme8)));
+
+    result = (MVMString *)MVM_repr_alloc_init(tc, tc->instance->VMString);
+    result->body.storage.any  = buffer;
+    result->body.storage_type = wide ? MVM_STRING_GRAPHEME_32 : MVM_STRING_GRAPHEME_8;
+    result->body.num_graphs   = num_graphs;
+
+    return renormalize ? MVM_string_renormalize(tc, result) : result;
+}
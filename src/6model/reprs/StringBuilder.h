@@ -0,0 +1,39 @@
+/* Representation used for a VM-provided mutable string builder. Graphemes
+ * are appended to a buffer that grows geometrically; it starts out 8 bits
+ * wide and is widened to 32 bits the first time something that doesn't fit
+ * is appended. Finishing hands the buffer over to a new MVMString without
+ * copying it, and leaves the builder empty. */
+struct MVMStringBuilderBody {
+    union {
+        MVMGrapheme32 *blob_32;
+        MVMGrapheme8  *blob_8;
+        void          *any;
+    } buffer;
+
+    /* Graphemes appended so far, and how many the buffer has room for. */
+    MVMuint32 num_graphs;
+    MVMuint32 alloc_graphs;
+
+    /* Non-zero once the buffer holds 32-bit graphemes. */
+    MVMuint8 wide;
+
+    /* Set when an append may have formed a grapheme across the boundary with
+     * what was already there, so the result must be renormalized to NFG. */
+    MVMuint8 needs_renormalize;
+};
+struct MVMStringBuilder {
+    MVMObject common;
+    MVMStringBuilderBody body;
+};
+
+/* Function for REPR setup. */
+const MVMREPROps * MVMStringBuilder_initialize(MVMThreadContext *tc);
+
+/* Operations on a StringBuilder object. */
+void MVM_string_builder_ensure(MVMThreadContext *tc, MVMObject *sb, const char *op);
+void MVM_string_builder_append_str(MVMThreadContext *tc, MVMStringBuilder *sb, MVMString *s);
+void MVM_string_builder_append_int(MVMThreadContext *tc, MVMStringBuilder *sb, MVMint64 i);
+void MVM_string_builder_append_num(MVMThreadContext *tc, MVMStringBuilder *sb, MVMnum64 n);
+void MVM_string_builder_append_codepoint(MVMThreadContext *tc, MVMStringBuilder *sb, MVMint64 cp);
+MVMint64 MVM_string_builder_elems(MVMThreadContext *tc, MVMStringBuilder *sb);
+MVMString * MVM_string_builder_finish(MVMThreadContext *tc, MVMStringBuilder *sb);
@@ -1469,3 +1469,288 @@ static const MVMREPROps VMArray_this_repr = {
     unmanaged_size,
     describe_refs,
 };
+
+/* Bulk operations on native integer and num arrays. These work directly on
+ * the slots rather than an element at a time through at_pos/bind_pos, and the
+ * loops are kept simple enough that the compiler can vectorize them. */
+static MVMArrayREPRData * get_native_repr_data(MVMThreadContext *tc, MVMObject *arr,
+        MVMint32 want_num, const char *op) {
+    MVMArrayREPRData *repr_data;
+    if (REPR(arr)->ID != MVM_REPR_ID_VMArray || !IS_CONCRETE(arr))
+        MVM_exception_throw_adhoc(tc, "%s requires a concrete native array, got %s (%s)",
+            op, REPR(arr)->name, MVM_6model_get_debug_name(tc, arr));
+    repr_data = (MVMArrayREPRData *)STABLE(arr)->REPR_data;
+    switch (repr_data->slot_type) {
+        case MVM_ARRAY_I64: case MVM_ARRAY_I32: case MVM_ARRAY_I16: case MVM_ARRAY_I8:
+        case MVM_ARRAY_U64: case MVM_ARRAY_U32: case MVM_ARRAY_U16: case MVM_ARRAY_U8:
+            if (!want_num)
+                return repr_data;
+            break;
+        case MVM_ARRAY_N64: case MVM_ARRAY_N32:
+            if (want_num)
+                return repr_data;
+            break;
+    }
+    MVM_exception_throw_adhoc(tc, "%s requires a native %s array", op,
+        want_num ? "num" : "int");
+}
+
+#define FILL_SLOTS(type, member, v) do { \
+    type *slots = body->slots.member + body->start + start; \
+    type  fill  = (type)(v); \
+    MVMint64 k; \
+    MVM_VECTORIZE_LOOP \
+    for (k = 0; k < count; k++) \
+        slots[k] = fill; \
+} while (0)
+
+/* Sets count elements from start onwards to the given value, growing the
+ * array if needed. */
+void MVM_VMArray_fill_i(MVMThreadContext *tc, MVMObject *arr, MVMint64 value, MVMint64 start, MVMint64 count) {
+    MVMArrayREPRData *repr_data = get_native_repr_data(tc, arr, 0, "fillpos_i");
+    MVMArrayBody     *body      = &((MVMArray *)arr)->body;
+    if (start < 0 || count < 0)
+        MVM_exception_throw_adhoc(tc, "fillpos_i: Index out of bounds");
+    if (count == 0)
+        return;
+    enter_single_user(tc, body);
+    if (start + count > body->elems)
+        set_size_internal(tc, body, start + count, repr_data);
+    switch (repr_data->slot_type) {
+        case MVM_ARRAY_I64: FILL_SLOTS(MVMint64,  i64, value); break;
+        case MVM_ARRAY_I32: FILL_SLOTS(MVMint32,  i32, value); break;
+        case MVM_ARRAY_I16: FILL_SLOTS(MVMint16,  i16, value); break;
+        case MVM_ARRAY_U64: FILL_SLOTS(MVMuint64, u64, value); break;
+        case MVM_ARRAY_U32: FILL_SLOTS(MVMuint32, u32, value); break;
+        case MVM_ARRAY_U16: FILL_SLOTS(MVMuint16, u16, value); break;
+        case MVM_ARRAY_I8:
+        case MVM_ARRAY_U8:
+            memset(body->slots.u8 + body->start + start, (MVMuint8)value, count);
+            break;
+    }
+    exit_single_user(tc, body);
+}
+void MVM_VMArray_fill_n(MVMThreadContext *tc, MVMObject *arr, MVMnum64 value, MVMint64 start, MVMint64 count) {
+    MVMArrayREPRData *repr_data = get_native_repr_data(tc, arr, 1, "fillpos_n");
+    MVMArrayBody     *body      = &((MVMArray *)arr)->body;
+    if (start < 0 || count < 0)
+        MVM_exception_throw_adhoc(tc, "fillpos_n: Index out of bounds");
+    if (count == 0)
+        return;
+    enter_single_user(tc, body);
+    if (start + count > body->elems)
+        set_size_internal(tc, body, start + count, repr_data);
+    if (repr_data->slot_type == MVM_ARRAY_N64)
+        FILL_SLOTS(MVMnum64, n64, value);
+    else
+        FILL_SLOTS(MVMnum32, n32, value);
+    exit_single_user(tc, body);
+}
+
+#define REDUCE_SLOTS(type, member, acc_type, result) do { \
+    type *slots = body->slots.member + body->start; \
+    MVMint64 k; \
+    if (kind == MVM_ARRAY_REDUCE_SUM) { \
+        acc_type sum = 0; \
+        MVM_VECTORIZE_LOOP \
+        for (k = 0; k < n; k++) \
+            sum += slots[k]; \
+        result = sum; \
+    } \
+    else if (kind == MVM_ARRAY_REDUCE_MIN) { \
+        type min = slots[0]; \
+        MVM_VECTORIZE_LOOP \
+        for (k = 1; k < n; k++) \
+            min = slots[k] < min ? slots[k] : min; \
+        result = min; \
+    } \
+    else { \
+        type max = slots[0]; \
+        MVM_VECTORIZE_LOOP \
+        for (k = 1; k < n; k++) \
+            max = slots[k] > max ? slots[k] : max; \
+        result = max; \
+    } \
+} while (0)
+
+static void check_reduce(MVMThreadContext *tc, MVMArrayBody *body, MVMint64 kind, const char *op) {
+    if (kind < MVM_ARRAY_REDUCE_SUM || kind > MVM_ARRAY_REDUCE_MAX)
+        MVM_exception_throw_adhoc(tc, "%s: unknown reduction %"PRId64, op, kind);
+    if (kind != MVM_ARRAY_REDUCE_SUM && body->elems == 0)
+        MVM_exception_throw_adhoc(tc, "%s: cannot find the %s of an empty array",
+            op, kind == MVM_ARRAY_REDUCE_MIN ? "minimum" : "maximum");
+}
+
+/* Reduces a native array to a single value; the sum, minimum or maximum of
+ * its elements. Sums of integer arrays are taken in 64 bits, so they don't
+ * wrap around at the size of the elements, only beyond 64 bits. */
+MVMint64 MVM_VMArray_reduce_i(MVMThreadContext *tc, MVMObject *arr, MVMint64 kind) {
+    MVMArrayREPRData *repr_data = get_native_repr_data(tc, arr, 0, "reducepos_i");
+    MVMArrayBody     *body      = &((MVMArray *)arr)->body;
+    MVMint64          n         = body->elems;
+    MVMint64          result    = 0;
+    check_reduce(tc, body, kind, "reducepos_i");
+    switch (repr_data->slot_type) {
+        case MVM_ARRAY_I64: REDUCE_SLOTS(MVMint64,  i64, MVMuint64, result); break;
+        case MVM_ARRAY_I32: REDUCE_SLOTS(MVMint32,  i32, MVMuint64, result); break;
+        case MVM_ARRAY_I16: REDUCE_SLOTS(MVMint16,  i16, MVMuint64, result); break;
+        case MVM_ARRAY_I8:  REDUCE_SLOTS(MVMint8,   i8,  MVMuint64, result); break;
+        case MVM_ARRAY_U64: REDUCE_SLOTS(MVMuint64, u64, MVMuint64, result); break;
+        case MVM_ARRAY_U32: REDUCE_SLOTS(MVMuint32, u32, MVMuint64, result); break;
+        case MVM_ARRAY_U16: REDUCE_SLOTS(MVMuint16, u16, MVMuint64, result); break;
+        case MVM_ARRAY_U8:  REDUCE_SLOTS(MVMuint8,  u8,  MVMuint64, result); break;
+    }
+    return result;
+}
+MVMnum64 MVM_VMArray_reduce_n(MVMThreadContext *tc, MVMObject *arr, MVMint64 kind) {
+    MVMArrayREPRData *repr_data = get_native_repr_data(tc, arr, 1, "reducepos_n");
+    MVMArrayBody     *body      = &((MVMArray *)arr)->body;
+    MVMint64          n         = body->elems;
+    MVMnum64          result    = 0;
+    check_reduce(tc, body, kind, "reducepos_n");
+    if (repr_data->slot_type == MVM_ARRAY_N64)
+        REDUCE_SLOTS(MVMnum64, n64, MVMnum64, result);
+    else
+        REDUCE_SLOTS(MVMnum32, n32, MVMnum64, result);
+    return result;
+}
+
+#define BINOP_SLOTS(type, member) do { \
+    type *d  = dest_body->slots.member + dest_body->start; \
+    type *sa = a_body->slots.member + a_body->start; \
+    type *sb = b_body->slots.member + b_body->start; \
+    MVMint64 k; \
+    switch (kind) { \
+        case MVM_ARRAY_BINOP_ADD: \
+            MVM_VECTORIZE_LOOP \
+            for (k = 0; k < n; k++) \
+                d[k] = sa[k] + sb[k]; \
+            break; \
+        case MVM_ARRAY_BINOP_SUB: \
+            MVM_VECTORIZE_LOOP \
+            for (k = 0; k < n; k++) \
+                d[k] = sa[k] - sb[k]; \
+            break; \
+        case MVM_ARRAY_BINOP_MUL: \
+            MVM_VECTORIZE_LOOP \
+            for (k = 0; k < n; k++) \
+                d[k] = sa[k] * sb[k]; \
+            break; \
+    } \
+} while (0)
+
+/* Applies an element-wise arithmetic operation to two native arrays of the
+ * same type and length, storing the results in the destination array (which
+ * must also have that type, and is resized to match; it may be one of the
+ * sources). */
+void MVM_VMArray_binop(MVMThreadContext *tc, MVMObject *dest, MVMObject *a, MVMObject *b, MVMint64 kind) {
+    MVMArrayREPRData *repr_data;
+    MVMArrayBody     *dest_body, *a_body, *b_body;
+    MVMint64          n;
+    MVMuint8          slot_type;
+    if (REPR(a)->ID == MVM_REPR_ID_VMArray && IS_CONCRETE(a)
+            && (((MVMArrayREPRData *)STABLE(a)->REPR_data)->slot_type == MVM_ARRAY_N64
+             || ((MVMArrayREPRData *)STABLE(a)->REPR_data)->slot_type == MVM_ARRAY_N32))
+        repr_data = get_native_repr_data(tc, a, 1, "binoppos");
+    else
+        repr_data = get_native_repr_data(tc, a, 0, "binoppos");
+    slot_type = repr_data->slot_type;
+    if (kind < MVM_ARRAY_BINOP_ADD || kind > MVM_ARRAY_BINOP_MUL)
+        MVM_exception_throw_adhoc(tc, "binoppos: unknown operation %"PRId64, kind);
+    if (REPR(b)->ID != MVM_REPR_ID_VMArray || !IS_CONCRETE(b)
+            || ((MVMArrayREPRData *)STABLE(b)->REPR_data)->slot_type != slot_type
+            || REPR(dest)->ID != MVM_REPR_ID_VMArray || !IS_CONCRETE(dest)
+            || ((MVMArrayREPRData *)STABLE(dest)->REPR_data)->slot_type != slot_type)
+        MVM_exception_throw_adhoc(tc, "binoppos requires native arrays of the same type");
+    dest_body = &((MVMArray *)dest)->body;
+    a_body    = &((MVMArray *)a)->body;
+    b_body    = &((MVMArray *)b)->body;
+    n         = a_body->elems;
+    if (b_body->elems != n)
+        MVM_exception_throw_adhoc(tc,
+            "binoppos requires arrays of the same length, got %"PRIu64" and %"PRIu64" elements",
+            a_body->elems, b_body->elems);
+    enter_single_user(tc, dest_body);
+    if (dest_body->elems != n)
+        set_size_internal(tc, dest_body, n, repr_data);
+    switch (slot_type) {
+        case MVM_ARRAY_I64: BINOP_SLOTS(MVMint64,  i64); break;
+        case MVM_ARRAY_I32: BINOP_SLOTS(MVMint32,  i32); break;
+        case MVM_ARRAY_I16: BINOP_SLOTS(MVMint16,  i16); break;
+        case MVM_ARRAY_I8:  BINOP_SLOTS(MVMint8,   i8);  break;
+        case MVM_ARRAY_U64: BINOP_SLOTS(MVMuint64, u64); break;
+        case MVM_ARRAY_U32: BINOP_SLOTS(MVMuint32, u32); break;
+        case MVM_ARRAY_U16: BINOP_SLOTS(MVMuint16, u16); break;
+        case MVM_ARRAY_U8:  BINOP_SLOTS(MVMuint8,  u8);  break;
+        case MVM_ARRAY_N64: BINOP_SLOTS(MVMnum64,  n64); break;
+        case MVM_ARRAY_N32: BINOP_SLOTS(MVMnum32,  n32); break;
+    }
+    exit_single_user(tc, dest_body);
+}
+
+#define INDEX_SLOTS(type, member, v) do { \
+    type *slots = body->slots.member + body->start; \
+    type  want  = (type)(v); \
+    MVMint64 k; \
+    for (k = start; k < n; k++) \
+        if (slots[k] == want) \
+            return k; \
+} while (0)
+
+/* Checks if an integer can be stored in a slot of the given type without
+ * being truncated. 64-bit unsigned slots hold every value, since they are
+ * read back as the signed integer with the same bits. */
+static int int_fits_slot(MVMint64 value, MVMuint8 slot_type) {
+    switch (slot_type) {
+        case MVM_ARRAY_I32: return value >= INT32_MIN && value <= INT32_MAX;
+        case MVM_ARRAY_I16: return value >= INT16_MIN && value <= INT16_MAX;
+        case MVM_ARRAY_I8:  return value >= INT8_MIN  && value <= INT8_MAX;
+        case MVM_ARRAY_U32: return value >= 0 && value <= UINT32_MAX;
+        case MVM_ARRAY_U16: return value >= 0 && value <= UINT16_MAX;
+        case MVM_ARRAY_U8:  return value >= 0 && value <= UINT8_MAX;
+        default:            return 1;
+    }
+}
+
+/* Finds the first element from start onwards that is equal to the value, and
+ * returns its index, or -1 if there is none. A value that no element could
+ * hold is never found. */
+MVMint64 MVM_VMArray_index_i(MVMThreadContext *tc, MVMObject *arr, MVMint64 value, MVMint64 start) {
+    MVMArrayREPRData *repr_data = get_native_repr_data(tc, arr, 0, "indexpos_i");
+    MVMArrayBody     *body      = &((MVMArray *)arr)->body;
+    MVMint64          n         = body->elems;
+    if (start < 0)
+        start = 0;
+    if (start >= n || !int_fits_slot(value, repr_data->slot_type))
+        return -1;
+    switch (repr_data->slot_type) {
+        case MVM_ARRAY_I64: INDEX_SLOTS(MVMint64,  i64, value); break;
+        case MVM_ARRAY_I32: INDEX_SLOTS(MVMint32,  i32, value); break;
+        case MVM_ARRAY_I16: INDEX_SLOTS(MVMint16,  i16, value); break;
+        case MVM_ARRAY_U64: INDEX_SLOTS(MVMuint64, u64, value); break;
+        case MVM_ARRAY_U32: INDEX_SLOTS(MVMuint32, u32, value); break;
+        case MVM_ARRAY_U16: INDEX_SLOTS(MVMuint16, u16, value); break;
+        case MVM_ARRAY_I8:
+        case MVM_ARRAY_U8: {
+            /* memchr is about as fast as it gets for bytes. */
+            MVMuint8 *slots = body->slots.u8 + body->start;
+            MVMuint8 *found = memchr(slots + start, (MVMuint8)value, n - start);
+            return found ? found - slots : -1;
+        }
+    }
+    return -1;
+}
+MVMint64 MVM_VMArray_index_n(MVMThreadContext *tc, MVMObject *arr, MVMnum64 value, MVMint64 start) {
+    MVMArrayREPRData *repr_data = get_native_repr_data(tc, arr, 1, "indexpos_n");
+    MVMArrayBody     *body      = &((MVMArray *)arr)->body;
+    MVMint64          n         = body->elems;
+    if (start < 0)
+        start = 0;
+    if (start >= n)
+        return -1;
+    if (repr_data->slot_type == MVM_ARRAY_N64)
+        INDEX_SLOTS(MVMnum64, n64, value);
+    else if ((MVMnum64)(MVMnum32)value == value)
+        INDEX_SLOTS(MVMnum32, n32, value);
+    return -1;
+}
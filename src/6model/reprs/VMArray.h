@@ -76,3 +76,20 @@ struct MVMArrayREPRData {
     MVMObject *elem_type;
 };
 void MVM_VMArray_at_pos(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMint64 index, MVMRegister *value, MVMuint16 kind);
+
+/* Reductions and element-wise operations for the bulk native array ops. */
+#define MVM_ARRAY_REDUCE_SUM    0
+#define MVM_ARRAY_REDUCE_MIN    1
+#define MVM_ARRAY_REDUCE_MAX    2
+#define MVM_ARRAY_BINOP_ADD     0
+#define MVM_ARRAY_BINOP_SUB     1
+#define MVM_ARRAY_BINOP_MUL     2
+
+/* Bulk operations on native arrays. */
+void MVM_VMArray_fill_i(MVMThreadContext *tc, MVMObject *arr, MVMint64 value, MVMint64 start, MVMint64 count);
+void MVM_VMArray_fill_n(MVMThreadContext *tc, MVMObject *arr, MVMnum64 value, MVMint64 start, MVMint64 count);
+MVMint64 MVM_VMArray_reduce_i(MVMThreadContext *tc, MVMObject *arr, MVMint64 kind);
+MVMnum64 MVM_VMArray_reduce_n(MVMThreadContext *tc, MVMObject *arr, MVMint64 kind);
+void MVM_VMArray_binop(MVMThreadContext *tc, MVMObject *dest, MVMObject *a, MVMObject *b, MVMint64 kind);
+MVMint64 MVM_VMArray_index_i(MVMThreadContext *tc, MVMObject *arr, MVMint64 value, MVMint64 start);
+MVMint64 MVM_VMArray_index_n(MVMThreadContext *tc, MVMObject *arr, MVMnum64 value, MVMint64 start);
@@ -276,6 +276,7 @@ struct MVMInstance {
     MVMint8 spesh_inline_enabled;
     MVMint8 spesh_inline_log;
     MVMint8 spesh_osr_enabled;
+    MVMint8 spesh_osr_sync;
     MVMint8 spesh_pea_enabled;
     MVMint8 spesh_nodelay;
     MVMint8 spesh_blocking;
@@ -343,19 +344,19 @@ struct MVMInstance {
      * I/O and process state
      ************************************************************************/
 
-    /* The event loop thread, a mutex to avoid start-races, a concurrent
-     * queue of tasks that need to be processed by the event loop thread
-     * and an array of active tasks, for the purpose of keeping them GC
-     * marked. */
-    MVMObject        *event_loop_thread;
-    uv_loop_t        *event_loop;
+    /* The event loops (each started along with its thread the first time
+     * it is given a task), the counter used to hand new tasks out to them
+     * in turn, and a mutex to avoid start-races. */
+    MVMEventLoop     *event_loops;
+    MVMuint32         num_event_loops;
+    AO_t              next_event_loop;
     uv_mutex_t        mutex_event_loop;
-    MVMObject        *event_loop_todo_queue;
-    MVMObject        *event_loop_permit_queue;
-    MVMObject        *event_loop_cancel_queue;
-    MVMObject        *event_loop_active;
-    MVMObject        *event_loop_free_indices;
-    uv_async_t       *event_loop_wakeup;
+
+    /* Whether event loops should try to use io_uring. */
+    MVMuint32         use_io_uring;
+
+    /* Recently resolved host names. */
+    MVMDNSCache      *dns_cache;
 
     /* Standard file handles. */
     MVMObject *stdin_handle;
@@ -538,10 +539,18 @@ struct MVMInstance {
     /* Flag for if NFA debugging is enabled. */
     MVMint8 nfa_debug_enabled;
 
+    /* Flag for if hot NFAs get a DFA built for them, and the mutex taken
+     * when adding states to such a DFA. */
+    MVMint8 nfa_dfa_enabled;
+    uv_mutex_t mutex_nfa_dfa;
+
     /* Hash Secrets which is used as the hash seed. This is to avoid denial of
      * service type attacks. */
     MVMuint64 hashSecrets[2];
 
+    /* Which function is used to hash strings (one of MVM_STRING_HASH_*). */
+    MVMuint8 string_hash_function;
+
     /************************************************************************
      * VM Event subscription
      ************************************************************************/
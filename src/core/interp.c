@@ -5608,6 +5608,207 @@ void MVM_interp_run(MVMThreadContext *tc, void (*initial_invoke)(MVMThreadContex
                 GET_REG(cur_op, 0).i64 = MVM_platform_total_memory();
                 cur_op += 2;
                 goto NEXT;
+            OP(fillpos_i): {
+                MVMObject *arr = GET_REG(cur_op, 0).o;
+                MVM_VMArray_fill_i(tc, arr, GET_REG(cur_op, 2).i64,
+                    GET_REG(cur_op, 4).i64, GET_REG(cur_op, 6).i64);
+                MVM_SC_WB_OBJ(tc, arr);
+                cur_op += 8;
+                goto NEXT;
+            }
+            OP(fillpos_n): {
+                MVMObject *arr = GET_REG(cur_op, 0).o;
+                MVM_VMArray_fill_n(tc, arr, GET_REG(cur_op, 2).n64,
+                    GET_REG(cur_op, 4).i64, GET_REG(cur_op, 6).i64);
+                MVM_SC_WB_OBJ(tc, arr);
+                cur_op += 8;
+                goto NEXT;
+            }
+            OP(reducepos_i):
+                GET_REG(cur_op, 0).i64 = MVM_VMArray_reduce_i(tc,
+                    GET_REG(cur_op, 2).o, GET_REG(cur_op, 4).i64);
+                cur_op += 6;
+                goto NEXT;
+            OP(reducepos_n):
+                GET_REG(cur_op, 0).n64 = MVM_VMArray_reduce_n(tc,
+                    GET_REG(cur_op, 2).o, GET_REG(cur_op, 4).i64);
+                cur_op += 6;
+                goto NEXT;
+            OP(binoppos): {
+                MVMObject *dest = GET_REG(cur_op, 0).o;
+                MVM_VMArray_binop(tc, dest, GET_REG(cur_op, 2).o,
+                    GET_REG(cur_op, 4).o, GET_REG(cur_op, 6).i64);
+                MVM_SC_WB_OBJ(tc, dest);
+                cur_op += 8;
+                goto NEXT;
+            }
+            OP(indexpos_i):
+                GET_REG(cur_op, 0).i64 = MVM_VMArray_index_i(tc, GET_REG(cur_op, 2).o,
+                    GET_REG(cur_op, 4).i64, GET_REG(cur_op, 6).i64);
+                cur_op += 8;
+                goto NEXT;
+            OP(indexpos_n):
+                GET_REG(cur_op, 0).i64 = MVM_VMArray_index_n(tc, GET_REG(cur_op, 2).o,
+                    GET_REG(cur_op, 4).n64, GET_REG(cur_op, 6).i64);
+                cur_op += 8;
+                goto NEXT;
+            OP(sbappend_s): {
+                MVMObject *sb = GET_REG(cur_op, 0).o;
+                MVM_string_builder_ensure(tc, sb, "sbappend_s");
+                MVM_string_builder_append_str(tc, (MVMStringBuilder *)sb, GET_REG(cur_op, 2).s);
+                cur_op += 4;
+                goto NEXT;
+            }
+            OP(sbappend_i): {
+                MVMObject *sb = GET_REG(cur_op, 0).o;
+                MVM_string_builder_ensure(tc, sb, "sbappend_i");
+                MVM_string_builder_append_int(tc, (MVMStringBuilder *)sb, GET_REG(cur_op, 2).i64);
+                cur_op += 4;
+                goto NEXT;
+            }
+            OP(sbappend_n): {
+                MVMObject *sb = GET_REG(cur_op, 0).o;
+                MVM_string_builder_ensure(tc, sb, "sbappend_n");
+                MVM_string_builder_append_num(tc, (MVMStringBuilder *)sb, GET_REG(cur_op, 2).n64);
+                cur_op += 4;
+                goto NEXT;
+            }
+            OP(sbappendcp): {
+                MVMObject *sb = GET_REG(cur_op, 0).o;
+                MVM_string_builder_ensure(tc, sb, "sbappendcp");
+                MVM_string_builder_append_codepoint(tc, (MVMStringBuilder *)sb, GET_REG(cur_op, 2).i64);
+                cur_op += 4;
+                goto NEXT;
+            }
+            OP(sbelems): {
+                MVMObject *sb = GET_REG(cur_op, 2).o;
+                MVM_string_builder_ensure(tc, sb, "sbelems");
+                GET_REG(cur_op, 0).i64 = MVM_string_builder_elems(tc, (MVMStringBuilder *)sb);
+                cur_op += 4;
+                goto NEXT;
+            }
+            OP(sbfinish): {
+                MVMObject *sb = GET_REG(cur_op, 2).o;
+                MVM_string_builder_ensure(tc, sb, "sbfinish");
+                GET_REG(cur_op, 0).s = MVM_string_builder_finish(tc, (MVMStringBuilder *)sb);
+                cur_op += 4;
+                goto NEXT;
+            }
+            OP(msconfigure): {
+                MVMObject *ms = GET_REG(cur_op, 0).o;
+                MVM_multi_search_ensure(tc, ms, "msconfigure");
+                MVM_multi_search_configure(tc, (MVMMultiSearch *)ms, GET_REG(cur_op, 2).o);
+                cur_op += 4;
+                goto NEXT;
+            }
+            OP(msindex): {
+                MVMObject *ms = GET_REG(cur_op, 2).o;
+                MVM_multi_search_ensure(tc, ms, "msindex");
+                GET_REG(cur_op, 0).i64 = MVM_multi_search_index(tc, (MVMMultiSearch *)ms,
+                    GET_REG(cur_op, 4).s, GET_REG(cur_op, 6).i64);
+                cur_op += 8;
+                goto NEXT;
+            }
+            OP(mslastneedle): {
+                MVMObject *ms = GET_REG(cur_op, 2).o;
+                MVM_multi_search_ensure(tc, ms, "mslastneedle");
+                GET_REG(cur_op, 0).i64 = MVM_multi_search_last_needle(tc, (MVMMultiSearch *)ms);
+                cur_op += 4;
+                goto NEXT;
+            }
+            OP(mssplit): {
+                MVMObject *ms = GET_REG(cur_op, 2).o;
+                MVM_multi_search_ensure(tc, ms, "mssplit");
+                GET_REG(cur_op, 0).o = MVM_multi_search_split(tc, (MVMMultiSearch *)ms,
+                    GET_REG(cur_op, 4).s);
+                cur_op += 6;
+                goto NEXT;
+            }
+            OP(unicollkey):
+                GET_REG(cur_op, 0).o = MVM_unicode_string_collation_key(tc,
+                    GET_REG(cur_op, 2).s, GET_REG(cur_op, 4).i64,
+                    GET_REG(cur_op, 6).i64, GET_REG(cur_op, 8).i64,
+                    GET_REG(cur_op, 10).o);
+                cur_op += 12;
+                goto NEXT;
+            OP(parsenums):
+                GET_REG(cur_op, 0).i64 = MVM_coerce_parse_nums(tc,
+                    GET_REG(cur_op, 2).o, GET_REG(cur_op, 4).o, GET_REG(cur_op, 6).i64);
+                cur_op += 8;
+                goto NEXT;
+            OP(asyncopen):
+                GET_REG(cur_op, 0).o = MVM_file_open_async(tc, GET_REG(cur_op, 2).s, GET_REG(cur_op, 4).s);
+                cur_op += 6;
+                goto NEXT;
+            OP(readinto_fhb):
+                GET_REG(cur_op, 0).i64 = MVM_io_read_bytes_into(tc, GET_REG(cur_op, 2).o,
+                    GET_REG(cur_op, 4).o, GET_REG(cur_op, 6).i64, GET_REG(cur_op, 8).i64);
+                cur_op += 10;
+                goto NEXT;
+            OP(writeslice_fhb):
+                MVM_io_write_bytes_slice(tc, GET_REG(cur_op, 0).o, GET_REG(cur_op, 2).o,
+                    GET_REG(cur_op, 4).i64, GET_REG(cur_op, 6).i64);
+                cur_op += 8;
+                goto NEXT;
+            OP(writev_fhb):
+                MVM_io_write_bytes_vec(tc, GET_REG(cur_op, 0).o, GET_REG(cur_op, 2).o);
+                cur_op += 4;
+                goto NEXT;
+            OP(asyncwritevbytes):
+                GET_REG(cur_op, 0).o = MVM_io_write_bytes_vec_async(tc, GET_REG(cur_op, 2).o,
+                    GET_REG(cur_op, 4).o, GET_REG(cur_op, 6).o, GET_REG(cur_op, 8).o,
+                    GET_REG(cur_op, 10).o);
+                cur_op += 12;
+                goto NEXT;
+            OP(transfer_fh):
+                GET_REG(cur_op, 0).i64 = MVM_io_transfer(tc, GET_REG(cur_op, 2).o,
+                    GET_REG(cur_op, 4).o, GET_REG(cur_op, 6).i64);
+                cur_op += 8;
+                goto NEXT;
+            OP(asynctransfer):
+                GET_REG(cur_op, 0).o = MVM_io_transfer_async(tc, GET_REG(cur_op, 2).o,
+                    GET_REG(cur_op, 4).o, GET_REG(cur_op, 6).o, GET_REG(cur_op, 8).o,
+                    GET_REG(cur_op, 10).i64, GET_REG(cur_op, 12).o);
+                cur_op += 14;
+                goto NEXT;
+            OP(mmapfile):
+                GET_REG(cur_op, 0).o = MVM_mapped_buffer_open(tc, GET_REG(cur_op, 2).o,
+                    GET_REG(cur_op, 4).s, GET_REG(cur_op, 6).i64, GET_REG(cur_op, 8).i64);
+                cur_op += 10;
+                goto NEXT;
+            OP(mmapslice):
+                GET_REG(cur_op, 0).o = MVM_mapped_buffer_slice(tc, GET_REG(cur_op, 2).o,
+                    GET_REG(cur_op, 4).i64, GET_REG(cur_op, 6).i64);
+                cur_op += 8;
+                goto NEXT;
+            OP(mmapadvise):
+                MVM_mapped_buffer_advise(tc, GET_REG(cur_op, 0).o, GET_REG(cur_op, 2).i64,
+                    GET_REG(cur_op, 4).i64, GET_REG(cur_op, 6).i64);
+                cur_op += 8;
+                goto NEXT;
+            OP(mmapindex):
+                GET_REG(cur_op, 0).i64 = MVM_mapped_buffer_index(tc, GET_REG(cur_op, 2).o,
+                    GET_REG(cur_op, 4).o, GET_REG(cur_op, 6).i64);
+                cur_op += 8;
+                goto NEXT;
+            OP(asyncreadbatch):
+                GET_REG(cur_op, 0).o = MVM_io_read_batch_async(tc, GET_REG(cur_op, 2).o,
+                    GET_REG(cur_op, 4).o, GET_REG(cur_op, 6).o, GET_REG(cur_op, 8).o,
+                    GET_REG(cur_op, 10).i64, GET_REG(cur_op, 12).o);
+                cur_op += 14;
+                goto NEXT;
+            OP(asyncwritebatchto):
+                GET_REG(cur_op, 0).o = MVM_io_write_batch_to_async(tc, GET_REG(cur_op, 2).o,
+                    GET_REG(cur_op, 4).o, GET_REG(cur_op, 6).o, GET_REG(cur_op, 8).o,
+                    GET_REG(cur_op, 10).o, GET_REG(cur_op, 12).o);
+                cur_op += 14;
+                goto NEXT;
+            OP(asynclistensharded):
+                GET_REG(cur_op, 0).o = MVM_io_socket_listen_sharded_async(tc,
+                    GET_REG(cur_op, 2).o, GET_REG(cur_op, 4).o, GET_REG(cur_op, 6).s,
+                    GET_REG(cur_op, 8).i64, (MVMint32)GET_REG(cur_op, 10).i64, GET_REG(cur_op, 12).o);
+                cur_op += 14;
+                goto NEXT;
             OP(sp_guard): {
                 MVMRegister *target = &GET_REG(cur_op, 0);
                 MVMObject *check = GET_REG(cur_op, 2).o;
@@ -6108,6 +6309,48 @@ void MVM_interp_run(MVMThreadContext *tc, void (*initial_invoke)(MVMThreadContex
                 cur_op += 6;
                 goto NEXT;
             }
+            OP(sp_p6oget_i16): {
+                MVMObject *o     = GET_REG(cur_op, 2).o;
+                char      *data  = MVM_p6opaque_real_data(tc, OBJECT_BODY(o));
+                GET_REG(cur_op, 0).i64 = *((MVMint16 *)(data + GET_UI16(cur_op, 4)));
+                cur_op += 6;
+                goto NEXT;
+            }
+            OP(sp_p6oget_i8): {
+                MVMObject *o     = GET_REG(cur_op, 2).o;
+                char      *data  = MVM_p6opaque_real_data(tc, OBJECT_BODY(o));
+                GET_REG(cur_op, 0).i64 = *((MVMint8 *)(data + GET_UI16(cur_op, 4)));
+                cur_op += 6;
+                goto NEXT;
+            }
+            OP(sp_p6oget_n32): {
+                MVMObject *o     = GET_REG(cur_op, 2).o;
+                char      *data  = MVM_p6opaque_real_data(tc, OBJECT_BODY(o));
+                GET_REG(cur_op, 0).n64 = *((MVMnum32 *)(data + GET_UI16(cur_op, 4)));
+                cur_op += 6;
+                goto NEXT;
+            }
+            OP(sp_p6obind_i16): {
+                MVMObject *o     = GET_REG(cur_op, 0).o;
+                char      *data  = MVM_p6opaque_real_data(tc, OBJECT_BODY(o));
+                *((MVMint16 *)(data + GET_UI16(cur_op, 2))) = (MVMint16)GET_REG(cur_op, 4).i64;
+                cur_op += 6;
+                goto NEXT;
+            }
+            OP(sp_p6obind_i8): {
+                MVMObject *o     = GET_REG(cur_op, 0).o;
+                char      *data  = MVM_p6opaque_real_data(tc, OBJECT_BODY(o));
+                *((MVMint8 *)(data + GET_UI16(cur_op, 2))) = (MVMint8)GET_REG(cur_op, 4).i64;
+                cur_op += 6;
+                goto NEXT;
+            }
+            OP(sp_p6obind_n32): {
+                MVMObject *o     = GET_REG(cur_op, 0).o;
+                char      *data  = MVM_p6opaque_real_data(tc, OBJECT_BODY(o));
+                *((MVMnum32 *)(data + GET_UI16(cur_op, 2))) = (MVMnum32)GET_REG(cur_op, 4).n64;
+                cur_op += 6;
+                goto NEXT;
+            }
             OP(sp_getvt_o): {
                 MVMObject *o     = GET_REG(cur_op, 2).o;
                 char      *data  = (char *)o;
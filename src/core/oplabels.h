@@ -824,6 +824,39 @@ static const void * const LABELS[] = {
     &&OP_uname,
     &&OP_freemem,
     &&OP_totalmem,
+    &&OP_fillpos_i,
+    &&OP_fillpos_n,
+    &&OP_reducepos_i,
+    &&OP_reducepos_n,
+    &&OP_binoppos,
+    &&OP_indexpos_i,
+    &&OP_indexpos_n,
+    &&OP_sbappend_s,
+    &&OP_sbappend_i,
+    &&OP_sbappend_n,
+    &&OP_sbappendcp,
+    &&OP_sbelems,
+    &&OP_sbfinish,
+    &&OP_msconfigure,
+    &&OP_msindex,
+    &&OP_mslastneedle,
+    &&OP_mssplit,
+    &&OP_unicollkey,
+    &&OP_parsenums,
+    &&OP_asyncopen,
+    &&OP_readinto_fhb,
+    &&OP_writeslice_fhb,
+    &&OP_writev_fhb,
+    &&OP_asyncwritevbytes,
+    &&OP_transfer_fh,
+    &&OP_asynctransfer,
+    &&OP_mmapfile,
+    &&OP_mmapslice,
+    &&OP_mmapadvise,
+    &&OP_mmapindex,
+    &&OP_asyncreadbatch,
+    &&OP_asyncwritebatchto,
+    &&OP_asynclistensharded,
     &&OP_sp_guard,
     &&OP_sp_guardconc,
     &&OP_sp_guardtype,
@@ -883,6 +916,12 @@ static const void * const LABELS[] = {
     &&OP_sp_p6obind_s,
     &&OP_sp_p6oget_i32,
     &&OP_sp_p6obind_i32,
+    &&OP_sp_p6oget_i16,
+    &&OP_sp_p6oget_i8,
+    &&OP_sp_p6oget_n32,
+    &&OP_sp_p6obind_i16,
+    &&OP_sp_p6obind_i8,
+    &&OP_sp_p6obind_n32,
     &&OP_sp_getvt_o,
     &&OP_sp_getvc_o,
     &&OP_sp_fastbox_i,
@@ -986,45 +1025,6 @@ static const void * const LABELS[] = {
     NULL,
     NULL,
     NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
     &&OP_CALL_EXTOP,
     &&OP_CALL_EXTOP,
     &&OP_CALL_EXTOP,
@@ -824,102 +824,141 @@
 #define MVM_OP_uname 820
 #define MVM_OP_freemem 821
 #define MVM_OP_totalmem 822
-#define MVM_OP_sp_guard 823
-#define MVM_OP_sp_guardconc 824
-#define MVM_OP_sp_guardtype 825
-#define MVM_OP_sp_guardsf 826
-#define MVM_OP_sp_guardsfouter 827
-#define MVM_OP_sp_guardobj 828
-#define MVM_OP_sp_guardnotobj 829
-#define MVM_OP_sp_guardjustconc 830
-#define MVM_OP_sp_guardjusttype 831
-#define MVM_OP_sp_rebless 832
-#define MVM_OP_sp_resolvecode 833
-#define MVM_OP_sp_decont 834
-#define MVM_OP_sp_getlex_o 835
-#define MVM_OP_sp_getlex_ins 836
-#define MVM_OP_sp_getlex_no 837
-#define MVM_OP_sp_bindlex_in 838
-#define MVM_OP_sp_bindlex_os 839
-#define MVM_OP_sp_getarg_o 840
-#define MVM_OP_sp_getarg_i 841
-#define MVM_OP_sp_getarg_n 842
-#define MVM_OP_sp_getarg_s 843
-#define MVM_OP_sp_fastinvoke_v 844
-#define MVM_OP_sp_fastinvoke_i 845
-#define MVM_OP_sp_fastinvoke_n 846
-#define MVM_OP_sp_fastinvoke_s 847
-#define MVM_OP_sp_fastinvoke_o 848
-#define MVM_OP_sp_speshresolve 849
-#define MVM_OP_sp_paramnamesused 850
-#define MVM_OP_sp_getspeshslot 851
-#define MVM_OP_sp_findmeth 852
-#define MVM_OP_sp_fastcreate 853
-#define MVM_OP_sp_get_o 854
-#define MVM_OP_sp_get_i64 855
-#define MVM_OP_sp_get_i32 856
-#define MVM_OP_sp_get_i16 857
-#define MVM_OP_sp_get_i8 858
-#define MVM_OP_sp_get_n 859
-#define MVM_OP_sp_get_s 860
-#define MVM_OP_sp_bind_o 861
-#define MVM_OP_sp_bind_i64 862
-#define MVM_OP_sp_bind_i32 863
-#define MVM_OP_sp_bind_i16 864
-#define MVM_OP_sp_bind_i8 865
-#define MVM_OP_sp_bind_n 866
-#define MVM_OP_sp_bind_s 867
-#define MVM_OP_sp_bind_s_nowb 868
-#define MVM_OP_sp_p6oget_o 869
-#define MVM_OP_sp_p6ogetvt_o 870
-#define MVM_OP_sp_p6ogetvc_o 871
-#define MVM_OP_sp_p6oget_i 872
-#define MVM_OP_sp_p6oget_n 873
-#define MVM_OP_sp_p6oget_s 874
-#define MVM_OP_sp_p6oget_bi 875
-#define MVM_OP_sp_p6obind_o 876
-#define MVM_OP_sp_p6obind_i 877
-#define MVM_OP_sp_p6obind_n 878
-#define MVM_OP_sp_p6obind_s 879
-#define MVM_OP_sp_p6oget_i32 880
-#define MVM_OP_sp_p6obind_i32 881
-#define MVM_OP_sp_getvt_o 882
-#define MVM_OP_sp_getvc_o 883
-#define MVM_OP_sp_fastbox_i 884
-#define MVM_OP_sp_fastbox_bi 885
-#define MVM_OP_sp_fastbox_i_ic 886
-#define MVM_OP_sp_fastbox_bi_ic 887
-#define MVM_OP_sp_deref_get_i64 888
-#define MVM_OP_sp_deref_get_n 889
-#define MVM_OP_sp_deref_bind_i64 890
-#define MVM_OP_sp_deref_bind_n 891
-#define MVM_OP_sp_getlexvia_o 892
-#define MVM_OP_sp_getlexvia_ins 893
-#define MVM_OP_sp_bindlexvia_os 894
-#define MVM_OP_sp_bindlexvia_in 895
-#define MVM_OP_sp_getstringfrom 896
-#define MVM_OP_sp_getwvalfrom 897
-#define MVM_OP_sp_jit_enter 898
-#define MVM_OP_sp_boolify_iter 899
-#define MVM_OP_sp_boolify_iter_arr 900
-#define MVM_OP_sp_boolify_iter_hash 901
-#define MVM_OP_sp_cas_o 902
-#define MVM_OP_sp_atomicload_o 903
-#define MVM_OP_sp_atomicstore_o 904
-#define MVM_OP_sp_add_I 905
-#define MVM_OP_sp_sub_I 906
-#define MVM_OP_sp_mul_I 907
-#define MVM_OP_sp_bool_I 908
-#define MVM_OP_prof_enter 909
-#define MVM_OP_prof_enterspesh 910
-#define MVM_OP_prof_enterinline 911
-#define MVM_OP_prof_enternative 912
-#define MVM_OP_prof_exit 913
-#define MVM_OP_prof_allocated 914
-#define MVM_OP_prof_replaced 915
-#define MVM_OP_ctw_check 916
-#define MVM_OP_coverage_log 917
-#define MVM_OP_breakpoint 918
+#define MVM_OP_fillpos_i 823
+#define MVM_OP_fillpos_n 824
+#define MVM_OP_reducepos_i 825
+#define MVM_OP_reducepos_n 826
+#define MVM_OP_binoppos 827
+#define MVM_OP_indexpos_i 828
+#define MVM_OP_indexpos_n 829
+#define MVM_OP_sbappend_s 830
+#define MVM_OP_sbappend_i 831
+#define MVM_OP_sbappend_n 832
+#define MVM_OP_sbappendcp 833
+#define MVM_OP_sbelems 834
+#define MVM_OP_sbfinish 835
+#define MVM_OP_msconfigure 836
+#define MVM_OP_msindex 837
+#define MVM_OP_mslastneedle 838
+#define MVM_OP_mssplit 839
+#define MVM_OP_unicollkey 840
+#define MVM_OP_parsenums 841
+#define MVM_OP_asyncopen 842
+#define MVM_OP_readinto_fhb 843
+#define MVM_OP_writeslice_fhb 844
+#define MVM_OP_writev_fhb 845
+#define MVM_OP_asyncwritevbytes 846
+#define MVM_OP_transfer_fh 847
+#define MVM_OP_asynctransfer 848
+#define MVM_OP_mmapfile 849
+#define MVM_OP_mmapslice 850
+#define MVM_OP_mmapadvise 851
+#define MVM_OP_mmapindex 852
+#define MVM_OP_asyncreadbatch 853
+#define MVM_OP_asyncwritebatchto 854
+#define MVM_OP_asynclistensharded 855
+#define MVM_OP_sp_guard 856
+#define MVM_OP_sp_guardconc 857
+#define MVM_OP_sp_guardtype 858
+#define MVM_OP_sp_guardsf 859
+#define MVM_OP_sp_guardsfouter 860
+#define MVM_OP_sp_guardobj 861
+#define MVM_OP_sp_guardnotobj 862
+#define MVM_OP_sp_guardjustconc 863
+#define MVM_OP_sp_guardjusttype 864
+#define MVM_OP_sp_rebless 865
+#define MVM_OP_sp_resolvecode 866
+#define MVM_OP_sp_decont 867
+#define MVM_OP_sp_getlex_o 868
+#define MVM_OP_sp_getlex_ins 869
+#define MVM_OP_sp_getlex_no 870
+#define MVM_OP_sp_bindlex_in 871
+#define MVM_OP_sp_bindlex_os 872
+#define MVM_OP_sp_getarg_o 873
+#define MVM_OP_sp_getarg_i 874
+#define MVM_OP_sp_getarg_n 875
+#define MVM_OP_sp_getarg_s 876
+#define MVM_OP_sp_fastinvoke_v 877
+#define MVM_OP_sp_fastinvoke_i 878
+#define MVM_OP_sp_fastinvoke_n 879
+#define MVM_OP_sp_fastinvoke_s 880
+#define MVM_OP_sp_fastinvoke_o 881
+#define MVM_OP_sp_speshresolve 882
+#define MVM_OP_sp_paramnamesused 883
+#define MVM_OP_sp_getspeshslot 884
+#define MVM_OP_sp_findmeth 885
+#define MVM_OP_sp_fastcreate 886
+#define MVM_OP_sp_get_o 887
+#define MVM_OP_sp_get_i64 888
+#define MVM_OP_sp_get_i32 889
+#define MVM_OP_sp_get_i16 890
+#define MVM_OP_sp_get_i8 891
+#define MVM_OP_sp_get_n 892
+#define MVM_OP_sp_get_s 893
+#define MVM_OP_sp_bind_o 894
+#define MVM_OP_sp_bind_i64 895
+#define MVM_OP_sp_bind_i32 896
+#define MVM_OP_sp_bind_i16 897
+#define MVM_OP_sp_bind_i8 898
+#define MVM_OP_sp_bind_n 899
+#define MVM_OP_sp_bind_s 900
+#define MVM_OP_sp_bind_s_nowb 901
+#define MVM_OP_sp_p6oget_o 902
+#define MVM_OP_sp_p6ogetvt_o 903
+#define MVM_OP_sp_p6ogetvc_o 904
+#define MVM_OP_sp_p6oget_i 905
+#define MVM_OP_sp_p6oget_n 906
+#define MVM_OP_sp_p6oget_s 907
+#define MVM_OP_sp_p6oget_bi 908
+#define MVM_OP_sp_p6obind_o 909
+#define MVM_OP_sp_p6obind_i 910
+#define MVM_OP_sp_p6obind_n 911
+#define MVM_OP_sp_p6obind_s 912
+#define MVM_OP_sp_p6oget_i32 913
+#define MVM_OP_sp_p6obind_i32 914
+#define MVM_OP_sp_p6oget_i16 915
+#define MVM_OP_sp_p6oget_i8 916
+#define MVM_OP_sp_p6oget_n32 917
+#define MVM_OP_sp_p6obind_i16 918
+#define MVM_OP_sp_p6obind_i8 919
+#define MVM_OP_sp_p6obind_n32 920
+#define MVM_OP_sp_getvt_o 921
+#define MVM_OP_sp_getvc_o 922
+#define MVM_OP_sp_fastbox_i 923
+#define MVM_OP_sp_fastbox_bi 924
+#define MVM_OP_sp_fastbox_i_ic 925
+#define MVM_OP_sp_fastbox_bi_ic 926
+#define MVM_OP_sp_deref_get_i64 927
+#define MVM_OP_sp_deref_get_n 928
+#define MVM_OP_sp_deref_bind_i64 929
+#define MVM_OP_sp_deref_bind_n 930
+#define MVM_OP_sp_getlexvia_o 931
+#define MVM_OP_sp_getlexvia_ins 932
+#define MVM_OP_sp_bindlexvia_os 933
+#define MVM_OP_sp_bindlexvia_in 934
+#define MVM_OP_sp_getstringfrom 935
+#define MVM_OP_sp_getwvalfrom 936
+#define MVM_OP_sp_jit_enter 937
+#define MVM_OP_sp_boolify_iter 938
+#define MVM_OP_sp_boolify_iter_arr 939
+#define MVM_OP_sp_boolify_iter_hash 940
+#define MVM_OP_sp_cas_o 941
+#define MVM_OP_sp_atomicload_o 942
+#define MVM_OP_sp_atomicstore_o 943
+#define MVM_OP_sp_add_I 944
+#define MVM_OP_sp_sub_I 945
+#define MVM_OP_sp_mul_I 946
+#define MVM_OP_sp_bool_I 947
+#define MVM_OP_prof_enter 948
+#define MVM_OP_prof_enterspesh 949
+#define MVM_OP_prof_enterinline 950
+#define MVM_OP_prof_enternative 951
+#define MVM_OP_prof_exit 952
+#define MVM_OP_prof_allocated 953
+#define MVM_OP_prof_replaced 954
+#define MVM_OP_ctw_check 955
+#define MVM_OP_coverage_log 956
+#define MVM_OP_breakpoint 957
 
 #define MVM_OP_EXT_BASE 1024
 #define MVM_OP_EXT_CU_LIMIT 1024
@@ -109,6 +109,12 @@ void MVM_tc_destroy(MVMThreadContext *tc) {
     MVM_free(tc->nfa_longlit);
     MVM_free(tc->multi_dim_indices);
 
+    /* Free the NFG lookup cache. */
+    MVM_free(tc->nfg_cache);
+
+    /* Free the I/O transfer buffer. */
+    MVM_free(tc->io_transfer_buffer);
+
     /* Free temporary working big integers. */
     for (i = 0; i < MVM_NUM_TEMP_BIGINTS; i++) {
         mp_clear(tc->temp_bigints[i]);
@@ -80,6 +80,9 @@ struct MVMThreadContext {
     /* The number of locks the thread is holding. */
     MVMint64 num_locks;
 
+    /* The event loop this thread runs, if it is an event loop thread. */
+    MVMEventLoop *event_loop;
+
     /************************************************************************
      * Garbage collection and memory management
      ************************************************************************/
@@ -259,6 +262,11 @@ struct MVMThreadContext {
     MVMint32 osr_hunt_frame_nr;
     MVMint32 osr_hunt_num_spesh_candidates;
 
+    /* Frame number and number of OSR point hits in it, used to decide when a
+     * loop is hot enough to be specialized synchronously. */
+    MVMint32 osr_sync_frame_nr;
+    MVMuint32 osr_sync_hits;
+
     /* If we are currently in a spesh plugin, the current set of guards we
      * have recorded. */
     MVMSpeshPluginGuard *plugin_guards;
@@ -313,6 +321,14 @@ struct MVMThreadContext {
     MVMint64 *nfa_longlit;
     MVMint64  nfa_longlit_len;
 
+    /* Cache of codepoint sequences recently resolved to NFG synthetics, so
+     * we needn't walk the shared trie for them; see nfg.c. */
+    MVMNFGCacheEntry *nfg_cache;
+
+    /* Buffer that transfers between handles go through when the kernel can't
+     * do the copying; see MVM_io_transfer. */
+    char *io_transfer_buffer;
+
     /* Memory for doing multi-dim indexing with late-bound dimension counts. */
     MVMint64 *multi_dim_indices;
     MVMint64  num_multi_dim_indices;
@@ -1966,6 +1966,7 @@ static MVMint32 request_object_metadata(MVMThreadContext *dtc, cmp_ctx_t *ctx, r
         cmp_write_str(ctx, "string_storage_kind", 19);
         switch (string->body.storage_type) {
             case MVM_STRING_GRAPHEME_32:    cmp_write_str(ctx, "grapheme32", 10); break;
+            case MVM_STRING_GRAPHEME_16:    cmp_write_str(ctx, "grapheme16", 10); break;
             case MVM_STRING_GRAPHEME_ASCII: cmp_write_str(ctx, "graphemeASCII", 13); break;
             case MVM_STRING_GRAPHEME_8:     cmp_write_str(ctx, "grapheme8", 9); break;
             case MVM_STRING_STRAND:         cmp_write_str(ctx, "strands", 7); break;
@@ -541,9 +541,8 @@ void MVM_gc_enter_from_allocator(MVMThreadContext *tc) {
         uv_cond_broadcast(&tc->instance->cond_gc_start);
         uv_mutex_unlock(&tc->instance->mutex_gc_orchestrate);
 
-        /* If there's an event loop thread, wake it up to participate. */
-        if (tc->instance->event_loop_wakeup)
-            uv_async_send(tc->instance->event_loop_wakeup);
+        /* If there are event loop threads, wake them up to participate. */
+        MVM_io_eventloop_wake_all(tc);
 
         /* Wait for other threads to be ready. */
         uv_mutex_lock(&tc->instance->mutex_gc_orchestrate);
@@ -75,18 +75,21 @@ void MVM_gc_root_add_instance_roots_to_worklist(MVMThreadContext *tc, MVMGCWorkl
     add_collectable(tc, worklist, snapshot, tc->instance->hll_syms, "HLL symbols");
     add_collectable(tc, worklist, snapshot, tc->instance->clargs, "Command line args");
 
-    add_collectable(tc, worklist, snapshot, tc->instance->event_loop_thread,
-        "Event loop thread");
-    add_collectable(tc, worklist, snapshot, tc->instance->event_loop_todo_queue,
-        "Event loop todo queue");
-    add_collectable(tc, worklist, snapshot, tc->instance->event_loop_permit_queue,
-        "Event loop permit queue");
-    add_collectable(tc, worklist, snapshot, tc->instance->event_loop_cancel_queue,
-        "Event loop cancel queue");
-    add_collectable(tc, worklist, snapshot, tc->instance->event_loop_active,
-        "Event loop active task list");
-    add_collectable(tc, worklist, snapshot, tc->instance->event_loop_free_indices,
-        "Event loop active free indices list");
+    for (i = 0; i < tc->instance->num_event_loops; i++) {
+        MVMEventLoop *el = &(tc->instance->event_loops[i]);
+        add_collectable(tc, worklist, snapshot, el->thread,
+            "Event loop thread");
+        add_collectable(tc, worklist, snapshot, el->todo_queue,
+            "Event loop todo queue");
+        add_collectable(tc, worklist, snapshot, el->permit_queue,
+            "Event loop permit queue");
+        add_collectable(tc, worklist, snapshot, el->cancel_queue,
+            "Event loop cancel queue");
+        add_collectable(tc, worklist, snapshot, el->active,
+            "Event loop active task list");
+        add_collectable(tc, worklist, snapshot, el->free_indices,
+            "Event loop active free indices list");
+    }
 
     add_collectable(tc, worklist, snapshot, tc->instance->spesh_thread,
         "Specialization thread");
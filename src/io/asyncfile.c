@@ -0,0 +1,629 @@
+#include "moar.h"
+#include "platform/io.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#endif
+
+/* Asynchronous file handles. Reads and writes are done on the event loop the
+ * handle belongs to, through its io_uring if it has one, and otherwise using
+ * libuv's file system requests (which run on its thread pool). A read task
+ * reads the file from where the last one left off to the end, a chunk at a
+ * time; writes go one after the other, each at the offset where the last
+ * one ended. */
+
+/* Data that we keep for an asynchronous file handle. */
+typedef struct {
+    /* The file descriptor, and whether we can do reads and writes at given
+     * offsets on it (if not, they just use the current file position). */
+    uv_file fd;
+    MVMint64 seekable;
+
+    /* The event loop all of the handle's tasks run on. */
+    MVMEventLoop *loop;
+
+    /* The rest is only touched on the loop thread. The ring the file is
+     * registered with and its slot there (-1 if it isn't); where the next
+     * read and write will be; and how many requests are in flight, so that
+     * closing can wait for them. */
+    MVMIOUring *slot_ring;
+    MVMint32    slot;
+    MVMuint64   read_offset;
+    MVMuint64   write_offset;
+    MVMuint32   in_flight;
+    MVMuint8    closing;
+    MVMuint8    closed;
+} MVMIOAsyncFileData;
+
+/* Gets the registered file slot to use with the loop's ring, registering the
+ * file if it has not been yet. */
+static MVMint32 file_slot(MVMIOAsyncFileData *data) {
+    MVMIOUring *ring = data->loop->uring;
+    if (data->slot_ring != ring) {
+        data->slot      = MVM_io_uring_register_file(ring, data->fd);
+        data->slot_ring = ring;
+    }
+    return data->slot;
+}
+
+/* Closes the file for real, once it's been asked for and nothing is in
+ * flight any more. */
+static void close_fd(MVMIOAsyncFileData *data) {
+    uv_fs_t req;
+    if (data->slot >= 0 && data->slot_ring == data->loop->uring)
+        MVM_io_uring_unregister_file(data->slot_ring, data->slot);
+    data->slot = -1;
+    uv_fs_close(NULL, &req, data->fd, NULL);
+    uv_fs_req_cleanup(&req);
+    data->closed = 1;
+}
+static void request_done(MVMIOAsyncFileData *data) {
+    if (--data->in_flight == 0 && data->closing && !data->closed)
+        close_fd(data);
+}
+
+/* Pushes an error message for a task. */
+static void push_error(MVMThreadContext *tc, MVMAsyncTask *t, MVMObject *arr, const char *msg) {
+    MVMROOT2(tc, t, arr, {
+        MVMString *msg_str = MVM_string_ascii_decode_nt(tc,
+            tc->instance->VMString, msg);
+        MVMObject *msg_box = MVM_repr_box_str(tc,
+            tc->instance->boot_types.BOOTStr, msg_str);
+        MVM_repr_push_o(tc, arr, msg_box);
+    });
+}
+
+/* Info we convey about a read task. */
+typedef struct {
+    MVMOSHandle      *handle;
+    MVMObject        *buf_type;
+    int               seq_number;
+    MVMThreadContext *tc;
+    int               work_idx;
+
+    /* The request in flight, and the buffer it reads into; buf_index is the
+     * index of the ring's registered buffer, if it's one of those. */
+    MVMIOUringRequest ureq;
+    uv_fs_t           req;
+    uv_buf_t          buf;
+    MVMint32          buf_index;
+    MVMuint8          in_flight;
+    MVMuint8          cancelled;
+} ReadInfo;
+
+static void read_done(ReadInfo *ri, ssize_t nread);
+static void on_uring_read(MVMIOUringRequest *req, MVMint32 result) {
+    read_done((ReadInfo *)req->data, result);
+}
+static void on_fs_read(uv_fs_t *req) {
+    ReadInfo *ri    = (ReadInfo *)req->data;
+    ssize_t   nread = req->result;
+    uv_fs_req_cleanup(req);
+    read_done(ri, nread);
+}
+
+/* Starts reading the next chunk of the file. */
+static void start_read(ReadInfo *ri) {
+    MVMIOAsyncFileData *data   = (MVMIOAsyncFileData *)ri->handle->body.data;
+    MVMIOUring         *ring   = data->loop->uring;
+    MVMint64            offset = data->seekable ? (MVMint64)data->read_offset : -1;
+    data->in_flight++;
+    ri->in_flight = 1;
+    ri->buf_index = -1;
+    if (ring) {
+        ri->buf.base = MVM_io_uring_take_buffer(ring, &(ri->buf_index));
+        ri->buf.len  = MVM_IO_READ_BUFFER_SIZE;
+        if (!ri->buf.base)
+            MVM_io_eventloop_take_read_buffer(data->loop->loop, &(ri->buf));
+        ri->ureq.done = on_uring_read;
+        ri->ureq.data = ri;
+        MVM_io_uring_read(ring, &(ri->ureq), data->fd, file_slot(data),
+            ri->buf.base, ri->buf_index, (MVMuint32)ri->buf.len, (MVMuint64)offset);
+    }
+    else {
+        int r;
+        MVM_io_eventloop_take_read_buffer(data->loop->loop, &(ri->buf));
+        ri->req.data = ri;
+        if ((r = uv_fs_read(data->loop->loop, &(ri->req), data->fd, &(ri->buf), 1,
+                offset, on_fs_read)) < 0)
+            read_done(ri, r);
+    }
+}
+
+/* Gives back the buffer of a read that isn't being handed on. */
+static void release_read_buffer(ReadInfo *ri) {
+    MVMIOAsyncFileData *data = (MVMIOAsyncFileData *)ri->handle->body.data;
+    if (ri->buf_index >= 0)
+        MVM_io_uring_release_buffer(data->loop->uring, ri->buf_index);
+    else
+        MVM_io_eventloop_release_read_buffer(data->loop->loop, &(ri->buf));
+    ri->buf.base  = NULL;
+    ri->buf_index = -1;
+}
+
+/* Sends the notification that there's nothing more to read. */
+static void push_done(MVMThreadContext *tc, MVMAsyncTask *t, ReadInfo *ri) {
+    MVMROOT(tc, t, {
+        MVMObject *arr = MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTArray);
+        MVM_repr_push_o(tc, arr, t->body.schedulee);
+        MVMROOT(tc, arr, {
+            MVMObject *final = MVM_repr_box_int(tc,
+                tc->instance->boot_types.BOOTInt, ri->seq_number);
+            MVM_repr_push_o(tc, arr, final);
+        });
+        MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTStr);
+        MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTStr);
+        MVM_repr_push_o(tc, t->body.queue, arr);
+    });
+}
+
+/* Handles a completed read, passing on what was read and starting the
+ * next one, or notifying that we hit the end or an error. */
+static void read_done(ReadInfo *ri, ssize_t nread) {
+    MVMThreadContext   *tc   = ri->tc;
+    MVMIOAsyncFileData *data = (MVMIOAsyncFileData *)ri->handle->body.data;
+    MVMAsyncTask       *t;
+    MVMObject          *arr;
+
+    ri->in_flight = 0;
+    if (ri->cancelled) {
+        release_read_buffer(ri);
+        MVM_io_eventloop_remove_active_work(tc, &(ri->work_idx));
+        request_done(data);
+        return;
+    }
+
+    t = MVM_io_eventloop_get_active_work(tc, ri->work_idx);
+    if (nread > 0) {
+        MVMROOT(tc, t, {
+            arr = MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTArray);
+            MVM_repr_push_o(tc, arr, t->body.schedulee);
+            MVMROOT(tc, arr, {
+                MVMObject *res_buf;
+
+                /* Push the sequence number. */
+                MVMObject *seq_boxed = MVM_repr_box_int(tc,
+                    tc->instance->boot_types.BOOTInt, ri->seq_number++);
+                MVM_repr_push_o(tc, arr, seq_boxed);
+
+                /* Produce a buffer and push it; a registered buffer has to
+                 * be copied out of, since it stays with the ring. */
+                if (ri->buf_index >= 0) {
+                    res_buf = MVM_io_eventloop_copy_read_result(tc, ri->buf_type,
+                        ri->buf.base, nread);
+                    release_read_buffer(ri);
+                }
+                else {
+                    res_buf = MVM_io_eventloop_read_buffer_result(tc, data->loop->loop,
+                        ri->buf_type, &(ri->buf), nread);
+                }
+                MVM_repr_push_o(tc, arr, res_buf);
+
+                /* Finally, no error. */
+                MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTStr);
+            });
+            MVM_repr_push_o(tc, t->body.queue, arr);
+
+            /* Carry on, unless the handle is being closed. */
+            data->read_offset += nread;
+            if (data->closing) {
+                push_done(tc, t, ri);
+                MVM_io_eventloop_remove_active_work(tc, &(ri->work_idx));
+            }
+            else {
+                start_read(ri);
+            }
+        });
+    }
+    else {
+        release_read_buffer(ri);
+        if (nread == 0) {
+            push_done(tc, t, ri);
+        }
+        else {
+            MVMROOT(tc, t, {
+                arr = MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTArray);
+                MVM_repr_push_o(tc, arr, t->body.schedulee);
+                MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTInt);
+                MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTStr);
+                push_error(tc, t, arr, uv_strerror(nread));
+                MVM_repr_push_o(tc, t->body.queue, arr);
+            });
+        }
+        MVM_io_eventloop_remove_active_work(tc, &(ri->work_idx));
+    }
+    request_done(data);
+}
+
+/* Does setup work for asynchronous reads. */
+static void read_setup(MVMThreadContext *tc, uv_loop_t *loop, MVMObject *async_task, void *data) {
+    ReadInfo           *ri          = (ReadInfo *)data;
+    MVMIOAsyncFileData *handle_data = (MVMIOAsyncFileData *)ri->handle->body.data;
+
+    /* If closed, immediately send done. */
+    if (handle_data->closing) {
+        push_done(tc, (MVMAsyncTask *)async_task, ri);
+        return;
+    }
+
+    /* Add to work in progress, and start reading. */
+    ri->tc       = tc;
+    ri->work_idx = MVM_io_eventloop_add_active_work(tc, async_task);
+    start_read(ri);
+}
+
+/* Stops reading. A read in flight can't be taken back, so if there is one
+ * we keep hold of the task until it completes. */
+static void read_cancel(MVMThreadContext *tc, uv_loop_t *loop, MVMObject *async_task, void *data) {
+    ReadInfo *ri = (ReadInfo *)data;
+    if (ri->work_idx >= 0) {
+        if (ri->in_flight)
+            ri->cancelled = 1;
+        else
+            MVM_io_eventloop_remove_active_work(tc, &(ri->work_idx));
+    }
+}
+
+/* Marks objects for a read task. */
+static void read_gc_mark(MVMThreadContext *tc, void *data, MVMGCWorklist *worklist) {
+    ReadInfo *ri = (ReadInfo *)data;
+    MVM_gc_worklist_add(tc, worklist, &ri->buf_type);
+    MVM_gc_worklist_add(tc, worklist, &ri->handle);
+}
+
+/* Frees info for a read task. */
+static void read_gc_free(MVMThreadContext *tc, MVMObject *t, void *data) {
+    if (data)
+        MVM_free(data);
+}
+
+/* Operations table for async read task. */
+static const MVMAsyncTaskOps read_op_table = {
+    read_setup,
+    NULL,
+    read_cancel,
+    read_gc_mark,
+    read_gc_free
+};
+
+static MVMAsyncTask * read_bytes(MVMThreadContext *tc, MVMOSHandle *h, MVMObject *queue,
+                                 MVMObject *schedulee, MVMObject *buf_type, MVMObject *async_type) {
+    MVMAsyncTask *task;
+    ReadInfo    *ri;
+
+    /* Validate REPRs. */
+    if (REPR(queue)->ID != MVM_REPR_ID_ConcBlockingQueue)
+        MVM_exception_throw_adhoc(tc,
+            "asyncreadbytes target queue must have ConcBlockingQueue REPR (got %s)",
+             MVM_6model_get_stable_debug_name(tc, queue->st));
+    if (REPR(async_type)->ID != MVM_REPR_ID_MVMAsyncTask)
+        MVM_exception_throw_adhoc(tc,
+            "asyncreadbytes result type must have REPR AsyncTask");
+    if (REPR(buf_type)->ID == MVM_REPR_ID_VMArray) {
+        MVMint32 slot_type = ((MVMArrayREPRData *)STABLE(buf_type)->REPR_data)->slot_type;
+        if (slot_type != MVM_ARRAY_U8 && slot_type != MVM_ARRAY_I8)
+            MVM_exception_throw_adhoc(tc, "asyncreadbytes buffer type must be an array of uint8 or int8");
+    }
+    else {
+        MVM_exception_throw_adhoc(tc, "asyncreadbytes buffer type must be an array");
+    }
+
+    /* Create async task handle. */
+    MVMROOT4(tc, queue, schedulee, h, buf_type, {
+        task = (MVMAsyncTask *)MVM_repr_alloc_init(tc, async_type);
+    });
+    MVM_ASSIGN_REF(tc, &(task->common.header), task->body.queue, queue);
+    MVM_ASSIGN_REF(tc, &(task->common.header), task->body.schedulee, schedulee);
+    task->body.ops  = &read_op_table;
+    task->body.loop = ((MVMIOAsyncFileData *)h->body.data)->loop;
+    ri              = MVM_calloc(1, sizeof(ReadInfo));
+    ri->buf_index   = -1;
+    MVM_ASSIGN_REF(tc, &(task->common.header), ri->buf_type, buf_type);
+    MVM_ASSIGN_REF(tc, &(task->common.header), ri->handle, h);
+    task->body.data = ri;
+
+    /* Hand the task off to the event loop. */
+    MVMROOT(tc, task, {
+        MVM_io_eventloop_queue_work(tc, (MVMObject *)task);
+    });
+
+    return task;
+}
+
+/* Info we convey about a write task. */
+typedef struct {
+    MVMOSHandle      *handle;
+    MVMObject        *buf_data;
+    MVMThreadContext *tc;
+    int               work_idx;
+
+    /* The request in flight, the data to write, how much of it has been
+     * written so far, and where in the file it goes. */
+    MVMIOUringRequest ureq;
+    uv_fs_t           req;
+    uv_buf_t          buf;
+    size_t            written;
+    MVMuint64         offset;
+} WriteInfo;
+
+static void write_done(WriteInfo *wi, ssize_t result);
+static void on_uring_write(MVMIOUringRequest *req, MVMint32 result) {
+    write_done((WriteInfo *)req->data, result);
+}
+static void on_fs_write(uv_fs_t *req) {
+    WriteInfo *wi     = (WriteInfo *)req->data;
+    ssize_t    result = req->result;
+    uv_fs_req_cleanup(req);
+    write_done(wi, result);
+}
+
+/* Starts writing whatever is left to write. */
+static void start_write(WriteInfo *wi) {
+    MVMIOAsyncFileData *data   = (MVMIOAsyncFileData *)wi->handle->body.data;
+    MVMIOUring         *ring   = data->loop->uring;
+    uv_buf_t            chunk  = uv_buf_init(wi->buf.base + wi->written,
+                                             (unsigned int)(wi->buf.len - wi->written));
+    MVMint64            offset = data->seekable ? (MVMint64)(wi->offset + wi->written) : -1;
+    data->in_flight++;
+    if (ring) {
+        wi->ureq.done = on_uring_write;
+        wi->ureq.data = wi;
+        MVM_io_uring_write(ring, &(wi->ureq), data->fd, file_slot(data),
+            chunk.base, (MVMuint32)chunk.len, (MVMuint64)offset);
+    }
+    else {
+        int r;
+        wi->req.data = wi;
+        if ((r = uv_fs_write(data->loop->loop, &(wi->req), data->fd, &chunk, 1,
+                offset, on_fs_write)) < 0)
+            write_done(wi, r);
+    }
+}
+
+/* Handles a completed write, carrying on if it was short and otherwise
+ * notifying how it went. */
+static void write_done(WriteInfo *wi, ssize_t result) {
+    MVMThreadContext   *tc   = wi->tc;
+    MVMIOAsyncFileData *data = (MVMIOAsyncFileData *)wi->handle->body.data;
+    MVMAsyncTask       *t;
+    MVMObject          *arr;
+
+    if (result > 0) {
+        wi->written += result;
+        if (wi->written < wi->buf.len) {
+            start_write(wi);
+            request_done(data);
+            return;
+        }
+    }
+
+    arr = MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTArray);
+    t   = MVM_io_eventloop_get_active_work(tc, wi->work_idx);
+    MVM_repr_push_o(tc, arr, t->body.schedulee);
+    if (result >= 0) {
+        MVMROOT2(tc, arr, t, {
+            MVMObject *bytes_box = MVM_repr_box_int(tc,
+                tc->instance->boot_types.BOOTInt, wi->written);
+            MVM_repr_push_o(tc, arr, bytes_box);
+        });
+        MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTStr);
+    }
+    else {
+        MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTInt);
+        push_error(tc, t, arr, uv_strerror(result));
+    }
+    MVM_repr_push_o(tc, t->body.queue, arr);
+    MVM_io_eventloop_remove_active_work(tc, &(wi->work_idx));
+    request_done(data);
+}
+
+/* Does setup work for an asynchronous write. */
+static void write_setup(MVMThreadContext *tc, uv_loop_t *loop, MVMObject *async_task, void *data) {
+    WriteInfo          *wi          = (WriteInfo *)data;
+    MVMIOAsyncFileData *handle_data = (MVMIOAsyncFileData *)wi->handle->body.data;
+    MVMArray           *buffer;
+
+    /* Ensure not closed. */
+    if (handle_data->closing) {
+        MVMROOT(tc, async_task, {
+            MVMObject    *arr = MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTArray);
+            MVMAsyncTask *t   = (MVMAsyncTask *)async_task;
+            MVM_repr_push_o(tc, arr, t->body.schedulee);
+            MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTInt);
+            push_error(tc, t, arr, "Cannot write to a closed file");
+            MVM_repr_push_o(tc, t->body.queue, arr);
+        });
+        return;
+    }
+
+    /* Add to work in progress. */
+    wi->tc       = tc;
+    wi->work_idx = MVM_io_eventloop_add_active_work(tc, async_task);
+
+    /* Claim the part of the file the data will go in, so that writes made
+     * one after the other end up in that order, and start writing. */
+    buffer     = (MVMArray *)wi->buf_data;
+    wi->buf    = uv_buf_init((char *)(buffer->body.slots.i8 + buffer->body.start),
+                             (unsigned int)buffer->body.elems);
+    wi->offset = handle_data->write_offset;
+    handle_data->write_offset += wi->buf.len;
+    start_write(wi);
+}
+
+/* Marks objects for a write task. */
+static void write_gc_mark(MVMThreadContext *tc, void *data, MVMGCWorklist *worklist) {
+    WriteInfo *wi = (WriteInfo *)data;
+    MVM_gc_worklist_add(tc, worklist, &wi->handle);
+    MVM_gc_worklist_add(tc, worklist, &wi->buf_data);
+}
+
+/* Frees info for a write task. */
+static void write_gc_free(MVMThreadContext *tc, MVMObject *t, void *data) {
+    if (data)
+        MVM_free(data);
+}
+
+/* Operations table for async write task. */
+static const MVMAsyncTaskOps write_op_table = {
+    write_setup,
+    NULL,
+    NULL,
+    write_gc_mark,
+    write_gc_free
+};
+
+static MVMAsyncTask * write_bytes(MVMThreadContext *tc, MVMOSHandle *h, MVMObject *queue,
+                                  MVMObject *schedulee, MVMObject *buffer, MVMObject *async_type) {
+    MVMAsyncTask *task;
+    WriteInfo    *wi;
+
+    /* Validate REPRs. */
+    if (REPR(queue)->ID != MVM_REPR_ID_ConcBlockingQueue)
+        MVM_exception_throw_adhoc(tc,
+            "asyncwritebytes target queue must have ConcBlockingQueue REPR");
+    if (REPR(async_type)->ID != MVM_REPR_ID_MVMAsyncTask)
+        MVM_exception_throw_adhoc(tc,
+            "asyncwritebytes result type must have REPR AsyncTask");
+    if (!IS_CONCRETE(buffer) || REPR(buffer)->ID != MVM_REPR_ID_VMArray)
+        MVM_exception_throw_adhoc(tc, "asyncwritebytes requires a native array to read from");
+    if (((MVMArrayREPRData *)STABLE(buffer)->REPR_data)->slot_type != MVM_ARRAY_U8
+        && ((MVMArrayREPRData *)STABLE(buffer)->REPR_data)->slot_type != MVM_ARRAY_I8)
+        MVM_exception_throw_adhoc(tc, "asyncwritebytes requires a native array of uint8 or int8");
+
+    /* Create async task handle. */
+    MVMROOT4(tc, queue, schedulee, h, buffer, {
+        task = (MVMAsyncTask *)MVM_repr_alloc_init(tc, async_type);
+    });
+    MVM_ASSIGN_REF(tc, &(task->common.header), task->body.queue, queue);
+    MVM_ASSIGN_REF(tc, &(task->common.header), task->body.schedulee, schedulee);
+    task->body.ops  = &write_op_table;
+    task->body.loop = ((MVMIOAsyncFileData *)h->body.data)->loop;
+    wi              = MVM_calloc(1, sizeof(WriteInfo));
+    MVM_ASSIGN_REF(tc, &(task->common.header), wi->handle, h);
+    MVM_ASSIGN_REF(tc, &(task->common.header), wi->buf_data, buffer);
+    task->body.data = wi;
+
+    /* Hand the task off to the event loop. */
+    MVMROOT(tc, task, {
+        MVM_io_eventloop_queue_work(tc, (MVMObject *)task);
+    });
+
+    return task;
+}
+
+/* Info we convey about a file close task. */
+typedef struct {
+    MVMOSHandle *handle;
+} CloseInfo;
+
+/* Does an asynchronous close, so that it's ordered with the reads and
+ * writes; the file is closed once any in flight are done. */
+static void close_perform(MVMThreadContext *tc, uv_loop_t *loop, MVMObject *async_task, void *data) {
+    CloseInfo          *ci          = (CloseInfo *)data;
+    MVMIOAsyncFileData *handle_data = (MVMIOAsyncFileData *)ci->handle->body.data;
+    if (!handle_data->closing) {
+        handle_data->closing = 1;
+        if (handle_data->in_flight == 0)
+            close_fd(handle_data);
+    }
+}
+
+/* Marks objects for a close task. */
+static void close_gc_mark(MVMThreadContext *tc, void *data, MVMGCWorklist *worklist) {
+    CloseInfo *ci = (CloseInfo *)data;
+    MVM_gc_worklist_add(tc, worklist, &ci->handle);
+}
+
+/* Frees info for a close task. */
+static void close_gc_free(MVMThreadContext *tc, MVMObject *t, void *data) {
+    if (data)
+        MVM_free(data);
+}
+
+/* Operations table for async close task. */
+static const MVMAsyncTaskOps close_op_table = {
+    close_perform,
+    NULL,
+    NULL,
+    close_gc_mark,
+    close_gc_free
+};
+
+static MVMint64 close_file(MVMThreadContext *tc, MVMOSHandle *h) {
+    MVMAsyncTask *task;
+    CloseInfo *ci;
+
+    MVMROOT(tc, h, {
+        task = (MVMAsyncTask *)MVM_repr_alloc_init(tc,
+            tc->instance->boot_types.BOOTAsync);
+    });
+    task->body.ops  = &close_op_table;
+    task->body.loop = ((MVMIOAsyncFileData *)h->body.data)->loop;
+    ci = MVM_calloc(1, sizeof(CloseInfo));
+    MVM_ASSIGN_REF(tc, &(task->common.header), ci->handle, h);
+    task->body.data = ci;
+    MVM_io_eventloop_queue_work(tc, (MVMObject *)task);
+
+    return 0;
+}
+
+static MVMint64 file_is_tty(MVMThreadContext *tc, MVMOSHandle *h) {
+    return 0;
+}
+
+static MVMint64 file_handle(MVMThreadContext *tc, MVMOSHandle *h) {
+    return (MVMint64)((MVMIOAsyncFileData *)h->body.data)->fd;
+}
+
+/* Frees the handle's data. As with synchronous file handles, a file that
+ * was never closed is left open, but it does give up its registered file
+ * slot. */
+static void gc_free(MVMThreadContext *tc, MVMObject *h, void *d) {
+    MVMIOAsyncFileData *data = (MVMIOAsyncFileData *)d;
+    if (data) {
+        if (!data->closed && data->slot >= 0 && data->slot_ring == data->loop->uring)
+            MVM_io_uring_unregister_file(data->slot_ring, data->slot);
+        MVM_free(data);
+    }
+}
+
+/* IO ops table, populated with functions. */
+static const MVMIOClosable      closable       = { close_file };
+static const MVMIOAsyncReadable async_readable = { read_bytes, NULL };
+static const MVMIOAsyncWritable async_writable = { write_bytes, NULL, NULL };
+static const MVMIOIntrospection introspection  = { file_is_tty,
+                                                   file_handle };
+static const MVMIOOps op_table = {
+    &closable,
+    NULL,
+    NULL,
+    &async_readable,
+    &async_writable,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    NULL,
+    &introspection,
+    NULL,
+    NULL,
+    gc_free
+};
+
+/* Opens a file, returning an asynchronous file handle. */
+MVMObject * MVM_file_open_async(MVMThreadContext *tc, MVMString *filename, MVMString *mode) {
+    int flag;
+    int fd = MVM_file_open_fd(tc, filename, mode, &flag);
+    MVMIOAsyncFileData * const data   = MVM_calloc(1, sizeof(MVMIOAsyncFileData));
+    MVMOSHandle        * const result = (MVMOSHandle *)MVM_repr_alloc_init(tc,
+        tc->instance->boot_types.BOOTIO);
+    data->fd       = fd;
+    data->seekable = MVM_platform_is_fd_seekable(fd);
+    data->loop     = MVM_io_eventloop_pick(tc);
+    data->slot     = -1;
+    if (data->seekable && (flag & O_APPEND))
+        data->write_offset = MVM_platform_lseek(fd, 0, SEEK_END);
+    result->body.ops  = &op_table;
+    result->body.data = data;
+    return (MVMObject *)result;
+}
@@ -0,0 +1 @@
+MVMObject * MVM_file_open_async(MVMThreadContext *tc, MVMString *filename, MVMString *mode);
@@ -1,9 +1,14 @@
 #include "moar.h"
+#include "platform/io.h"
 
 /* Data that we keep for an asynchronous socket handle. */
 typedef struct {
     /* The libuv handle to the socket. */
     uv_stream_t *handle;
+
+    /* The event loop the handle was created on, which any task using it
+     * must run on too. */
+    MVMEventLoop *loop;
 } MVMIOAsyncSocketData;
 
 /* Info we convey about a read task. */
@@ -15,13 +20,6 @@ typedef struct {
     int               work_idx;
 } ReadInfo;
 
-/* Allocates a buffer of the suggested size. */
-static void on_alloc(uv_handle_t *handle, size_t suggested_size, uv_buf_t *buf) {
-    size_t size = suggested_size > 0 ? suggested_size : 4;
-    buf->base   = MVM_malloc(size);
-    buf->len    = size;
-}
-
 /* Callback used to simply free memory on close. */
 static void free_on_close_cb(uv_handle_t *handle) {
     MVM_free(handle);
@@ -36,7 +34,7 @@ static void on_read(uv_stream_t *handle, ssize_t nread, const uv_buf_t *buf) {
     MVM_repr_push_o(tc, arr, t->body.schedulee);
     if (nread >= 0) {
         MVMROOT2(tc, t, arr, {
-            MVMArray *res_buf;
+            MVMObject *res_buf;
 
             /* Push the sequence number. */
             MVMObject *seq_boxed = MVM_repr_box_int(tc,
@@ -44,12 +42,9 @@ static void on_read(uv_stream_t *handle, ssize_t nread, const uv_buf_t *buf) {
             MVM_repr_push_o(tc, arr, seq_boxed);
 
             /* Produce a buffer and push it. */
-            res_buf      = (MVMArray *)MVM_repr_alloc_init(tc, ri->buf_type);
-            res_buf->body.slots.i8 = (MVMint8 *)buf->base;
-            res_buf->body.start    = 0;
-            res_buf->body.ssize    = buf->len;
-            res_buf->body.elems    = nread;
-            MVM_repr_push_o(tc, arr, (MVMObject *)res_buf);
+            res_buf = MVM_io_eventloop_read_buffer_result(tc, handle->loop,
+                ri->buf_type, buf, nread);
+            MVM_repr_push_o(tc, arr, res_buf);
 
             /* Finally, no error. */
             MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTStr);
@@ -78,8 +73,7 @@ static void on_read(uv_stream_t *handle, ssize_t nread, const uv_buf_t *buf) {
                 MVM_repr_push_o(tc, arr, msg_box);
             });
         }
-        if (buf->base)
-            MVM_free(buf->base);
+        MVM_io_eventloop_release_read_buffer(handle->loop, buf);
         MVM_io_eventloop_remove_active_work(tc, &(ri->work_idx));
         if (conn_handle && !uv_is_closing(conn_handle)) {
             handle_data->handle = NULL;
@@ -122,7 +116,7 @@ static void read_setup(MVMThreadContext *tc, uv_loop_t *loop, MVMObject *async_t
 
     /* Start reading the stream. */
     handle_data->handle->data = data;
-    if ((r = uv_read_start(handle_data->handle, on_alloc, on_read)) < 0) {
+    if ((r = uv_read_start(handle_data->handle, MVM_io_eventloop_alloc_read_buffer, on_read)) < 0) {
         /* Error; need to notify. */
         MVMROOT(tc, async_task, {
             MVMObject    *arr = MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTArray);
@@ -205,6 +199,7 @@ static MVMAsyncTask * read_bytes(MVMThreadContext *tc, MVMOSHandle *h, MVMObject
     MVM_ASSIGN_REF(tc, &(task->common.header), task->body.queue, queue);
     MVM_ASSIGN_REF(tc, &(task->common.header), task->body.schedulee, schedulee);
     task->body.ops  = &read_op_table;
+    task->body.loop = ((MVMIOAsyncSocketData *)h->body.data)->loop;
     ri              = MVM_calloc(1, sizeof(ReadInfo));
     MVM_ASSIGN_REF(tc, &(task->common.header), ri->buf_type, buf_type);
     MVM_ASSIGN_REF(tc, &(task->common.header), ri->handle, h);
@@ -218,12 +213,18 @@ static MVMAsyncTask * read_bytes(MVMThreadContext *tc, MVMOSHandle *h, MVMObject
     return task;
 }
 
-/* Info we convey about a write task. */
+/* Info we convey about a write task. The data is either a single buffer,
+ * or a list of them that are all written by the one request. A list is
+ * copied when the write is queued, since the caller may go on changing it
+ * while the loop thread is setting the write up. */
 typedef struct {
     MVMOSHandle      *handle;
     MVMObject        *buf_data;
+    MVMObject       **buffers;
+    MVMuint32         num_buffers;
+    MVMuint8          is_list;
     uv_write_t       *req;
-    uv_buf_t          buf;
+    size_t            bytes;
     MVMThreadContext *tc;
     int               work_idx;
 } WriteInfo;
@@ -239,7 +240,7 @@ static void on_write(uv_write_t *req, int status) {
         MVMROOT2(tc, arr, t, {
             MVMObject *bytes_box = MVM_repr_box_int(tc,
                 tc->instance->boot_types.BOOTInt,
-                wi->buf.len);
+                wi->bytes);
             MVM_repr_push_o(tc, arr, bytes_box);
         });
         MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTStr);
@@ -262,10 +263,11 @@ static void on_write(uv_write_t *req, int status) {
 /* Does setup work for an asynchronous write. */
 static void write_setup(MVMThreadContext *tc, uv_loop_t *loop, MVMObject *async_task, void *data) {
     MVMIOAsyncSocketData *handle_data;
-    MVMArray             *buffer;
     WriteInfo            *wi;
-    char                 *output;
-    int                   output_size, r;
+    uv_buf_t              buf;
+    uv_buf_t             *bufs;
+    unsigned int          nbufs;
+    int                   r;
 
     /* Ensure not closed. */
     wi = (WriteInfo *)data;
@@ -292,17 +294,37 @@ static void write_setup(MVMThreadContext *tc, uv_loop_t *loop, MVMObject *async_
     wi->tc = tc;
     wi->work_idx = MVM_io_eventloop_add_active_work(tc, async_task);
 
-    /* Extract buf data. */
-    buffer = (MVMArray *)wi->buf_data;
-    output = (char *)(buffer->body.slots.i8 + buffer->body.start);
-    output_size = (int)buffer->body.elems;
+    /* Extract buf data. libuv takes a copy of the array of buffers, so it
+     * need only live until the request is made. */
+    if (wi->is_list) {
+        unsigned int i;
+        nbufs     = wi->num_buffers;
+        bufs      = MVM_malloc((nbufs ? nbufs : 1) * sizeof(uv_buf_t));
+        wi->bytes = 0;
+        for (i = 0; i < nbufs; i++) {
+            MVMArray *buffer = (MVMArray *)wi->buffers[i];
+            bufs[i]    = uv_buf_init((char *)(buffer->body.slots.i8 + buffer->body.start),
+                                     (unsigned int)buffer->body.elems);
+            wi->bytes += bufs[i].len;
+        }
+    }
+    else {
+        MVMArray *buffer = (MVMArray *)wi->buf_data;
+        buf       = uv_buf_init((char *)(buffer->body.slots.i8 + buffer->body.start),
+                                (unsigned int)buffer->body.elems);
+        bufs      = &buf;
+        nbufs     = 1;
+        wi->bytes = buf.len;
+    }
 
     /* Create and initialize write request. */
     wi->req           = MVM_malloc(sizeof(uv_write_t));
-    wi->buf           = uv_buf_init(output, output_size);
     wi->req->data     = data;
 
-    if ((r = uv_write(wi->req, handle_data->handle, &(wi->buf), 1, on_write)) < 0) {
+    r = uv_write(wi->req, handle_data->handle, bufs, nbufs, on_write);
+    if (bufs != &buf)
+        MVM_free(bufs);
+    if (r < 0) {
         /* Error; need to notify. */
         MVMROOT(tc, async_task, {
             MVMObject    *arr = MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTArray);
@@ -329,14 +351,20 @@ static void write_setup(MVMThreadContext *tc, uv_loop_t *loop, MVMObject *async_
 /* Marks objects for a write task. */
 static void write_gc_mark(MVMThreadContext *tc, void *data, MVMGCWorklist *worklist) {
     WriteInfo *wi = (WriteInfo *)data;
+    MVMuint32  i;
     MVM_gc_worklist_add(tc, worklist, &wi->handle);
     MVM_gc_worklist_add(tc, worklist, &wi->buf_data);
+    for (i = 0; i < wi->num_buffers; i++)
+        MVM_gc_worklist_add(tc, worklist, &wi->buffers[i]);
 }
 
 /* Frees info for a write task. */
 static void write_gc_free(MVMThreadContext *tc, MVMObject *t, void *data) {
-    if (data)
-        MVM_free(data);
+    if (data) {
+        WriteInfo *wi = (WriteInfo *)data;
+        MVM_free(wi->buffers);
+        MVM_free(wi);
+    }
 }
 
 /* Operations table for async write task. */
@@ -348,11 +376,51 @@ static const MVMAsyncTaskOps write_op_table = {
     write_gc_free
 };
 
-static MVMAsyncTask * write_bytes(MVMThreadContext *tc, MVMOSHandle *h, MVMObject *queue,
-                                  MVMObject *schedulee, MVMObject *buffer, MVMObject *async_type) {
+static MVMAsyncTask * queue_write(MVMThreadContext *tc, MVMOSHandle *h, MVMObject *queue,
+        MVMObject *schedulee, MVMObject *buffer, MVMObject *async_type, MVMuint8 is_list) {
     MVMAsyncTask *task;
     WriteInfo    *wi;
 
+    /* Create async task handle. */
+    MVMROOT4(tc, queue, schedulee, h, buffer, {
+        task = (MVMAsyncTask *)MVM_repr_alloc_init(tc, async_type);
+    });
+    MVM_ASSIGN_REF(tc, &(task->common.header), task->body.queue, queue);
+    MVM_ASSIGN_REF(tc, &(task->common.header), task->body.schedulee, schedulee);
+    task->body.ops  = &write_op_table;
+    task->body.loop = ((MVMIOAsyncSocketData *)h->body.data)->loop;
+    wi              = MVM_calloc(1, sizeof(WriteInfo));
+    wi->is_list     = is_list;
+    MVM_ASSIGN_REF(tc, &(task->common.header), wi->handle, h);
+    task->body.data = wi;
+
+    /* Take the buffers out of a list now, checking them again as we go; if
+     * one has been swapped for something else, we throw here, before the
+     * task has been handed to the loop. */
+    if (is_list) {
+        MVMuint32 num = (MVMuint32)MVM_repr_elems(tc, buffer);
+        MVMuint32 i;
+        wi->buffers = MVM_malloc((num ? num : 1) * sizeof(MVMObject *));
+        for (i = 0; i < num; i++) {
+            MVMObject *b = MVM_io_buffer_list_get(tc, buffer, i, "asyncwritevbytes");
+            MVM_ASSIGN_REF(tc, &(task->common.header), wi->buffers[i], b);
+            wi->num_buffers++;
+        }
+    }
+    else {
+        MVM_ASSIGN_REF(tc, &(task->common.header), wi->buf_data, buffer);
+    }
+
+    /* Hand the task off to the event loop. */
+    MVMROOT(tc, task, {
+        MVM_io_eventloop_queue_work(tc, (MVMObject *)task);
+    });
+
+    return task;
+}
+
+static MVMAsyncTask * write_bytes(MVMThreadContext *tc, MVMOSHandle *h, MVMObject *queue,
+                                  MVMObject *schedulee, MVMObject *buffer, MVMObject *async_type) {
     /* Validate REPRs. */
     if (REPR(queue)->ID != MVM_REPR_ID_ConcBlockingQueue)
         MVM_exception_throw_adhoc(tc,
@@ -366,17 +434,237 @@ static MVMAsyncTask * write_bytes(MVMThreadContext *tc, MVMOSHandle *h, MVMObjec
         && ((MVMArrayREPRData *)STABLE(buffer)->REPR_data)->slot_type != MVM_ARRAY_I8)
         MVM_exception_throw_adhoc(tc, "asyncwritebytes requires a native array of uint8 or int8");
 
+    return queue_write(tc, h, queue, schedulee, buffer, async_type, 0);
+}
+
+/* Writes a list of buffers with a single request; they have already been
+ * checked to all be byte arrays. */
+static MVMAsyncTask * write_bytes_vec(MVMThreadContext *tc, MVMOSHandle *h, MVMObject *queue,
+                                      MVMObject *schedulee, MVMObject *buffers, MVMObject *async_type) {
+    /* Validate REPRs. */
+    if (REPR(queue)->ID != MVM_REPR_ID_ConcBlockingQueue)
+        MVM_exception_throw_adhoc(tc,
+            "asyncwritevbytes target queue must have ConcBlockingQueue REPR");
+    if (REPR(async_type)->ID != MVM_REPR_ID_MVMAsyncTask)
+        MVM_exception_throw_adhoc(tc,
+            "asyncwritevbytes result type must have REPR AsyncTask");
+
+    return queue_write(tc, h, queue, schedulee, buffers, async_type, 1);
+}
+
+/* Info we convey about a transfer task, which writes bytes taken from the
+ * descriptor of another handle to the socket. */
+typedef struct {
+    MVMOSHandle      *handle;
+    MVMOSHandle      *source;
+    int               in_fd;
+    int               out_fd;
+    int               method;
+    MVMint64          remaining;
+    MVMint64          bytes;
+    size_t            pending;
+    uv_loop_t        *loop;
+    uv_buf_t          buf;
+    uv_fs_t           read_req;
+    uv_write_t        write_req;
+    MVMThreadContext *tc;
+    int               work_idx;
+} TransferInfo;
+
+/* How much to ask the kernel to move at once. */
+#define TRANSFER_CHUNK (1 << 20)
+
+/* Reports the outcome of a transfer, and ends it. */
+static void transfer_done(TransferInfo *ti, const char *error) {
+    MVMThreadContext *tc  = ti->tc;
+    MVMObject        *arr = MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTArray);
+    MVMAsyncTask     *t   = MVM_io_eventloop_get_active_work(tc, ti->work_idx);
+    MVM_repr_push_o(tc, arr, t->body.schedulee);
+    if (!error) {
+        MVMROOT2(tc, arr, t, {
+            MVMObject *bytes_box = MVM_repr_box_int(tc,
+                tc->instance->boot_types.BOOTInt, ti->bytes);
+            MVM_repr_push_o(tc, arr, bytes_box);
+        });
+        MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTStr);
+    }
+    else {
+        MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTInt);
+        MVMROOT2(tc, arr, t, {
+            MVMString *msg_str = MVM_string_ascii_decode_nt(tc,
+                tc->instance->VMString, error);
+            MVMObject *msg_box = MVM_repr_box_str(tc,
+                tc->instance->boot_types.BOOTStr, msg_str);
+            MVM_repr_push_o(tc, arr, msg_box);
+        });
+    }
+    MVM_repr_push_o(tc, t->body.queue, arr);
+    MVM_io_eventloop_remove_active_work(tc, &(ti->work_idx));
+}
+
+static void transfer_step(TransferInfo *ti);
+
+/* Once a chunk that went through a buffer is written, carries on. */
+static void on_transfer_write(uv_write_t *req, int status) {
+    TransferInfo *ti = (TransferInfo *)req->data;
+    MVM_io_eventloop_release_read_buffer(ti->loop, &(ti->buf));
+    ti->buf.base = NULL;
+    if (status < 0) {
+        transfer_done(ti, uv_strerror(status));
+        return;
+    }
+    ti->bytes += ti->pending;
+    if (ti->remaining > 0)
+        ti->remaining -= ti->pending;
+    transfer_step(ti);
+}
+
+/* Once a chunk has been read into a buffer, has libuv write it, which
+ * waits for the socket to drain if need be. */
+static void on_transfer_read(uv_fs_t *req) {
+    TransferInfo         *ti          = (TransferInfo *)req->data;
+    MVMIOAsyncSocketData *handle_data = (MVMIOAsyncSocketData *)ti->handle->body.data;
+    ssize_t               nread       = req->result;
+    uv_buf_t              chunk;
+    int                   r;
+    uv_fs_req_cleanup(req);
+    if (nread <= 0 || !handle_data->handle || uv_is_closing((uv_handle_t *)handle_data->handle)) {
+        MVM_io_eventloop_release_read_buffer(ti->loop, &(ti->buf));
+        ti->buf.base = NULL;
+        transfer_done(ti, nread < 0 ? uv_strerror((int)nread)
+            : nread > 0 ? "Cannot write to a closed socket" : NULL);
+        return;
+    }
+    ti->pending = nread;
+    chunk = uv_buf_init(ti->buf.base, (unsigned int)nread);
+    ti->write_req.data = ti;
+    if ((r = uv_write(&(ti->write_req), handle_data->handle, &chunk, 1, on_transfer_write)) < 0) {
+        MVM_io_eventloop_release_read_buffer(ti->loop, &(ti->buf));
+        ti->buf.base = NULL;
+        transfer_done(ti, uv_strerror(r));
+    }
+}
+
+/* Moves as much as the socket will take straight from the source, then,
+ * if there's more to go, reads a chunk to be written through libuv. */
+static void transfer_step(TransferInfo *ti) {
+    MVMIOAsyncSocketData *handle_data = (MVMIOAsyncSocketData *)ti->handle->body.data;
+    uv_stream_t          *stream      = handle_data->handle;
+    uv_buf_t              chunk;
+    int                   r;
+    if (!stream || uv_is_closing((uv_handle_t *)stream)) {
+        transfer_done(ti, "Cannot write to a closed socket");
+        return;
+    }
+
+    /* Anything libuv still has queued must go out before bytes can be put
+     * on the socket behind its back. */
+    while (ti->out_fd >= 0 && ti->remaining != 0 && stream->write_queue_size == 0) {
+        MVMint64 want = ti->remaining < 0 || ti->remaining > TRANSFER_CHUNK
+            ? TRANSFER_CHUNK
+            : ti->remaining;
+        MVMint64 moved = MVM_platform_transfer_chunk(ti->out_fd, ti->in_fd, want, &(ti->method));
+        if (moved > 0) {
+            ti->bytes += moved;
+            if (ti->remaining > 0)
+                ti->remaining -= moved;
+        }
+        else if (moved == 0) {
+            transfer_done(ti, NULL);
+            return;
+        }
+        else if (errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOSYS) {
+            break;
+        }
+        else if (errno != EINTR) {
+            transfer_done(ti, strerror(errno));
+            return;
+        }
+    }
+    if (ti->remaining == 0) {
+        transfer_done(ti, NULL);
+        return;
+    }
+
+    MVM_io_eventloop_take_read_buffer(ti->loop, &(ti->buf));
+    chunk = ti->buf;
+    if (ti->remaining > 0 && (MVMint64)chunk.len > ti->remaining)
+        chunk.len = (size_t)ti->remaining;
+    ti->read_req.data = ti;
+    if ((r = uv_fs_read(ti->loop, &(ti->read_req), ti->in_fd, &chunk, 1, -1, on_transfer_read)) < 0) {
+        MVM_io_eventloop_release_read_buffer(ti->loop, &(ti->buf));
+        ti->buf.base = NULL;
+        transfer_done(ti, uv_strerror(r));
+    }
+}
+
+/* Does setup work for a transfer. */
+static void transfer_setup(MVMThreadContext *tc, uv_loop_t *loop, MVMObject *async_task, void *data) {
+    TransferInfo         *ti          = (TransferInfo *)data;
+    MVMIOAsyncSocketData *handle_data = (MVMIOAsyncSocketData *)ti->handle->body.data;
+    ti->tc       = tc;
+    ti->loop     = loop;
+    ti->work_idx = MVM_io_eventloop_add_active_work(tc, async_task);
+    ti->out_fd   = -1;
+#ifndef _WIN32
+    if (handle_data->handle) {
+        uv_os_fd_t fh;
+        if (uv_fileno((uv_handle_t *)handle_data->handle, &fh) == 0)
+            ti->out_fd = fh;
+    }
+#endif
+    transfer_step(ti);
+}
+
+/* Marks objects for a transfer task. */
+static void transfer_gc_mark(MVMThreadContext *tc, void *data, MVMGCWorklist *worklist) {
+    TransferInfo *ti = (TransferInfo *)data;
+    MVM_gc_worklist_add(tc, worklist, &ti->handle);
+    MVM_gc_worklist_add(tc, worklist, &ti->source);
+}
+
+/* Frees info for a transfer task. */
+static void transfer_gc_free(MVMThreadContext *tc, MVMObject *t, void *data) {
+    if (data)
+        MVM_free(data);
+}
+
+/* Operations table for async transfer task. */
+static const MVMAsyncTaskOps transfer_op_table = {
+    transfer_setup,
+    NULL,
+    NULL,
+    transfer_gc_mark,
+    transfer_gc_free
+};
+
+static MVMAsyncTask * transfer_from(MVMThreadContext *tc, MVMOSHandle *h, MVMObject *queue,
+        MVMObject *schedulee, MVMOSHandle *source, int fd, MVMint64 bytes, MVMObject *async_type) {
+    MVMAsyncTask *task;
+    TransferInfo *ti;
+
+    /* Validate REPRs. */
+    if (REPR(queue)->ID != MVM_REPR_ID_ConcBlockingQueue)
+        MVM_exception_throw_adhoc(tc,
+            "asynctransfer target queue must have ConcBlockingQueue REPR");
+    if (REPR(async_type)->ID != MVM_REPR_ID_MVMAsyncTask)
+        MVM_exception_throw_adhoc(tc,
+            "asynctransfer result type must have REPR AsyncTask");
+
     /* Create async task handle. */
-    MVMROOT4(tc, queue, schedulee, h, buffer, {
+    MVMROOT4(tc, queue, schedulee, h, source, {
         task = (MVMAsyncTask *)MVM_repr_alloc_init(tc, async_type);
     });
     MVM_ASSIGN_REF(tc, &(task->common.header), task->body.queue, queue);
     MVM_ASSIGN_REF(tc, &(task->common.header), task->body.schedulee, schedulee);
-    task->body.ops  = &write_op_table;
-    wi              = MVM_calloc(1, sizeof(WriteInfo));
-    MVM_ASSIGN_REF(tc, &(task->common.header), wi->handle, h);
-    MVM_ASSIGN_REF(tc, &(task->common.header), wi->buf_data, buffer);
-    task->body.data = wi;
+    task->body.ops  = &transfer_op_table;
+    task->body.loop = ((MVMIOAsyncSocketData *)h->body.data)->loop;
+    ti              = MVM_calloc(1, sizeof(TransferInfo));
+    ti->in_fd       = fd;
+    ti->remaining   = bytes;
+    MVM_ASSIGN_REF(tc, &(task->common.header), ti->handle, h);
+    MVM_ASSIGN_REF(tc, &(task->common.header), ti->source, source);
+    task->body.data = ti;
 
     /* Hand the task off to the event loop. */
     MVMROOT(tc, task, {
@@ -431,7 +719,8 @@ static MVMint64 close_socket(MVMThreadContext *tc, MVMOSHandle *h) {
         task = (MVMAsyncTask *)MVM_repr_alloc_init(tc,
             tc->instance->boot_types.BOOTAsync);
     });
-    task->body.ops = &close_op_table;
+    task->body.ops  = &close_op_table;
+    task->body.loop = ((MVMIOAsyncSocketData *)h->body.data)->loop;
     ci = MVM_calloc(1, sizeof(CloseInfo));
     MVM_ASSIGN_REF(tc, &(task->common.header), ci->handle, h);
     task->body.data = ci;
@@ -459,8 +748,9 @@ static MVMint64 socket_handle(MVMThreadContext *tc, MVMOSHandle *h) {
 
 /* IO ops table, populated with functions. */
 static const MVMIOClosable      closable       = { close_socket };
-static const MVMIOAsyncReadable async_readable = { read_bytes };
-static const MVMIOAsyncWritable async_writable = { write_bytes };
+static const MVMIOAsyncReadable async_readable = { read_bytes, NULL };
+static const MVMIOAsyncWritable async_writable = { write_bytes, write_bytes_vec,
+                                                   transfer_from };
 static const MVMIOIntrospection introspection  = { socket_is_tty,
                                                    socket_handle };
 static const MVMIOOps op_table = {
@@ -519,6 +809,12 @@ static void push_name_and_port(MVMThreadContext *tc, struct sockaddr_storage *na
 /* Info we convey about a connection attempt task. */
 typedef struct {
     struct sockaddr  *dest;
+
+    /* If the host name wasn't in the DNS cache, it is resolved on the loop
+     * before connecting. */
+    char             *host;
+    MVMint64          port;
+
     uv_tcp_t         *socket;
     uv_connect_t     *connect;
     MVMThreadContext *tc;
@@ -538,6 +834,7 @@ static void on_connect(uv_connect_t* req, int status) {
             MVMOSHandle          *result = (MVMOSHandle *)MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTIO);
             MVMIOAsyncSocketData *data   = MVM_calloc(1, sizeof(MVMIOAsyncSocketData));
             data->handle                 = (uv_stream_t *)ci->socket;
+            data->loop                   = tc->event_loop;
             result->body.ops             = &op_table;
             result->body.data            = data;
             MVM_repr_push_o(tc, arr, (MVMObject *)result);
@@ -573,56 +870,112 @@ static void on_connect(uv_connect_t* req, int status) {
     MVM_io_eventloop_remove_active_work(tc, &(ci->work_idx));
 }
 
-/* Initilalize the connection on the event loop. */
-static void connect_setup(MVMThreadContext *tc, uv_loop_t *loop, MVMObject *async_task, void *data) {
-    int r;
+/* Reports that the connection couldn't be made. */
+static void connect_failed(ConnectInfo *ci, const char *msg) {
+    MVMThreadContext *tc = ci->tc;
+    MVMAsyncTask     *t  = MVM_io_eventloop_get_active_work(tc, ci->work_idx);
+    MVMROOT(tc, t, {
+        MVMObject *arr = MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTArray);
+        MVM_repr_push_o(tc, arr, t->body.schedulee);
+        MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTIO);
+        MVMROOT(tc, arr, {
+            MVMString *msg_str = MVM_string_utf8_decode(tc,
+                tc->instance->VMString, msg, strlen(msg));
+            MVMObject *msg_box = MVM_repr_box_str(tc,
+                tc->instance->boot_types.BOOTStr, msg_str);
+            MVM_repr_push_o(tc, arr, msg_box);
+            MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTStr);
+            MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTInt);
+            MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTStr);
+            MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTInt);
+        });
+        MVM_repr_push_o(tc, t->body.queue, arr);
+    });
+    MVM_io_eventloop_remove_active_work(tc, &(ci->work_idx));
+}
 
-    /* Add to work in progress. */
-    ConnectInfo *ci = (ConnectInfo *)data;
-    ci->tc        = tc;
-    ci->work_idx  = MVM_io_eventloop_add_active_work(tc, async_task);
+/* Starts connecting, once the address to connect to is known. */
+static void start_connect(ConnectInfo *ci, uv_loop_t *loop) {
+    int r;
 
     /* Create and initialize socket and connection. */
     ci->socket        = MVM_malloc(sizeof(uv_tcp_t));
     ci->connect       = MVM_malloc(sizeof(uv_connect_t));
-    ci->connect->data = data;
+    ci->connect->data = ci;
     if ((r = uv_tcp_init(loop, ci->socket)) < 0 ||
         (r = uv_tcp_connect(ci->connect, ci->socket, ci->dest, on_connect)) < 0) {
-        /* Error; need to notify. */
-        MVMROOT(tc, async_task, {
-            MVMObject    *arr = MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTArray);
-            MVMAsyncTask *t   = (MVMAsyncTask *)async_task;
-            MVM_repr_push_o(tc, arr, t->body.schedulee);
-            MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTIO);
-            MVMROOT(tc, arr, {
-                MVMString *msg_str = MVM_string_ascii_decode_nt(tc,
-                    tc->instance->VMString, uv_strerror(r));
-                MVMObject *msg_box = MVM_repr_box_str(tc,
-                    tc->instance->boot_types.BOOTStr, msg_str);
-                MVM_repr_push_o(tc, arr, msg_box);
-                MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTStr);
-                MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTInt);
-                MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTStr);
-                MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTInt);
-            });
-            MVM_repr_push_o(tc, t->body.queue, arr);
-        });
-
         /* Cleanup handles. */
         MVM_free(ci->connect);
         ci->connect = NULL;
         uv_close((uv_handle_t *)ci->socket, free_on_close_cb);
         ci->socket = NULL;
-        MVM_io_eventloop_remove_active_work(tc, &(ci->work_idx));
+
+        /* Error; need to notify. */
+        connect_failed(ci, uv_strerror(r));
     }
 }
 
+/* Handles the host name having been resolved in the thread pool. */
+static void on_resolved(uv_getaddrinfo_t *req, int status, struct addrinfo *res) {
+    ConnectInfo *ci   = (ConnectInfo *)req->data;
+    uv_loop_t   *loop = req->loop;
+    MVM_free(req);
+
+    if (status == 0 && res) {
+        size_t size = res->ai_addr->sa_family == AF_INET6
+            ? sizeof(struct sockaddr_in6)
+            : sizeof(struct sockaddr_in);
+        ci->dest = MVM_malloc(size);
+        memcpy(ci->dest, res->ai_addr, size);
+        MVM_io_dns_cache_store(ci->tc, ci->host, SOCKET_FAMILY_UNSPEC, ci->dest);
+        uv_freeaddrinfo(res);
+        start_connect(ci, loop);
+    }
+    else {
+        char msg[512];
+        if (res)
+            uv_freeaddrinfo(res);
+        snprintf(msg, sizeof(msg), "Failed to resolve host name '%s'. Error: '%s'",
+            ci->host, status ? uv_strerror(status) : "no address found");
+        connect_failed(ci, msg);
+    }
+}
+
+/* Initilalize the connection on the event loop. */
+static void connect_setup(MVMThreadContext *tc, uv_loop_t *loop, MVMObject *async_task, void *data) {
+    /* Add to work in progress. */
+    ConnectInfo *ci = (ConnectInfo *)data;
+    ci->tc        = tc;
+    ci->work_idx  = MVM_io_eventloop_add_active_work(tc, async_task);
+
+    /* Resolve the host name without blocking the loop if we need to. */
+    if (!ci->dest) {
+        uv_getaddrinfo_t *req = MVM_malloc(sizeof(uv_getaddrinfo_t));
+        struct addrinfo   hints;
+        char              port_cstr[8];
+        int               r;
+        memset(&hints, 0, sizeof(hints));
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_flags  = AI_PASSIVE;
+        snprintf(port_cstr, 8, "%d", (int)ci->port);
+        req->data = ci;
+        if ((r = uv_getaddrinfo(loop, req, on_resolved, ci->host, port_cstr, &hints)) < 0) {
+            MVM_free(req);
+            connect_failed(ci, uv_strerror(r));
+        }
+        return;
+    }
+
+    start_connect(ci, loop);
+}
+
 /* Frees info for a connection task. */
 static void connect_gc_free(MVMThreadContext *tc, MVMObject *t, void *data) {
     if (data) {
         ConnectInfo *ci = (ConnectInfo *)data;
         if (ci->dest)
             MVM_free(ci->dest);
+        MVM_free(ci->host);
         MVM_free(ci);
     }
 }
@@ -643,6 +996,7 @@ MVMObject * MVM_io_socket_connect_async(MVMThreadContext *tc, MVMObject *queue,
     MVMAsyncTask *task;
     ConnectInfo  *ci;
     struct sockaddr *dest;
+    char         *host_cstr;
 
     /* Validate REPRs. */
     if (REPR(queue)->ID != MVM_REPR_ID_ConcBlockingQueue)
@@ -652,10 +1006,13 @@ MVMObject * MVM_io_socket_connect_async(MVMThreadContext *tc, MVMObject *queue,
         MVM_exception_throw_adhoc(tc,
             "asyncconnect result type must have REPR AsyncTask");
 
-    /* Resolve hostname. (Could be done asynchronously too.) */
-    MVMROOT3(tc, queue, schedulee, async_type, {
-        dest = MVM_io_resolve_host_name(tc, host, port, SOCKET_FAMILY_UNSPEC);
-    });
+    /* Use a recently resolved address if there is one; otherwise the name
+     * is resolved on the event loop. */
+    host_cstr = MVM_string_utf8_encode_C_string(tc, host);
+    if ((dest = MVM_io_dns_cache_lookup(tc, host_cstr, port, SOCKET_FAMILY_UNSPEC))) {
+        MVM_free(host_cstr);
+        host_cstr = NULL;
+    }
 
     /* Create async task handle. */
     MVMROOT2(tc, queue, schedulee, {
@@ -666,6 +1023,8 @@ MVMObject * MVM_io_socket_connect_async(MVMThreadContext *tc, MVMObject *queue,
     task->body.ops  = &connect_op_table;
     ci              = MVM_calloc(1, sizeof(ConnectInfo));
     ci->dest        = dest;
+    ci->host        = host_cstr;
+    ci->port        = port;
     task->body.data = ci;
 
     /* Hand the task off to the event loop. */
@@ -683,8 +1042,34 @@ typedef struct {
     MVMThreadContext *tc;
     int               work_idx;
     int               backlog;
+    int               reuse_port;
 } ListenInfo;
 
+/* Lets several listeners bind the same address, with the kernel spreading
+ * incoming connections between them. FreeBSD only balances with
+ * SO_REUSEPORT_LB, and on Linux SO_REUSEPORT does it. Elsewhere, such as on
+ * macOS and the other BSDs, SO_REUSEPORT just lets the last listener bound
+ * take every connection, so we report that it isn't supported. */
+#if defined(SO_REUSEPORT_LB)
+#define MVM_REUSEPORT_BALANCED SO_REUSEPORT_LB
+#elif defined(SO_REUSEPORT) && defined(__linux__)
+#define MVM_REUSEPORT_BALANCED SO_REUSEPORT
+#endif
+static int set_reuse_port(uv_tcp_t *socket) {
+#ifdef MVM_REUSEPORT_BALANCED
+    uv_os_fd_t fd;
+    int        on = 1;
+    int        r;
+    if ((r = uv_fileno((uv_handle_t *)socket, &fd)) < 0)
+        return r;
+    if (setsockopt(fd, SOL_SOCKET, MVM_REUSEPORT_BALANCED, &on, sizeof(on)) < 0)
+        return uv_translate_sys_error(errno);
+    return 0;
+#else
+    return UV_ENOTSUP;
+#endif
+}
+
 
 /* Handles an incoming connection. */
 static void on_connection(uv_stream_t *server, int status) {
@@ -708,6 +1093,7 @@ static void on_connection(uv_stream_t *server, int status) {
                 MVMOSHandle          *result = (MVMOSHandle *)MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTIO);
                 MVMIOAsyncSocketData *data   = MVM_calloc(1, sizeof(MVMIOAsyncSocketData));
                 data->handle                 = (uv_stream_t *)client;
+                data->loop                   = tc->event_loop;
                 result->body.ops             = &op_table;
                 result->body.data            = data;
 
@@ -722,6 +1108,7 @@ static void on_connection(uv_stream_t *server, int status) {
                 MVMOSHandle          *result = (MVMOSHandle *)MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTIO);
                 MVMIOAsyncSocketData *data   = MVM_calloc(1, sizeof(MVMIOAsyncSocketData));
                 data->handle                 = (uv_stream_t *)li->socket;
+                data->loop                   = tc->event_loop;
                 result->body.ops             = &op_table;
                 result->body.data            = data;
 
@@ -764,7 +1151,10 @@ static void listen_setup(MVMThreadContext *tc, uv_loop_t *loop, MVMObject *async
     /* Create and initialize socket and connection, and start listening. */
     li->socket        = MVM_malloc(sizeof(uv_tcp_t));
     li->socket->data  = data;
-    if ((r = uv_tcp_init(loop, li->socket)) < 0 ||
+    if ((r = li->reuse_port
+            ? uv_tcp_init_ex(loop, li->socket, li->dest->sa_family)
+            : uv_tcp_init(loop, li->socket)) < 0 ||
+        (li->reuse_port && (r = set_reuse_port(li->socket)) < 0) ||
         (r = uv_tcp_bind(li->socket, li->dest, 0)) < 0 ||
         (r = uv_listen((uv_stream_t *)li->socket, li->backlog, on_connection))) {
         /* Error; need to notify. */
@@ -811,6 +1201,7 @@ static void listen_setup(MVMThreadContext *tc, uv_loop_t *loop, MVMObject *async
                 MVMOSHandle          *result = (MVMOSHandle *)MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTIO);
                 MVMIOAsyncSocketData *data   = MVM_calloc(1, sizeof(MVMIOAsyncSocketData));
                 data->handle                 = (uv_stream_t *)li->socket;
+                data->loop                   = tc->event_loop;
                 result->body.ops             = &op_table;
                 result->body.data            = data;
 
@@ -899,3 +1290,89 @@ MVMObject * MVM_io_socket_listen_async(MVMThreadContext *tc, MVMObject *queue,
 
     return (MVMObject *)task;
 }
+
+/* Initiates a listener for each of the given queues, all bound to the same
+ * address with SO_REUSEPORT (SO_REUSEPORT_LB on FreeBSD) so that the kernel
+ * shares incoming connections out between them. Each runs on an event loop
+ * of its own where there are enough of them, and delivers the connections
+ * it accepts to its queue, so accepting isn't held up on a single loop.
+ * Where the kernel can't balance connections (anywhere but Linux and
+ * FreeBSD), each listener reports ENOTSUP through its queue. The port must
+ * be given, since with port 0 each listener would get a port of its own.
+ * Gives back a list of the listen tasks, in the order of the queues. */
+MVMObject * MVM_io_socket_listen_sharded_async(MVMThreadContext *tc, MVMObject *queues,
+                                               MVMObject *schedulee, MVMString *host,
+                                               MVMint64 port, MVMint32 backlog, MVMObject *async_type) {
+    MVMInstance     *instance = tc->instance;
+    MVMObject       *result;
+    struct sockaddr *dest;
+    size_t           dest_size;
+    MVMint64         num_shards, i;
+    MVMuint32        first_loop;
+
+    /* Validate REPRs. */
+    if (!IS_CONCRETE(queues) || REPR(queues)->ID != MVM_REPR_ID_VMArray)
+        MVM_exception_throw_adhoc(tc,
+            "asynclistensharded needs a list of queues, one per listener");
+    num_shards = MVM_repr_elems(tc, queues);
+    if (num_shards < 1)
+        MVM_exception_throw_adhoc(tc,
+            "asynclistensharded needs at least one queue");
+    for (i = 0; i < num_shards; i++)
+        if (REPR(MVM_repr_at_pos_o(tc, queues, i))->ID != MVM_REPR_ID_ConcBlockingQueue)
+            MVM_exception_throw_adhoc(tc,
+                "asynclistensharded target queues must have ConcBlockingQueue REPR");
+    if (REPR(async_type)->ID != MVM_REPR_ID_MVMAsyncTask)
+        MVM_exception_throw_adhoc(tc,
+            "asynclistensharded result type must have REPR AsyncTask");
+    if (port == 0)
+        MVM_exception_throw_adhoc(tc,
+            "asynclistensharded needs a port to listen on, not port 0");
+
+    /* Resolve hostname. (Could be done asynchronously too.) */
+    MVMROOT3(tc, queues, schedulee, async_type, {
+        dest = MVM_io_resolve_host_name(tc, host, port, SOCKET_FAMILY_UNSPEC);
+    });
+    if (dest->sa_family == AF_INET)
+        dest_size = sizeof(struct sockaddr_in);
+    else if (dest->sa_family == AF_INET6)
+        dest_size = sizeof(struct sockaddr_in6);
+    else {
+        MVM_free(dest);
+        MVM_exception_throw_adhoc(tc,
+            "asynclistensharded can only listen on an IPv4 or IPv6 address");
+    }
+
+    /* Make a listen task for each queue, putting them on successive loops. */
+    first_loop = (MVMuint32)(MVM_io_eventloop_pick(tc) - instance->event_loops);
+    MVMROOT3(tc, queues, schedulee, async_type, {
+        result = MVM_repr_alloc_init(tc, instance->boot_types.BOOTArray);
+        MVMROOT(tc, result, {
+            for (i = 0; i < num_shards; i++) {
+                MVMAsyncTask *task = (MVMAsyncTask *)MVM_repr_alloc_init(tc, async_type);
+                MVMObject    *queue = MVM_repr_at_pos_o(tc, queues, i);
+                ListenInfo   *li;
+                MVM_ASSIGN_REF(tc, &(task->common.header), task->body.queue, queue);
+                MVM_ASSIGN_REF(tc, &(task->common.header), task->body.schedulee, schedulee);
+                task->body.ops  = &listen_op_table;
+                task->body.loop = &instance->event_loops[(first_loop + i) % instance->num_event_loops];
+                li              = MVM_calloc(1, sizeof(ListenInfo));
+                li->dest        = MVM_malloc(dest_size);
+                memcpy(li->dest, dest, dest_size);
+                li->backlog     = backlog;
+                li->reuse_port  = 1;
+                task->body.data = li;
+                MVM_repr_push_o(tc, result, (MVMObject *)task);
+            }
+        });
+    });
+    MVM_free(dest);
+
+    /* Hand the tasks off to their event loops. */
+    MVMROOT(tc, result, {
+        for (i = 0; i < num_shards; i++)
+            MVM_io_eventloop_queue_work(tc, MVM_repr_at_pos_o(tc, result, i));
+    });
+
+    return result;
+}
@@ -1,12 +1,39 @@
+#if defined(__linux__)
+/* sendmmsg needs _GNU_SOURCE, which must come before any system header. */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include <sys/socket.h>
+#endif
 #include "moar.h"
 
 /* Number of bytes we accept per read. */
 #define CHUNK_SIZE 65536
 
+/* How many datagrams a batched read can take from the kernel in one go; the
+ * receive buffer has room for this many of the largest possible size. */
+#define BATCH_RECV_DATAGRAMS 16
+
+/* How many datagrams we hand to sendmmsg at a time. */
+#define BATCH_SEND_DATAGRAMS 64
+
+/* Sockets can be asked to read with recvmmsg where libuv supports it. */
+#if UV_VERSION_HEX >= 0x012800
+#define MMSG_CHUNK    UV_UDP_MMSG_CHUNK
+#define MMSG_RECVMMSG UV_UDP_RECVMMSG
+#else
+#define MMSG_CHUNK    0
+#define MMSG_RECVMMSG 0
+#endif
+
 /* Data that we keep for an asynchronous UDP socket handle. */
 typedef struct {
     /* The libuv handle to the socket. */
     uv_udp_t *handle;
+
+    /* The event loop the handle was created on, which any task using it
+     * must run on too. */
+    MVMEventLoop *loop;
 } MVMIOAsyncUDPSocketData;
 
 /* Info we convey about a read task. */
@@ -18,13 +45,6 @@ typedef struct {
     int               work_idx;
 } ReadInfo;
 
-/* Allocates a buffer of the suggested size. */
-static void on_alloc(uv_handle_t *handle, size_t suggested_size, uv_buf_t *buf) {
-    size_t size = suggested_size > 0 ? suggested_size : 4;
-    buf->base   = MVM_malloc(size);
-    buf->len    = size;
-}
-
 /* Callback used to simply free memory on close. */
 static void free_on_close_cb(uv_handle_t *handle) {
     MVM_free(handle);
@@ -84,8 +104,10 @@ static void on_read(uv_udp_t *handle, ssize_t nread, const uv_buf_t *buf, const
      * This is an artifact of the underlying implementation and we shouldn't
      * pass it through to the user. */
 
-    if (nread == 0 && addr == NULL)
+    if (nread == 0 && addr == NULL) {
+        MVM_io_eventloop_release_read_buffer(handle->loop, buf);
         return;
+    }
 
     arr = MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTArray);
     t = MVM_io_eventloop_get_active_work(tc, ri->work_idx);
@@ -93,20 +115,24 @@ static void on_read(uv_udp_t *handle, ssize_t nread, const uv_buf_t *buf, const
     MVM_repr_push_o(tc, arr, t->body.schedulee);
     if (nread >= 0) {
         MVMROOT2(tc, t, arr, {
-            MVMArray *res_buf;
+            MVMObject *res_buf;
 
             /* Push the sequence number. */
             MVMObject *seq_boxed = MVM_repr_box_int(tc,
                 tc->instance->boot_types.BOOTInt, ri->seq_number++);
             MVM_repr_push_o(tc, arr, seq_boxed);
 
-            /* Produce a buffer and push it. */
-            res_buf      = (MVMArray *)MVM_repr_alloc_init(tc, ri->buf_type);
-            res_buf->body.slots.i8 = (MVMint8 *)buf->base;
-            res_buf->body.start    = 0;
-            res_buf->body.ssize    = buf->len;
-            res_buf->body.elems    = nread;
-            MVM_repr_push_o(tc, arr, (MVMObject *)res_buf);
+            /* Produce a buffer and push it. If the socket reads with
+             * recvmmsg, the datagram is one chunk of a larger buffer that
+             * libuv gives back once it's done with all of them, so it must
+             * be copied. */
+            if (flags & MMSG_CHUNK)
+                res_buf = MVM_io_eventloop_copy_read_result(tc, ri->buf_type,
+                    buf->base, nread);
+            else
+                res_buf = MVM_io_eventloop_read_buffer_result(tc, handle->loop,
+                    ri->buf_type, buf, nread);
+            MVM_repr_push_o(tc, arr, res_buf);
 
             /* next, no error. */
             MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTStr);
@@ -125,8 +151,7 @@ static void on_read(uv_udp_t *handle, ssize_t nread, const uv_buf_t *buf, const
             MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTStr);
             MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTInt);
         });
-        if (buf->base)
-            MVM_free(buf->base);
+        MVM_io_eventloop_release_read_buffer(handle->loop, buf);
         uv_udp_recv_stop(handle);
         MVM_io_eventloop_remove_active_work(tc, &(ri->work_idx));
     }
@@ -142,8 +167,7 @@ static void on_read(uv_udp_t *handle, ssize_t nread, const uv_buf_t *buf, const
             MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTStr);
             MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTInt);
         });
-        if (buf->base)
-            MVM_free(buf->base);
+        MVM_io_eventloop_release_read_buffer(handle->loop, buf);
         uv_udp_recv_stop(handle);
         MVM_io_eventloop_remove_active_work(tc, &(ri->work_idx));
     }
@@ -163,7 +187,7 @@ static void read_setup(MVMThreadContext *tc, uv_loop_t *loop, MVMObject *async_t
     /* Start reading the stream. */
     handle_data = (MVMIOAsyncUDPSocketData *)ri->handle->body.data;
     handle_data->handle->data = data;
-    if ((r = uv_udp_recv_start(handle_data->handle, on_alloc, on_read)) < 0) {
+    if ((r = uv_udp_recv_start(handle_data->handle, MVM_io_eventloop_alloc_read_buffer, on_read)) < 0) {
         /* Error; need to notify. */
         MVMROOT(tc, async_task, {
             MVMObject    *arr = MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTArray);
@@ -234,6 +258,7 @@ static MVMAsyncTask * read_bytes(MVMThreadContext *tc, MVMOSHandle *h, MVMObject
     MVM_ASSIGN_REF(tc, &(task->common.header), task->body.queue, queue);
     MVM_ASSIGN_REF(tc, &(task->common.header), task->body.schedulee, schedulee);
     task->body.ops  = &read_op_table;
+    task->body.loop = ((MVMIOAsyncUDPSocketData *)h->body.data)->loop;
     ri              = MVM_calloc(1, sizeof(ReadInfo));
     MVM_ASSIGN_REF(tc, &(task->common.header), ri->buf_type, buf_type);
     MVM_ASSIGN_REF(tc, &(task->common.header), ri->handle, h);
@@ -247,6 +272,342 @@ static MVMAsyncTask * read_bytes(MVMThreadContext *tc, MVMOSHandle *h, MVMObject
     return task;
 }
 
+/* Stores the length of a datagram and the address it came from or is going
+ * to in a batch record; see asyncsocketudp.h for the layout. */
+static void addr_to_record(const struct sockaddr *addr, MVMint64 length, MVMint64 *rec) {
+    memset(rec, 0, MVM_UDP_BATCH_RECORD * sizeof(MVMint64));
+    rec[0] = length;
+    if (!addr)
+        return;
+    if (addr->sa_family == AF_INET) {
+        const struct sockaddr_in *in = (const struct sockaddr_in *)addr;
+        rec[1] = 4;
+        rec[2] = ntohs(in->sin_port);
+        rec[4] = (MVMint64)ntohl(in->sin_addr.s_addr);
+    }
+    else if (addr->sa_family == AF_INET6) {
+        const struct sockaddr_in6 *in6 = (const struct sockaddr_in6 *)addr;
+        MVMuint64 hi = 0, lo = 0;
+        int i;
+        for (i = 0; i < 8; i++) {
+            hi = (hi << 8) | in6->sin6_addr.s6_addr[i];
+            lo = (lo << 8) | in6->sin6_addr.s6_addr[i + 8];
+        }
+        rec[1] = 6;
+        rec[2] = ntohs(in6->sin6_port);
+        rec[3] = (MVMint64)hi;
+        rec[4] = (MVMint64)lo;
+    }
+}
+
+/* Turns a batch record back into an address, returning its size, or 0 if
+ * the record doesn't describe one. */
+static int record_to_addr(const MVMint64 *rec, struct sockaddr_storage *ss) {
+    memset(ss, 0, sizeof(struct sockaddr_storage));
+    if (rec[2] < 0 || rec[2] > 65535)
+        return 0;
+    if (rec[1] == 4) {
+        struct sockaddr_in *in = (struct sockaddr_in *)ss;
+        if (rec[3] != 0 || rec[4] < 0 || rec[4] > 0xFFFFFFFFLL)
+            return 0;
+        in->sin_family      = AF_INET;
+        in->sin_port        = htons((unsigned short)rec[2]);
+        in->sin_addr.s_addr = htonl((MVMuint32)rec[4]);
+        return sizeof(struct sockaddr_in);
+    }
+    else if (rec[1] == 6) {
+        struct sockaddr_in6 *in6 = (struct sockaddr_in6 *)ss;
+        MVMuint64 hi = (MVMuint64)rec[3], lo = (MVMuint64)rec[4];
+        int i;
+        for (i = 7; i >= 0; i--) {
+            in6->sin6_addr.s6_addr[i]     = (unsigned char)(hi & 0xFF);
+            in6->sin6_addr.s6_addr[i + 8] = (unsigned char)(lo & 0xFF);
+            hi >>= 8;
+            lo >>= 8;
+        }
+        in6->sin6_family = AF_INET6;
+        in6->sin6_port   = htons((unsigned short)rec[2]);
+        return sizeof(struct sockaddr_in6);
+    }
+    return 0;
+}
+
+/* Info we convey about a batched read task. */
+typedef struct {
+    MVMOSHandle      *handle;
+    MVMObject        *buf_type;
+    int               seq_number;
+
+    /* How many datagrams go in a batch at most. */
+    MVMint64          max;
+
+    /* What libuv reads into; datagrams are copied out of it straight away,
+     * so the one buffer serves every read. */
+    char             *recv_buf;
+
+    /* The bytes and records of the datagrams of the batch being built. */
+    char             *data;
+    size_t            data_used;
+    size_t            data_size;
+    MVMint64         *records;
+    MVMint64          count;
+
+    /* Sends off a partial batch once the loop has handled all the I/O that
+     * was ready, so a quiet socket doesn't hold datagrams back. */
+    uv_check_t       *check;
+
+    MVMThreadContext *tc;
+    int               work_idx;
+} BatchReadInfo;
+
+/* Hands libuv the task's receive buffer. */
+static void batch_alloc_buffer(uv_handle_t *handle, size_t suggested_size, uv_buf_t *buf) {
+    BatchReadInfo *ri = (BatchReadInfo *)handle->data;
+    buf->base = ri->recv_buf;
+    buf->len  = BATCH_RECV_DATAGRAMS * CHUNK_SIZE;
+}
+
+/* Sends the datagrams gathered so far, if there are any, as one result. */
+static void flush_batch(BatchReadInfo *ri) {
+    MVMThreadContext *tc = ri->tc;
+    MVMAsyncTask     *t;
+    MVMObject        *arr;
+    if (ri->count == 0)
+        return;
+
+    t   = MVM_io_eventloop_get_active_work(tc, ri->work_idx);
+    arr = MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTArray);
+    MVM_repr_push_o(tc, arr, t->body.schedulee);
+    MVMROOT2(tc, t, arr, {
+        MVMArray  *res_buf;
+        MVMArray  *meta;
+
+        /* Push the sequence number. */
+        MVMObject *seq_boxed = MVM_repr_box_int(tc,
+            tc->instance->boot_types.BOOTInt, ri->seq_number++);
+        MVM_repr_push_o(tc, arr, seq_boxed);
+
+        /* The gathered bytes become the storage of the result buffer. */
+        res_buf = (MVMArray *)MVM_repr_alloc_init(tc, ri->buf_type);
+        res_buf->body.slots.i8 = (MVMint8 *)ri->data;
+        res_buf->body.ssize    = ri->data_size;
+        res_buf->body.start    = 0;
+        res_buf->body.elems    = ri->data_used;
+        ri->data      = NULL;
+        ri->data_used = 0;
+        ri->data_size = 0;
+        MVM_repr_push_o(tc, arr, (MVMObject *)res_buf);
+
+        /* No error. */
+        MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTStr);
+
+        /* And the records saying where each datagram is and came from. */
+        meta = (MVMArray *)MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTIntArray);
+        MVMROOT(tc, meta, {
+            MVM_repr_pos_set_elems(tc, (MVMObject *)meta, ri->count * MVM_UDP_BATCH_RECORD);
+        });
+        memcpy(meta->body.slots.i64, ri->records,
+            ri->count * MVM_UDP_BATCH_RECORD * sizeof(MVMint64));
+        MVM_repr_push_o(tc, arr, (MVMObject *)meta);
+    });
+    MVM_repr_push_o(tc, t->body.queue, arr);
+    ri->count = 0;
+}
+
+/* Runs after the loop has polled for I/O, sending off a partial batch. */
+static void on_batch_check(uv_check_t *check) {
+    BatchReadInfo *ri = (BatchReadInfo *)check->data;
+    uv_check_stop(check);
+    flush_batch(ri);
+}
+
+/* Read handler for batched reads. */
+static void on_batch_read(uv_udp_t *handle, ssize_t nread, const uv_buf_t *buf, const struct sockaddr *addr, unsigned flags) {
+    BatchReadInfo    *ri = (BatchReadInfo *)handle->data;
+    MVMThreadContext *tc = ri->tc;
+    MVMObject        *arr;
+    MVMAsyncTask     *t;
+
+    /* The receive buffer belongs to the task, so there's nothing to do when
+     * libuv gives it back. */
+    if (nread == 0 && addr == NULL)
+        return;
+
+    if (nread >= 0) {
+        /* Copy the datagram onto the end of the batch. */
+        if (ri->data_used + nread > ri->data_size) {
+            size_t want = ri->data_size ? ri->data_size * 2 : CHUNK_SIZE;
+            while (want < ri->data_used + nread)
+                want *= 2;
+            ri->data      = MVM_realloc(ri->data, want);
+            ri->data_size = want;
+        }
+        if (nread > 0)
+            memcpy(ri->data + ri->data_used, buf->base, nread);
+        ri->data_used += nread;
+        addr_to_record(addr, nread, ri->records + ri->count * MVM_UDP_BATCH_RECORD);
+        ri->count++;
+
+        if (ri->count == ri->max) {
+            uv_check_stop(ri->check);
+            flush_batch(ri);
+        }
+        else if (!uv_is_active((uv_handle_t *)ri->check)) {
+            uv_check_start(ri->check, on_batch_check);
+        }
+        return;
+    }
+
+    /* Anything already received goes before the error. */
+    flush_batch(ri);
+    arr = MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTArray);
+    t   = MVM_io_eventloop_get_active_work(tc, ri->work_idx);
+    MVM_repr_push_o(tc, arr, t->body.schedulee);
+    if (nread == UV_EOF) {
+        MVMROOT2(tc, t, arr, {
+            MVMObject *final = MVM_repr_box_int(tc,
+                tc->instance->boot_types.BOOTInt, ri->seq_number);
+            MVM_repr_push_o(tc, arr, final);
+            MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTStr);
+            MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTStr);
+            MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTIntArray);
+        });
+    }
+    else {
+        MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTInt);
+        MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTStr);
+        MVMROOT2(tc, t, arr, {
+            MVMString *msg_str = MVM_string_ascii_decode_nt(tc,
+                tc->instance->VMString, uv_strerror(nread));
+            MVMObject *msg_box = MVM_repr_box_str(tc,
+                tc->instance->boot_types.BOOTStr, msg_str);
+            MVM_repr_push_o(tc, arr, msg_box);
+            MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTIntArray);
+        });
+    }
+    MVM_repr_push_o(tc, t->body.queue, arr);
+    uv_udp_recv_stop(handle);
+    uv_close((uv_handle_t *)ri->check, free_on_close_cb);
+    ri->check = NULL;
+    MVM_io_eventloop_remove_active_work(tc, &(ri->work_idx));
+}
+
+/* Does setup work for setting up batched reads. */
+static void batch_read_setup(MVMThreadContext *tc, uv_loop_t *loop, MVMObject *async_task, void *data) {
+    MVMIOAsyncUDPSocketData *handle_data;
+    int                      r;
+
+    /* Add to work in progress. */
+    BatchReadInfo *ri = (BatchReadInfo *)data;
+    ri->tc            = tc;
+    ri->work_idx      = MVM_io_eventloop_add_active_work(tc, async_task);
+    ri->recv_buf      = MVM_malloc(BATCH_RECV_DATAGRAMS * CHUNK_SIZE);
+    ri->records       = MVM_malloc(ri->max * MVM_UDP_BATCH_RECORD * sizeof(MVMint64));
+    ri->check         = MVM_malloc(sizeof(uv_check_t));
+    uv_check_init(loop, ri->check);
+    ri->check->data   = ri;
+
+    /* Start reading the stream. */
+    handle_data = (MVMIOAsyncUDPSocketData *)ri->handle->body.data;
+    handle_data->handle->data = data;
+    if ((r = uv_udp_recv_start(handle_data->handle, batch_alloc_buffer, on_batch_read)) < 0) {
+        /* Error; need to notify. */
+        MVMROOT(tc, async_task, {
+            MVMObject    *arr = MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTArray);
+            MVMAsyncTask *t   = (MVMAsyncTask *)async_task;
+            MVM_repr_push_o(tc, arr, t->body.schedulee);
+            MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTInt);
+            MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTStr);
+            MVMROOT(tc, arr, {
+                MVMString *msg_str = MVM_string_ascii_decode_nt(tc,
+                    tc->instance->VMString, uv_strerror(r));
+                MVMObject *msg_box = MVM_repr_box_str(tc,
+                    tc->instance->boot_types.BOOTStr, msg_str);
+                MVM_repr_push_o(tc, arr, msg_box);
+            });
+            MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTIntArray);
+            MVM_repr_push_o(tc, t->body.queue, arr);
+        });
+        uv_close((uv_handle_t *)ri->check, free_on_close_cb);
+        ri->check = NULL;
+        MVM_io_eventloop_remove_active_work(tc, &(ri->work_idx));
+    }
+}
+
+/* Marks objects for a batched read task. */
+static void batch_read_gc_mark(MVMThreadContext *tc, void *data, MVMGCWorklist *worklist) {
+    BatchReadInfo *ri = (BatchReadInfo *)data;
+    MVM_gc_worklist_add(tc, worklist, &ri->buf_type);
+    MVM_gc_worklist_add(tc, worklist, &ri->handle);
+}
+
+/* Frees info for a batched read task. */
+static void batch_read_gc_free(MVMThreadContext *tc, MVMObject *t, void *data) {
+    if (data) {
+        BatchReadInfo *ri = (BatchReadInfo *)data;
+        MVM_free(ri->recv_buf);
+        MVM_free(ri->data);
+        MVM_free(ri->records);
+        MVM_free(ri);
+    }
+}
+
+/* Operations table for async batched read task. */
+static const MVMAsyncTaskOps batch_read_op_table = {
+    batch_read_setup,
+    NULL,
+    NULL,
+    batch_read_gc_mark,
+    batch_read_gc_free
+};
+
+static MVMAsyncTask * read_datagrams(MVMThreadContext *tc, MVMOSHandle *h, MVMObject *queue,
+                                     MVMObject *schedulee, MVMObject *buf_type, MVMint64 max,
+                                     MVMObject *async_type) {
+    MVMAsyncTask  *task;
+    BatchReadInfo *ri;
+
+    /* Validate REPRs. */
+    if (REPR(queue)->ID != MVM_REPR_ID_ConcBlockingQueue)
+        MVM_exception_throw_adhoc(tc,
+            "asyncreadbatch target queue must have ConcBlockingQueue REPR (got %s)",
+             MVM_6model_get_stable_debug_name(tc, queue->st));
+    if (REPR(async_type)->ID != MVM_REPR_ID_MVMAsyncTask)
+        MVM_exception_throw_adhoc(tc,
+            "asyncreadbatch result type must have REPR AsyncTask");
+    if (REPR(buf_type)->ID == MVM_REPR_ID_VMArray) {
+        MVMint32 slot_type = ((MVMArrayREPRData *)STABLE(buf_type)->REPR_data)->slot_type;
+        if (slot_type != MVM_ARRAY_U8 && slot_type != MVM_ARRAY_I8)
+            MVM_exception_throw_adhoc(tc, "asyncreadbatch buffer type must be an array of uint8 or int8");
+    }
+    else {
+        MVM_exception_throw_adhoc(tc, "asyncreadbatch buffer type must be an array");
+    }
+    if (max > 0xFFFF)
+        MVM_exception_throw_adhoc(tc, "asyncreadbatch batch size may be at most 65535");
+
+    /* Create async task handle. */
+    MVMROOT4(tc, queue, schedulee, h, buf_type, {
+        task = (MVMAsyncTask *)MVM_repr_alloc_init(tc, async_type);
+    });
+    MVM_ASSIGN_REF(tc, &(task->common.header), task->body.queue, queue);
+    MVM_ASSIGN_REF(tc, &(task->common.header), task->body.schedulee, schedulee);
+    task->body.ops  = &batch_read_op_table;
+    task->body.loop = ((MVMIOAsyncUDPSocketData *)h->body.data)->loop;
+    ri              = MVM_calloc(1, sizeof(BatchReadInfo));
+    MVM_ASSIGN_REF(tc, &(task->common.header), ri->buf_type, buf_type);
+    MVM_ASSIGN_REF(tc, &(task->common.header), ri->handle, h);
+    ri->max         = max;
+    task->body.data = ri;
+
+    /* Hand the task off to the event loop. */
+    MVMROOT(tc, task, {
+        MVM_io_eventloop_queue_work(tc, (MVMObject *)task);
+    });
+
+    return task;
+}
+
 /* Info we convey about a write task. */
 typedef struct {
     MVMOSHandle      *handle;
@@ -395,6 +756,7 @@ static MVMAsyncTask * write_bytes_to(MVMThreadContext *tc, MVMOSHandle *h, MVMOb
     MVM_ASSIGN_REF(tc, &(task->common.header), task->body.queue, queue);
     MVM_ASSIGN_REF(tc, &(task->common.header), task->body.schedulee, schedulee);
     task->body.ops  = &write_op_table;
+    task->body.loop = ((MVMIOAsyncUDPSocketData *)h->body.data)->loop;
     wi              = MVM_calloc(1, sizeof(WriteInfo));
     MVM_ASSIGN_REF(tc, &(task->common.header), wi->handle, h);
     MVM_ASSIGN_REF(tc, &(task->common.header), wi->buf_data, buffer);
@@ -409,6 +771,260 @@ static MVMAsyncTask * write_bytes_to(MVMThreadContext *tc, MVMOSHandle *h, MVMOb
     return task;
 }
 
+/* Info we convey about a batched write task. */
+typedef struct {
+    MVMOSHandle             *handle;
+    MVMObject               *buf_data;
+
+    /* Where each datagram goes, how big its address is, and how long it
+     * is; the datagrams lie one after the other in the buffer. */
+    struct sockaddr_storage *addrs;
+    int                     *addr_lens;
+    MVMint64                *lengths;
+    MVMint64                 count;
+
+    /* How many have been sent, and how many uv_udp_send requests are yet
+     * to complete. */
+    MVMint64                 sent;
+    MVMint64                 pending;
+    uv_udp_send_t           *reqs;
+    uv_buf_t                *bufs;
+    const char              *error;
+
+    MVMThreadContext        *tc;
+    int                      work_idx;
+} BatchWriteInfo;
+
+/* Reports how a batched write went, once all of it is done. */
+static void batch_write_done(BatchWriteInfo *wi) {
+    MVMThreadContext *tc  = wi->tc;
+    MVMObject        *arr = MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTArray);
+    MVMAsyncTask     *t   = MVM_io_eventloop_get_active_work(tc, wi->work_idx);
+    MVM_repr_push_o(tc, arr, t->body.schedulee);
+    MVMROOT2(tc, arr, t, {
+        MVMObject *sent_box = MVM_repr_box_int(tc,
+            tc->instance->boot_types.BOOTInt, wi->sent);
+        MVM_repr_push_o(tc, arr, sent_box);
+        if (wi->error) {
+            MVMString *msg_str = MVM_string_ascii_decode_nt(tc,
+                tc->instance->VMString, wi->error);
+            MVMObject *msg_box = MVM_repr_box_str(tc,
+                tc->instance->boot_types.BOOTStr, msg_str);
+            MVM_repr_push_o(tc, arr, msg_box);
+        }
+        else {
+            MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTStr);
+        }
+    });
+    MVM_repr_push_o(tc, t->body.queue, arr);
+    MVM_free(wi->reqs);
+    wi->reqs = NULL;
+    MVM_io_eventloop_remove_active_work(tc, &(wi->work_idx));
+}
+
+/* Completion handler for one datagram of a batch sent through libuv. */
+static void on_batch_write(uv_udp_send_t *req, int status) {
+    BatchWriteInfo *wi = (BatchWriteInfo *)req->data;
+    if (status >= 0)
+        wi->sent++;
+    else if (!wi->error)
+        wi->error = uv_strerror(status);
+    if (--wi->pending == 0)
+        batch_write_done(wi);
+}
+
+#if defined(__linux__)
+/* Sends as much of the batch as the socket will take right now with
+ * sendmmsg, which needs one system call for many datagrams. It is only
+ * used when libuv has nothing queued, so datagrams can't overtake ones
+ * sent earlier. */
+static void batch_send_direct(BatchWriteInfo *wi, uv_udp_t *handle) {
+    struct mmsghdr msgs[BATCH_SEND_DATAGRAMS];
+    uv_os_fd_t     fd;
+    if (handle->send_queue_count != 0 || uv_fileno((uv_handle_t *)handle, &fd) != 0)
+        return;
+    while (wi->sent < wi->count) {
+        MVMint64 todo = wi->count - wi->sent;
+        MVMint64 i;
+        int      r;
+        if (todo > BATCH_SEND_DATAGRAMS)
+            todo = BATCH_SEND_DATAGRAMS;
+        memset(msgs, 0, todo * sizeof(struct mmsghdr));
+        for (i = 0; i < todo; i++) {
+            MVMint64 idx = wi->sent + i;
+            msgs[i].msg_hdr.msg_name    = &(wi->addrs[idx]);
+            msgs[i].msg_hdr.msg_namelen = wi->addr_lens[idx];
+            msgs[i].msg_hdr.msg_iov     = (struct iovec *)&(wi->bufs[idx]);
+            msgs[i].msg_hdr.msg_iovlen  = 1;
+        }
+        do {
+            r = sendmmsg(fd, msgs, (unsigned int)todo, 0);
+        } while (r < 0 && errno == EINTR);
+        if (r < 0) {
+            /* A full socket buffer just means libuv waits to send the rest;
+             * anything else fails the batch. */
+            if (errno != EAGAIN && errno != EWOULDBLOCK)
+                wi->error = uv_strerror(uv_translate_sys_error(errno));
+            return;
+        }
+        wi->sent += r;
+    }
+}
+#endif
+
+/* Does setup work for a batched write. */
+static void batch_write_setup(MVMThreadContext *tc, uv_loop_t *loop, MVMObject *async_task, void *data) {
+    MVMIOAsyncUDPSocketData *handle_data;
+    MVMArray                *buffer;
+    char                    *output;
+    MVMint64                 i, offset;
+
+    /* Add to work in progress. */
+    BatchWriteInfo *wi = (BatchWriteInfo *)data;
+    wi->tc             = tc;
+    wi->work_idx       = MVM_io_eventloop_add_active_work(tc, async_task);
+
+    handle_data = (MVMIOAsyncUDPSocketData *)wi->handle->body.data;
+    if (uv_is_closing((uv_handle_t *)handle_data->handle))
+        MVM_exception_throw_adhoc(tc, "cannot write to a closed socket");
+
+    /* Point at each datagram in the buffer, which may have changed size
+     * since the task was made. */
+    buffer = (MVMArray *)wi->buf_data;
+    output = (char *)(buffer->body.slots.i8 + buffer->body.start);
+    wi->bufs = MVM_malloc((wi->count ? wi->count : 1) * sizeof(uv_buf_t));
+    offset = 0;
+    for (i = 0; i < wi->count; i++) {
+        wi->bufs[i] = uv_buf_init(output + offset, (unsigned int)wi->lengths[i]);
+        offset     += wi->lengths[i];
+    }
+    if ((MVMuint64)offset > buffer->body.elems) {
+        wi->error = "datagram lengths add up to more than the buffer holds";
+        batch_write_done(wi);
+        return;
+    }
+
+#if defined(__linux__)
+    batch_send_direct(wi, handle_data->handle);
+#endif
+
+    /* Whatever is left goes through libuv. */
+    if (!wi->error && wi->sent < wi->count) {
+        wi->reqs = MVM_malloc((wi->count - wi->sent) * sizeof(uv_udp_send_t));
+        for (i = wi->sent; i < wi->count; i++) {
+            uv_udp_send_t *req = &(wi->reqs[i - wi->sent]);
+            int r;
+            req->data = wi;
+            if ((r = uv_udp_send(req, handle_data->handle, &(wi->bufs[i]), 1,
+                    (struct sockaddr *)&(wi->addrs[i]), on_batch_write)) < 0) {
+                wi->error = uv_strerror(r);
+                break;
+            }
+            wi->pending++;
+        }
+    }
+    if (wi->pending == 0)
+        batch_write_done(wi);
+}
+
+/* Marks objects for a batched write task. */
+static void batch_write_gc_mark(MVMThreadContext *tc, void *data, MVMGCWorklist *worklist) {
+    BatchWriteInfo *wi = (BatchWriteInfo *)data;
+    MVM_gc_worklist_add(tc, worklist, &wi->handle);
+    MVM_gc_worklist_add(tc, worklist, &wi->buf_data);
+}
+
+/* Frees info for a batched write task. */
+static void batch_write_gc_free(MVMThreadContext *tc, MVMObject *t, void *data) {
+    if (data) {
+        BatchWriteInfo *wi = (BatchWriteInfo *)data;
+        MVM_free(wi->addrs);
+        MVM_free(wi->addr_lens);
+        MVM_free(wi->lengths);
+        MVM_free(wi->bufs);
+        MVM_free(wi->reqs);
+        MVM_free(wi);
+    }
+}
+
+/* Operations table for async batched write task. */
+static const MVMAsyncTaskOps batch_write_op_table = {
+    batch_write_setup,
+    NULL,
+    NULL,
+    batch_write_gc_mark,
+    batch_write_gc_free
+};
+
+static MVMAsyncTask * write_batch_to(MVMThreadContext *tc, MVMOSHandle *h, MVMObject *queue,
+                                     MVMObject *schedulee, MVMObject *buffer, MVMObject *meta,
+                                     MVMObject *async_type) {
+    MVMAsyncTask   *task;
+    BatchWriteInfo *wi;
+    MVMint64        num_records, count, i, total = 0;
+
+    /* Validate REPRs. */
+    if (REPR(queue)->ID != MVM_REPR_ID_ConcBlockingQueue)
+        MVM_exception_throw_adhoc(tc,
+            "asyncwritebatchto target queue must have ConcBlockingQueue REPR");
+    if (REPR(async_type)->ID != MVM_REPR_ID_MVMAsyncTask)
+        MVM_exception_throw_adhoc(tc,
+            "asyncwritebatchto result type must have REPR AsyncTask");
+    if (!IS_CONCRETE(buffer) || REPR(buffer)->ID != MVM_REPR_ID_VMArray)
+        MVM_exception_throw_adhoc(tc, "asyncwritebatchto requires a native array to read from");
+    if (((MVMArrayREPRData *)STABLE(buffer)->REPR_data)->slot_type != MVM_ARRAY_U8
+        && ((MVMArrayREPRData *)STABLE(buffer)->REPR_data)->slot_type != MVM_ARRAY_I8)
+        MVM_exception_throw_adhoc(tc, "asyncwritebatchto requires a native array of uint8 or int8");
+    if (!IS_CONCRETE(meta) || REPR(meta)->ID != MVM_REPR_ID_VMArray
+        || ((MVMArrayREPRData *)STABLE(meta)->REPR_data)->slot_type != MVM_ARRAY_I64)
+        MVM_exception_throw_adhoc(tc, "asyncwritebatchto requires a native array of int64 describing the datagrams");
+    num_records = MVM_repr_elems(tc, meta);
+    if (num_records % MVM_UDP_BATCH_RECORD != 0)
+        MVM_exception_throw_adhoc(tc,
+            "asyncwritebatchto datagram descriptions must have %d elements each", MVM_UDP_BATCH_RECORD);
+
+    /* Turn the records into addresses now, so any bad ones are reported to
+     * the caller. */
+    count         = num_records / MVM_UDP_BATCH_RECORD;
+    wi            = MVM_calloc(1, sizeof(BatchWriteInfo));
+    wi->count     = count;
+    wi->addrs     = MVM_malloc((count ? count : 1) * sizeof(struct sockaddr_storage));
+    wi->addr_lens = MVM_malloc((count ? count : 1) * sizeof(int));
+    wi->lengths   = MVM_malloc((count ? count : 1) * sizeof(MVMint64));
+    for (i = 0; i < count; i++) {
+        MVMint64 *rec = ((MVMArray *)meta)->body.slots.i64 + ((MVMArray *)meta)->body.start
+            + i * MVM_UDP_BATCH_RECORD;
+        wi->lengths[i]   = rec[0];
+        wi->addr_lens[i] = record_to_addr(rec, &(wi->addrs[i]));
+        total           += rec[0] > 0 ? rec[0] : 0;
+        if (rec[0] < 0 || rec[0] > CHUNK_SIZE || !wi->addr_lens[i]
+                || total > (MVMint64)((MVMArray *)buffer)->body.elems) {
+            batch_write_gc_free(tc, NULL, wi);
+            MVM_exception_throw_adhoc(tc,
+                "asyncwritebatchto got an invalid description for datagram %"PRId64, i);
+        }
+    }
+
+    /* Create async task handle. */
+    MVMROOT4(tc, queue, schedulee, h, buffer, {
+        task = (MVMAsyncTask *)MVM_repr_alloc_init(tc, async_type);
+    });
+    MVM_ASSIGN_REF(tc, &(task->common.header), task->body.queue, queue);
+    MVM_ASSIGN_REF(tc, &(task->common.header), task->body.schedulee, schedulee);
+    task->body.ops  = &batch_write_op_table;
+    task->body.loop = ((MVMIOAsyncUDPSocketData *)h->body.data)->loop;
+    MVM_ASSIGN_REF(tc, &(task->common.header), wi->handle, h);
+    MVM_ASSIGN_REF(tc, &(task->common.header), wi->buf_data, buffer);
+    task->body.data = wi;
+
+    /* Hand the task off to the event loop. */
+    MVMROOT(tc, task, {
+        MVM_io_eventloop_queue_work(tc, (MVMObject *)task);
+    });
+
+    return task;
+}
+
 /* Does an asynchronous close (since it must run on the event loop). */
 static void close_perform(MVMThreadContext *tc, uv_loop_t *loop, MVMObject *async_task, void *data) {
     uv_handle_t *handle = (uv_handle_t *)data;
@@ -437,6 +1053,7 @@ static MVMint64 close_socket(MVMThreadContext *tc, MVMOSHandle *h) {
             tc->instance->boot_types.BOOTAsync);
     });
     task->body.ops  = &close_op_table;
+    task->body.loop = data->loop;
     task->body.data = data->handle;
     MVM_io_eventloop_queue_work(tc, (MVMObject *)task);
 
@@ -462,8 +1079,8 @@ static MVMint64 socket_handle(MVMThreadContext *tc, MVMOSHandle *h) {
 
 /* IO ops table, populated with functions. */
 static const MVMIOClosable        closable          = { close_socket };
-static const MVMIOAsyncReadable   async_readable    = { read_bytes };
-static const MVMIOAsyncWritableTo async_writable_to = { write_bytes_to };
+static const MVMIOAsyncReadable   async_readable    = { read_bytes, read_datagrams };
+static const MVMIOAsyncWritableTo async_writable_to = { write_bytes_to, write_batch_to };
 static const MVMIOIntrospection   introspection     = { socket_is_tty,
                                                         socket_handle };
 static const MVMIOOps op_table = {
@@ -495,7 +1112,9 @@ static void setup_setup(MVMThreadContext *tc, uv_loop_t *loop, MVMObject *async_
     SocketSetupInfo *ssi = (SocketSetupInfo *)data;
     uv_udp_t *udp_handle = MVM_malloc(sizeof(uv_udp_t));
     int r;
-    if ((r = uv_udp_init(loop, udp_handle)) >= 0) {
+    if ((r = (ssi->flags & 2)
+            ? uv_udp_init_ex(loop, udp_handle, AF_UNSPEC | MMSG_RECVMMSG)
+            : uv_udp_init(loop, udp_handle)) >= 0) {
         if (ssi->bind_addr)
             r = uv_udp_bind(udp_handle, ssi->bind_addr, 0);
         if (r >= 0 && (ssi->flags & 1))
@@ -513,6 +1132,7 @@ static void setup_setup(MVMThreadContext *tc, uv_loop_t *loop, MVMObject *async_
                 MVMOSHandle          *result = (MVMOSHandle *)MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTIO);
                 MVMIOAsyncUDPSocketData *data   = MVM_calloc(1, sizeof(MVMIOAsyncUDPSocketData));
                 data->handle                 = udp_handle;
+                data->loop                   = tc->event_loop;
                 result->body.ops             = &op_table;
                 result->body.data            = data;
                 MVM_repr_push_o(tc, arr, (MVMObject *)result);
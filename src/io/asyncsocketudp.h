@@ -1,3 +1,11 @@
+/* Batched reads and writes describe each datagram with a record of this many
+ * int64s: its length, the address family (4 or 6, or 0 if unknown), the
+ * port, and then the address itself. An IPv4 address is in the last slot;
+ * an IPv6 one has its first 8 bytes in the slot before that and its last 8
+ * in the last slot, each read big-endian. Datagrams follow one another in
+ * the buffer in the order of their records. */
+#define MVM_UDP_BATCH_RECORD 5
+
 MVMObject * MVM_io_socket_udp_async(MVMThreadContext *tc, MVMObject *queue,
                                     MVMObject *schedulee, MVMString *host,
                                     MVMint64 port, MVMint64 flags,
@@ -0,0 +1,106 @@
+#include "moar.h"
+
+/* Sets up the cache, reading how long entries should live from the
+ * environment. */
+MVMDNSCache * MVM_io_dns_cache_create(void) {
+    MVMDNSCache *cache = MVM_calloc(1, sizeof(MVMDNSCache));
+    char        *ttl   = getenv("MVM_DNS_CACHE_TTL");
+    MVMint64     secs  = ttl ? strtoll(ttl, NULL, 10) : MVM_DNS_CACHE_DEFAULT_TTL;
+    cache->ttl = secs > 0 ? (MVMuint64)secs * 1000000000ULL : 0;
+    if (uv_mutex_init(&cache->mutex) < 0)
+        MVM_panic(1, "Unable to initialize DNS cache mutex");
+    return cache;
+}
+
+/* Frees the cache and everything in it. */
+void MVM_io_dns_cache_destroy(MVMDNSCache *cache) {
+    MVMuint32 i;
+    if (!cache)
+        return;
+    for (i = 0; i < MVM_DNS_CACHE_SIZE; i++)
+        MVM_free(cache->entries[i].host);
+    uv_mutex_destroy(&cache->mutex);
+    MVM_free(cache);
+}
+
+/* Checks if an entry can be reused for another name. */
+static int is_free(MVMDNSCacheEntry *entry, MVMuint64 now) {
+    return !entry->host || entry->expires <= now;
+}
+
+/* Looks for an unexpired entry for the host and family, giving back a copy
+ * of its address with the port set, or NULL if there is none. */
+struct sockaddr * MVM_io_dns_cache_lookup(MVMThreadContext *tc, const char *host, MVMint64 port,
+        MVMuint16 family) {
+    MVMDNSCache     *cache  = tc->instance->dns_cache;
+    struct sockaddr *result = NULL;
+    MVMuint64        now;
+    MVMuint32        i;
+    if (!cache || !cache->ttl)
+        return NULL;
+
+    now = uv_hrtime();
+    uv_mutex_lock(&cache->mutex);
+    for (i = 0; i < MVM_DNS_CACHE_SIZE; i++) {
+        MVMDNSCacheEntry *entry = &(cache->entries[i]);
+        if (entry->host && entry->family == family && entry->expires > now
+                && strcmp(entry->host, host) == 0) {
+            result = MVM_malloc(entry->addr_size);
+            memcpy(result, &(entry->addr), entry->addr_size);
+            break;
+        }
+    }
+    uv_mutex_unlock(&cache->mutex);
+
+    if (result) {
+        if (result->sa_family == AF_INET6)
+            ((struct sockaddr_in6 *)result)->sin6_port = htons((unsigned short)port);
+        else
+            ((struct sockaddr_in *)result)->sin_port = htons((unsigned short)port);
+    }
+    return result;
+}
+
+/* Remembers what a host name resolved to. Only internet addresses are
+ * kept. The entry goes in place of one for the same name, or failing that
+ * an empty or expired one, or failing that the one closest to expiring. */
+void MVM_io_dns_cache_store(MVMThreadContext *tc, const char *host, MVMuint16 family,
+        const struct sockaddr *addr) {
+    MVMDNSCache      *cache = tc->instance->dns_cache;
+    MVMDNSCacheEntry *slot  = NULL;
+    MVMuint64         now;
+    size_t            size;
+    MVMuint32         i;
+    if (!cache || !cache->ttl)
+        return;
+    if (addr->sa_family == AF_INET)
+        size = sizeof(struct sockaddr_in);
+    else if (addr->sa_family == AF_INET6)
+        size = sizeof(struct sockaddr_in6);
+    else
+        return;
+
+    now = uv_hrtime();
+    uv_mutex_lock(&cache->mutex);
+    for (i = 0; i < MVM_DNS_CACHE_SIZE; i++) {
+        MVMDNSCacheEntry *entry = &(cache->entries[i]);
+        if (entry->host && entry->family == family && strcmp(entry->host, host) == 0) {
+            slot = entry;
+            break;
+        }
+        if (!slot || (!is_free(slot, now)
+                && (is_free(entry, now) || entry->expires < slot->expires)))
+            slot = entry;
+    }
+    if (!slot->host || strcmp(slot->host, host) != 0) {
+        size_t len = strlen(host);
+        MVM_free(slot->host);
+        slot->host = MVM_malloc(len + 1);
+        memcpy(slot->host, host, len + 1);
+    }
+    slot->family    = family;
+    slot->expires   = now + cache->ttl;
+    slot->addr_size = size;
+    memcpy(&(slot->addr), addr, size);
+    uv_mutex_unlock(&cache->mutex);
+}
@@ -0,0 +1,37 @@
+/* Host names that have been resolved are remembered for a while, so that
+ * connecting to the same place again and again doesn't mean asking the
+ * resolver each time. getaddrinfo doesn't tell us how long a record may be
+ * kept, so entries live for a fixed time, which can be set in seconds with
+ * MVM_DNS_CACHE_TTL (0 turns the cache off). */
+#define MVM_DNS_CACHE_SIZE        64
+#define MVM_DNS_CACHE_DEFAULT_TTL 30
+
+struct MVMDNSCacheEntry {
+    /* The name that was resolved, and the socket family asked for. */
+    char                    *host;
+    MVMuint16                family;
+
+    /* When the entry stops being used, as a uv_hrtime value. */
+    MVMuint64                expires;
+
+    /* The address it resolved to; the port is filled in on lookup. */
+    struct sockaddr_storage  addr;
+    size_t                   addr_size;
+};
+
+struct MVMDNSCache {
+    MVMDNSCacheEntry entries[MVM_DNS_CACHE_SIZE];
+
+    /* How long entries live, in nanoseconds. */
+    MVMuint64        ttl;
+
+    /* Resolution happens on any thread, so the cache is locked. */
+    uv_mutex_t       mutex;
+};
+
+MVMDNSCache * MVM_io_dns_cache_create(void);
+void MVM_io_dns_cache_destroy(MVMDNSCache *cache);
+struct sockaddr * MVM_io_dns_cache_lookup(MVMThreadContext *tc, const char *host, MVMint64 port,
+    MVMuint16 family);
+void MVM_io_dns_cache_store(MVMThreadContext *tc, const char *host, MVMuint16 family,
+    const struct sockaddr *addr);
@@ -1,18 +1,41 @@
 #include "moar.h"
+#include "platform/sys.h"
 
 /* Asynchronous I/O, timers, file system notifications and signal handlers
- * have their callbacks processed by this event loop. Its job is mostly to
+ * have their callbacks processed by event loops. Their job is mostly to
  * fire off work, receive the callbacks, and put stuff into the concurrent
- * work queue of some scheduler or other. It's backed by a thread that is
+ * work queue of some scheduler or other. Each is backed by a thread that is
  * started in the usual way, but never actually ends up in interpreter;
  * instead, it enters a libuv event loop "forever", until program exit.
  *
- * Work is sent to the event loop by
+ * There can be several loops, so that a busy program isn't limited to what
+ * one thread can process. New tasks are handed out to them in turn, and
+ * each loop is started the first time it is given one. A libuv handle can
+ * only be used from the loop it was created on, so tasks that work on a
+ * handle created by an earlier task (reading from a socket that was
+ * accepted or connected, say) are pinned to that task's loop by setting
+ * their loop before they are queued.
+ *
+ * On Linux, each loop may also have an io_uring (see uring.c), which the
+ * asynchronous file handles use in preference to libuv's thread pool.
  */
 
+/* Works out how many event loops to use by default: one for every eight
+ * CPU cores, so small machines keep a single loop. */
+MVMuint32 MVM_io_eventloop_default_count(void) {
+    MVMint64 cores = MVM_platform_cpu_count();
+    MVMint64 loops = (cores + 7) / 8;
+    if (loops < 1)
+        loops = 1;
+    if (loops > MVM_EVENT_LOOP_MAX)
+        loops = MVM_EVENT_LOOP_MAX;
+    return (MVMuint32)loops;
+}
+
 /* Sets up an async task to be done on the loop. */
 static void setup_work(MVMThreadContext *tc) {
-    MVMConcBlockingQueue *queue = (MVMConcBlockingQueue *)tc->instance->event_loop_todo_queue;
+    MVMEventLoop *el = tc->event_loop;
+    MVMConcBlockingQueue *queue = (MVMConcBlockingQueue *)el->todo_queue;
     MVMObject *task_obj;
 
     MVMROOT(tc, queue, {
@@ -21,7 +44,7 @@ static void setup_work(MVMThreadContext *tc) {
             MVM_ASSERT_NOT_FROMSPACE(tc, task);
             if (task->body.state == MVM_ASYNC_TASK_STATE_NEW) {
                 MVMROOT(tc, task, {
-                    task->body.ops->setup(tc, tc->instance->event_loop, task_obj, task->body.data);
+                    task->body.ops->setup(tc, el->loop, task_obj, task->body.data);
                     task->body.state = MVM_ASYNC_TASK_STATE_SETUP;
                 });
             }
@@ -31,7 +54,8 @@ static void setup_work(MVMThreadContext *tc) {
 
 /* Performs an async emit permit grant on the loop. */
 static void permit_work(MVMThreadContext *tc) {
-    MVMConcBlockingQueue *queue = (MVMConcBlockingQueue *)tc->instance->event_loop_permit_queue;
+    MVMEventLoop *el = tc->event_loop;
+    MVMConcBlockingQueue *queue = (MVMConcBlockingQueue *)el->permit_queue;
     MVMObject *task_arr;
 
     MVMROOT(tc, queue, {
@@ -42,7 +66,7 @@ static void permit_work(MVMThreadContext *tc) {
             if (task->body.ops->permit) {
                 MVMint64 channel = MVM_repr_get_int(tc, MVM_repr_at_pos_o(tc, task_arr, 1));
                 MVMint64 permit = MVM_repr_get_int(tc, MVM_repr_at_pos_o(tc, task_arr, 2));
-                task->body.ops->permit(tc, tc->instance->event_loop, task_obj, task->body.data, channel, permit);
+                task->body.ops->permit(tc, el->loop, task_obj, task->body.data, channel, permit);
             }
         }
     });
@@ -50,7 +74,8 @@ static void permit_work(MVMThreadContext *tc) {
 
 /* Performs an async cancellation on the loop. */
 static void cancel_work(MVMThreadContext *tc) {
-    MVMConcBlockingQueue *queue = (MVMConcBlockingQueue *)tc->instance->event_loop_cancel_queue;
+    MVMEventLoop *el = tc->event_loop;
+    MVMConcBlockingQueue *queue = (MVMConcBlockingQueue *)el->cancel_queue;
     MVMObject *task_obj;
 
     MVMROOT(tc, queue, {
@@ -60,7 +85,7 @@ static void cancel_work(MVMThreadContext *tc) {
             if (task->body.state == MVM_ASYNC_TASK_STATE_SETUP) {
                 MVMROOT(tc, task, {
                     if (task->body.ops->cancel)
-                        task->body.ops->cancel(tc, tc->instance->event_loop, task_obj, task->body.data);
+                        task->body.ops->cancel(tc, el->loop, task_obj, task->body.data);
                 });
             }
             task->body.state = MVM_ASYNC_TASK_STATE_CANCELLED;
@@ -80,8 +105,9 @@ static void async_handler(uv_async_t *handle) {
 
 /* Enters the event loop. */
 static void enter_loop(MVMThreadContext *tc, MVMCallsite *callsite, MVMRegister *args) {
-    uv_loop_t    *loop = tc->instance->event_loop;
-    uv_async_t   *async = tc->instance->event_loop_wakeup;
+    MVMEventLoop *el    = tc->event_loop;
+    uv_loop_t    *loop  = el->loop;
+    uv_async_t   *async = el->wakeup;
 
     /* Bind the thread context for the wakeup signal */
     async->data = tc;
@@ -90,14 +116,14 @@ static void enter_loop(MVMThreadContext *tc, MVMCallsite *callsite, MVMRegister
     uv_run(loop, UV_RUN_DEFAULT);
 }
 
-/* Sees if we have an event loop processing thread set up already, and
+/* Sees if the given event loop has a processing thread set up already, and
  * sets it up if not. */
-void MVM_io_eventloop_start(MVMThreadContext *tc) {
+static void start_loop(MVMThreadContext *tc, MVMEventLoop *el) {
     MVMInstance *instance = tc->instance;
     MVMObject *loop_runner;
     unsigned int interval_id;
 
-    if (instance->event_loop_thread)
+    if (el->thread)
         return;
 
     /* Grab starting mutex and ensure we didn't lose the race. */
@@ -110,52 +136,90 @@ void MVM_io_eventloop_start(MVMThreadContext *tc) {
 
     /* We may have lost the race, so we need to setup state carefully */
     /* This may also be present if this is a thread restart */
-    if (!instance->event_loop) {
+    if (!el->loop) {
         /* The underlying loop structure that will handle all IO events. */
-        instance->event_loop              = MVM_malloc(sizeof(uv_loop_t));
-        if (uv_loop_init(instance->event_loop) < 0)
+        el->loop         = MVM_malloc(sizeof(uv_loop_t));
+        if (uv_loop_init(el->loop) < 0)
             MVM_panic(1, "Unable to initialize event loop");
+        el->loop->data  = el;
 
         /* The async signal handler for waking up the thread */
-        instance->event_loop_wakeup       = MVM_malloc(sizeof(uv_async_t));
-        if (uv_async_init(instance->event_loop, instance->event_loop_wakeup, async_handler) != 0)
+        el->wakeup       = MVM_malloc(sizeof(uv_async_t));
+        if (uv_async_init(el->loop, el->wakeup, async_handler) != 0)
             MVM_panic(1, "Unable to initialize async wake-up handle for event loop");
 
+        /* If wanted, try for an io_uring; we just go without if the kernel
+         * won't give us one. */
+        if (instance->use_io_uring)
+            el->uring = MVM_io_uring_create(tc, el->loop);
+
         /* Create various bits of state the async event loop thread needs. */
-        instance->event_loop_todo_queue   = MVM_repr_alloc_init(tc,
+        el->todo_queue   = MVM_repr_alloc_init(tc,
             instance->boot_types.BOOTQueue);
-        instance->event_loop_permit_queue = MVM_repr_alloc_init(tc,
+        el->permit_queue = MVM_repr_alloc_init(tc,
             instance->boot_types.BOOTQueue);
-        instance->event_loop_cancel_queue = MVM_repr_alloc_init(tc,
+        el->cancel_queue = MVM_repr_alloc_init(tc,
             instance->boot_types.BOOTQueue);
-        instance->event_loop_active       = MVM_repr_alloc_init(tc,
+        el->active       = MVM_repr_alloc_init(tc,
             instance->boot_types.BOOTArray);
-        instance->event_loop_free_indices = MVM_repr_alloc_init(tc,
+        el->free_indices = MVM_repr_alloc_init(tc,
             instance->boot_types.BOOTIntArray);
     }
 
-    if (!instance->event_loop_thread) {
+    if (!el->thread) {
         /* Start the event loop thread, which will call a C function that
          * sits in the uv loop, never leaving until it is stopped from the
          * outside */
+        MVMThread *thread;
         loop_runner = MVM_repr_alloc_init(tc, instance->boot_types.BOOTCCode);
         ((MVMCFunction *)loop_runner)->body.func = enter_loop;
 
-        instance->event_loop_thread = MVM_thread_new(tc, loop_runner, 1);
-        MVM_thread_run(tc, instance->event_loop_thread);
+        thread = (MVMThread *)MVM_thread_new(tc, loop_runner, 1);
+        thread->body.tc->event_loop = el;
+        el->thread = (MVMObject *)thread;
+        MVM_thread_run(tc, el->thread);
     }
 
     MVM_telemetry_interval_stop(tc, interval_id, "created the event loop thread");
     uv_mutex_unlock(&instance->mutex_event_loop);
 }
 
+/* Starts threads for all of the event loops that have been set up but
+ * aren't running, as is needed after a fork. */
+void MVM_io_eventloop_start(MVMThreadContext *tc) {
+    MVMInstance *instance = tc->instance;
+    MVMuint32 i;
+    for (i = 0; i < instance->num_event_loops; i++)
+        if (instance->event_loops[i].loop)
+            start_loop(tc, &instance->event_loops[i]);
+}
+
+/* Picks the next event loop in turn, for a task or for a handle whose tasks
+ * must all run on the same loop. */
+MVMEventLoop * MVM_io_eventloop_pick(MVMThreadContext *tc) {
+    MVMInstance *instance = tc->instance;
+    MVMuint32    idx      = instance->num_event_loops > 1
+        ? (MVMuint32)(MVM_incr(&instance->next_event_loop) % instance->num_event_loops)
+        : 0;
+    return &instance->event_loops[idx];
+}
 
-/* Adds a work item into the event loop work queue. */
+/* Gets the loop a task will run on, picking the next one in turn if it
+ * has not been given one already, and makes sure that loop is running. */
+static MVMEventLoop * loop_for_task(MVMThreadContext *tc, MVMAsyncTask *task) {
+    MVMEventLoop *el = task->body.loop;
+    if (!el)
+        el = task->body.loop = MVM_io_eventloop_pick(tc);
+    start_loop(tc, el);
+    return el;
+}
+
+/* Adds a work item into the work queue of its event loop. */
 void MVM_io_eventloop_queue_work(MVMThreadContext *tc, MVMObject *work) {
     MVMROOT(tc, work, {
-        MVM_io_eventloop_start(tc);
-        MVM_repr_push_o(tc, tc->instance->event_loop_todo_queue, work);
-        uv_async_send(tc->instance->event_loop_wakeup);
+        MVMEventLoop *el = loop_for_task(tc, (MVMAsyncTask *)work);
+        MVM_repr_push_o(tc, el->todo_queue, work);
+        uv_async_send(el->wakeup);
     });
 }
 
@@ -171,15 +235,16 @@ void MVM_io_eventloop_permit(MVMThreadContext *tc, MVMObject *task_obj,
             MVMObject *permits_box = NULL;
             MVMObject *arr = NULL;
             MVMROOT3(tc, channel_box, permits_box, arr, {
+                MVMEventLoop *el;
                 channel_box = MVM_repr_box_int(tc, tc->instance->boot_types.BOOTInt, channel);
                 permits_box = MVM_repr_box_int(tc, tc->instance->boot_types.BOOTInt, permits);
                 arr = MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTArray);
                 MVM_repr_push_o(tc, arr, task_obj);
                 MVM_repr_push_o(tc, arr, channel_box);
                 MVM_repr_push_o(tc, arr, permits_box);
-                MVM_io_eventloop_start(tc);
-                MVM_repr_push_o(tc, tc->instance->event_loop_permit_queue, arr);
-                uv_async_send(tc->instance->event_loop_wakeup);
+                el = loop_for_task(tc, (MVMAsyncTask *)task_obj);
+                MVM_repr_push_o(tc, el->permit_queue, arr);
+                uv_async_send(el->wakeup);
             });
         });
     }
@@ -200,9 +265,9 @@ void MVM_io_eventloop_cancel_work(MVMThreadContext *tc, MVMObject *task_obj,
                 notify_schedulee);
         }
         MVMROOT(tc, task_obj, {
-            MVM_io_eventloop_start(tc);
-            MVM_repr_push_o(tc, tc->instance->event_loop_cancel_queue, task_obj);
-            uv_async_send(tc->instance->event_loop_wakeup);
+            MVMEventLoop *el = loop_for_task(tc, (MVMAsyncTask *)task_obj);
+            MVM_repr_push_o(tc, el->cancel_queue, task_obj);
+            uv_async_send(el->wakeup);
         });
     }
     else {
@@ -218,20 +283,23 @@ void MVM_io_eventloop_send_cancellation_notification(MVMThreadContext *tc, MVMAs
         MVM_repr_push_o(tc, notify_queue, notify_schedulee);
 }
 
-/* Adds a work item to the active async task set. */
+/* Adds a work item to the active async task set of the event loop that the
+ * current thread runs. */
 int MVM_io_eventloop_add_active_work(MVMThreadContext *tc, MVMObject *async_task) {
-    int work_idx = MVM_repr_elems(tc, tc->instance->event_loop_free_indices) > 0
-        ? MVM_repr_pop_i(tc, tc->instance->event_loop_free_indices)
-        : MVM_repr_elems(tc, tc->instance->event_loop_active);
+    MVMEventLoop *el = tc->event_loop;
+    int work_idx = MVM_repr_elems(tc, el->free_indices) > 0
+        ? MVM_repr_pop_i(tc, el->free_indices)
+        : MVM_repr_elems(tc, el->active);
     MVM_ASSERT_NOT_FROMSPACE(tc, async_task);
-    MVM_repr_bind_pos_o(tc, tc->instance->event_loop_active, work_idx, async_task);
+    MVM_repr_bind_pos_o(tc, el->active, work_idx, async_task);
     return work_idx;
 }
 
 /* Gets an active work item from the active work eventloop. */
 MVMAsyncTask * MVM_io_eventloop_get_active_work(MVMThreadContext *tc, int work_idx) {
-    if (work_idx >= 0 && work_idx < MVM_repr_elems(tc, tc->instance->event_loop_active)) {
-        MVMObject *task_obj = MVM_repr_at_pos_o(tc, tc->instance->event_loop_active, work_idx);
+    MVMEventLoop *el = tc->event_loop;
+    if (work_idx >= 0 && work_idx < MVM_repr_elems(tc, el->active)) {
+        MVMObject *task_obj = MVM_repr_at_pos_o(tc, el->active, work_idx);
         if (REPR(task_obj)->ID != MVM_REPR_ID_MVMAsyncTask)
             MVM_panic(1, "non-AsyncTask fetched from eventloop active work list");
         MVM_ASSERT_NOT_FROMSPACE(tc, task_obj);
@@ -246,61 +314,168 @@ MVMAsyncTask * MVM_io_eventloop_get_active_work(MVMThreadContext *tc, int work_i
  * memory associated with it to be collected. Replaces the work index with -1
  * so that any future use of the task will be a failed lookup. */
 void MVM_io_eventloop_remove_active_work(MVMThreadContext *tc, int *work_idx_to_clear) {
+    MVMEventLoop *el = tc->event_loop;
     int work_idx = *work_idx_to_clear;
-    if (work_idx >= 0 && work_idx < MVM_repr_elems(tc, tc->instance->event_loop_active)) {
+    if (work_idx >= 0 && work_idx < MVM_repr_elems(tc, el->active)) {
         *work_idx_to_clear = -1;
-        MVM_repr_bind_pos_o(tc, tc->instance->event_loop_active, work_idx, tc->instance->VMNull);
-        MVM_repr_push_i(tc, tc->instance->event_loop_free_indices, work_idx);
+        MVM_repr_bind_pos_o(tc, el->active, work_idx, tc->instance->VMNull);
+        MVM_repr_push_i(tc, el->free_indices, work_idx);
     }
     else {
         MVM_panic(1, "cannot remove invalid eventloop work item index %d", work_idx);
     }
 }
 
+/* Gets a buffer to read into, taking one from the loop's pool if there is
+ * one. Buffers are always the same size, so that they can be reused for any
+ * read. */
+void MVM_io_eventloop_take_read_buffer(uv_loop_t *loop, uv_buf_t *buf) {
+    MVMEventLoop *el = (MVMEventLoop *)loop->data;
+    buf->base = el->num_read_buffers
+        ? el->read_buffers[--el->num_read_buffers]
+        : MVM_malloc(MVM_IO_READ_BUFFER_SIZE);
+    buf->len  = MVM_IO_READ_BUFFER_SIZE;
+}
+
+/* The same, in the form of a uv_alloc_cb; libuv's suggested size is
+ * ignored. */
+void MVM_io_eventloop_alloc_read_buffer(uv_handle_t *handle, size_t suggested_size, uv_buf_t *buf) {
+    MVM_io_eventloop_take_read_buffer(handle->loop, buf);
+}
+
+/* Gives a read buffer that's no longer needed back to the loop's pool, or
+ * frees it if the pool is full. */
+void MVM_io_eventloop_release_read_buffer(uv_loop_t *loop, const uv_buf_t *buf) {
+    MVMEventLoop *el = (MVMEventLoop *)loop->data;
+    if (!buf->base)
+        return;
+    if (el->num_read_buffers < MVM_IO_READ_BUFFER_POOL)
+        el->read_buffers[el->num_read_buffers++] = buf->base;
+    else
+        MVM_free(buf->base);
+}
 
+/* Reduces the nursery space left by the amount of memory we're handing to
+ * a GC-managed object, so that lots of reads lead to a GC run that can free
+ * the buffers again. */
+static void account_read_buffer(MVMThreadContext *tc, size_t size) {
+    size_t adjustment = (size < 32768 ? size : 32768) & ~0x7;
+    if (adjustment && (char *)tc->nursery_alloc_limit - adjustment > (char *)tc->nursery_alloc)
+        tc->nursery_alloc_limit = (char *)(tc->nursery_alloc_limit) - adjustment;
+}
+
+/* Produces a buffer of the given type holding the nread bytes that were read
+ * into buf. A buffer that's at least half full is handed over as the array's
+ * storage; otherwise the data is copied into storage of exactly the right
+ * size and the buffer goes back to the pool, so that many small reads don't
+ * each keep a mostly empty buffer alive. */
+MVMObject * MVM_io_eventloop_read_buffer_result(MVMThreadContext *tc, uv_loop_t *loop,
+        MVMObject *buf_type, const uv_buf_t *buf, ssize_t nread) {
+    MVMArray *res_buf;
+    if ((size_t)nread < buf->len / 2) {
+        MVMObject *result = MVM_io_eventloop_copy_read_result(tc, buf_type, buf->base, nread);
+        MVM_io_eventloop_release_read_buffer(loop, buf);
+        return result;
+    }
+    res_buf = (MVMArray *)MVM_repr_alloc_init(tc, buf_type);
+    res_buf->body.slots.i8 = (MVMint8 *)buf->base;
+    res_buf->body.ssize    = buf->len;
+    res_buf->body.start    = 0;
+    res_buf->body.elems    = nread;
+    account_read_buffer(tc, res_buf->body.ssize);
+    return (MVMObject *)res_buf;
+}
+
+/* Produces a buffer of the given type holding a copy of the nread bytes
+ * of data, for when the memory read into can't be handed over. */
+MVMObject * MVM_io_eventloop_copy_read_result(MVMThreadContext *tc, MVMObject *buf_type,
+        const char *data, ssize_t nread) {
+    MVMArray *res_buf = (MVMArray *)MVM_repr_alloc_init(tc, buf_type);
+    if (nread > 0) {
+        res_buf->body.slots.i8 = MVM_malloc(nread);
+        memcpy(res_buf->body.slots.i8, data, nread);
+    }
+    res_buf->body.ssize = nread;
+    res_buf->body.start = 0;
+    res_buf->body.elems = nread;
+    account_read_buffer(tc, nread);
+    return (MVMObject *)res_buf;
+}
+
+/* Checks if a thread context belongs to one of the event loop threads. */
+MVMint32 MVM_io_eventloop_is_loop_thread(MVMThreadContext *tc, MVMuint32 thread_id) {
+    MVMInstance *instance = tc->instance;
+    MVMuint32 i;
+    for (i = 0; i < instance->num_event_loops; i++) {
+        MVMThread *thread = (MVMThread *)instance->event_loops[i].thread;
+        if (thread != NULL && thread_id == thread->body.tc->thread_id)
+            return 1;
+    }
+    return 0;
+}
+
+/* Wakes up all running event loops, so that they take part in GC. */
+void MVM_io_eventloop_wake_all(MVMThreadContext *tc) {
+    MVMInstance *instance = tc->instance;
+    MVMuint32 i;
+    for (i = 0; i < instance->num_event_loops; i++)
+        if (instance->event_loops[i].wakeup)
+            uv_async_send(instance->event_loops[i].wakeup);
+}
 
 /* Send the stop signal - no synchronization required */
 void MVM_io_eventloop_stop(MVMThreadContext *tc) {
     MVMInstance *instance = tc->instance;
-    if (!instance->event_loop_thread)
-        return;
-    /* Stop the loop */
-    uv_stop(instance->event_loop);
-    uv_async_send(instance->event_loop_wakeup);
+    MVMuint32 i;
+    for (i = 0; i < instance->num_event_loops; i++) {
+        MVMEventLoop *el = &instance->event_loops[i];
+        if (!el->thread)
+            continue;
+        /* Stop the loop */
+        uv_stop(el->loop);
+        uv_async_send(el->wakeup);
+    }
 }
 
 /* Wait for exit (again, no synchronizaiton required) */
 void MVM_io_eventloop_join(MVMThreadContext *tc) {
     MVMInstance *instance = tc->instance;
-    if (!instance->event_loop_thread)
-        return;
-    MVM_thread_join(tc, instance->event_loop_thread);
+    MVMuint32 i;
+    for (i = 0; i < instance->num_event_loops; i++)
+        if (instance->event_loops[i].thread)
+            MVM_thread_join(tc, instance->event_loops[i].thread);
 }
 
 /* Clean up used resources. Synchronization required - other threads might modify them as well */
 void MVM_io_eventloop_destroy(MVMThreadContext *tc) {
     MVMInstance *instance = tc->instance;
+    MVMuint32 i;
     MVM_gc_mark_thread_blocked(tc);
     uv_mutex_lock(&instance->mutex_event_loop);
     MVM_gc_mark_thread_unblocked(tc);
 
-    if (instance->event_loop_thread) {
-        MVM_io_eventloop_stop(tc);
-        MVM_io_eventloop_join(tc);
-        instance->event_loop_thread = NULL;
-    }
+    MVM_io_eventloop_stop(tc);
+    MVM_io_eventloop_join(tc);
+
+    for (i = 0; i < instance->num_event_loops; i++) {
+        MVMEventLoop *el = &instance->event_loops[i];
+        el->thread = NULL;
+        while (el->num_read_buffers)
+            MVM_free(el->read_buffers[--el->num_read_buffers]);
+        if (el->loop) {
+            MVM_io_uring_destroy(el->uring);
+            el->uring = NULL;
+            uv_close((uv_handle_t*)el->wakeup, NULL);
+
+            /* Not sure we can always do this */
+            uv_loop_close(el->loop);
 
-    if (instance->event_loop) {
-        uv_close((uv_handle_t*)instance->event_loop_wakeup, NULL);
-
-        /* Not sure we can always do this */
-        uv_loop_close(instance->event_loop);
-       
-        MVM_free(instance->event_loop_wakeup);
-        instance->event_loop_wakeup = NULL;
-        
-        MVM_free(instance->event_loop);
-        instance->event_loop = NULL;
+            MVM_free(el->wakeup);
+            el->wakeup = NULL;
+
+            MVM_free(el->loop);
+            el->loop = NULL;
+        }
     }
 
     uv_mutex_unlock(&instance->mutex_event_loop);
@@ -18,6 +18,38 @@ struct MVMAsyncTaskOps {
     void (*gc_free) (MVMThreadContext *tc, MVMObject *t, void *data);
 };
 
+/* Reads on the event loop go into buffers of this size, and up to this many
+ * of them are kept around for reuse by each loop. */
+#define MVM_IO_READ_BUFFER_SIZE 65536
+#define MVM_IO_READ_BUFFER_POOL 32
+
+/* An event loop, the thread that runs it, and the state it needs: concurrent
+ * queues of tasks to set up, grant emit permits to and cancel, and an array
+ * of the tasks active on it, for the purpose of keeping them GC marked. */
+struct MVMEventLoop {
+    MVMObject  *thread;
+    uv_loop_t  *loop;
+    uv_async_t *wakeup;
+    MVMObject  *todo_queue;
+    MVMObject  *permit_queue;
+    MVMObject  *cancel_queue;
+    MVMObject  *active;
+    MVMObject  *free_indices;
+
+    /* Read buffers that are free for reuse; only used on the loop's own
+     * thread, so needs no locking. */
+    char       *read_buffers[MVM_IO_READ_BUFFER_POOL];
+    MVMuint32   num_read_buffers;
+
+    /* The loop's io_uring, if there is one. */
+    MVMIOUring *uring;
+};
+
+/* Upper limit on the number of event loops. */
+#define MVM_EVENT_LOOP_MAX 64
+
+MVMuint32 MVM_io_eventloop_default_count(void);
+MVMEventLoop * MVM_io_eventloop_pick(MVMThreadContext *tc);
 void MVM_io_eventloop_queue_work(MVMThreadContext *tc, MVMObject *work);
 void MVM_io_eventloop_permit(MVMThreadContext *tc, MVMObject *task_obj,
     MVMint64 channel, MVMint64 permits);
@@ -28,6 +60,16 @@ void MVM_io_eventloop_send_cancellation_notification(MVMThreadContext *tc, MVMAs
 int MVM_io_eventloop_add_active_work(MVMThreadContext *tc, MVMObject *async_task);
 MVMAsyncTask * MVM_io_eventloop_get_active_work(MVMThreadContext *tc, int work_idx);
 void MVM_io_eventloop_remove_active_work(MVMThreadContext *tc, int *work_idx_to_clear);
+void MVM_io_eventloop_take_read_buffer(uv_loop_t *loop, uv_buf_t *buf);
+void MVM_io_eventloop_alloc_read_buffer(uv_handle_t *handle, size_t suggested_size, uv_buf_t *buf);
+void MVM_io_eventloop_release_read_buffer(uv_loop_t *loop, const uv_buf_t *buf);
+MVMObject * MVM_io_eventloop_read_buffer_result(MVMThreadContext *tc, uv_loop_t *loop,
+    MVMObject *buf_type, const uv_buf_t *buf, ssize_t nread);
+MVMObject * MVM_io_eventloop_copy_read_result(MVMThreadContext *tc, MVMObject *buf_type,
+    const char *data, ssize_t nread);
+
+MVMint32 MVM_io_eventloop_is_loop_thread(MVMThreadContext *tc, MVMuint32 thread_id);
+void MVM_io_eventloop_wake_all(MVMThreadContext *tc);
 
 void MVM_io_eventloop_start(MVMThreadContext *tc);
 void MVM_io_eventloop_stop(MVMThreadContext *tc);
@@ -126,13 +126,62 @@ void MVM_io_read_bytes(MVMThreadContext *tc, MVMObject *oshandle, MVMObject *res
     else
         MVM_exception_throw_adhoc(tc, "Cannot read characters from this kind of handle");
 
-    /* Stash the data in the VMArray. */
+    /* Stash the data in the VMArray, freeing what it held before. */
+    MVM_free(((MVMArray *)result)->body.slots.i8);
     ((MVMArray *)result)->body.slots.i8 = (MVMint8 *)buf;
     ((MVMArray *)result)->body.start    = 0;
     ((MVMArray *)result)->body.ssize    = bytes_read;
     ((MVMArray *)result)->body.elems    = bytes_read;
 }
 
+/* Reads up to length bytes into an existing buffer, starting at the given
+ * offset, and returns how many were read. The buffer is grown if needed and
+ * then left with offset plus that many elements; since it keeps its storage,
+ * reading into the same buffer over and over doesn't allocate. */
+MVMint64 MVM_io_read_bytes_into(MVMThreadContext *tc, MVMObject *oshandle, MVMObject *buffer,
+        MVMint64 offset, MVMint64 length) {
+    MVMOSHandle *handle = verify_is_handle(tc, oshandle, "read bytes");
+    MVMint64 bytes_read;
+
+    /* Ensure the target is in the correct form. */
+    if (!IS_CONCRETE(buffer) || REPR(buffer)->ID != MVM_REPR_ID_VMArray)
+        MVM_exception_throw_adhoc(tc, "readinto_fhb requires a native array to write to");
+    if (((MVMArrayREPRData *)STABLE(buffer)->REPR_data)->slot_type != MVM_ARRAY_U8
+        && ((MVMArrayREPRData *)STABLE(buffer)->REPR_data)->slot_type != MVM_ARRAY_I8)
+        MVM_exception_throw_adhoc(tc, "readinto_fhb requires a native array of uint8 or int8");
+
+    if (length < 1)
+        MVM_exception_throw_adhoc(tc, "Out of range: attempted to read %"PRId64" bytes from filehandle", length);
+    if (offset < 0 || (MVMuint64)offset > ((MVMArray *)buffer)->body.elems)
+        MVM_exception_throw_adhoc(tc, "Out of range: attempted to read into buffer at offset %"PRId64, offset);
+
+    if (handle->body.ops->sync_readable) {
+        MVMROOT2(tc, handle, buffer, {
+            uv_mutex_t *mutex = acquire_mutex(tc, handle);
+            MVMArrayBody *body;
+            MVM_repr_pos_set_elems(tc, buffer, offset + length);
+            body = &((MVMArray *)buffer)->body;
+            if (handle->body.ops->sync_readable->read_bytes_into) {
+                bytes_read = handle->body.ops->sync_readable->read_bytes_into(tc, handle,
+                    (char *)(body->slots.i8 + body->start + offset), length);
+            }
+            else {
+                char *buf;
+                bytes_read = handle->body.ops->sync_readable->read_bytes(tc, handle, &buf, length);
+                if (bytes_read > 0)
+                    memcpy(body->slots.i8 + body->start + offset, buf, bytes_read);
+                MVM_free(buf);
+            }
+            MVM_repr_pos_set_elems(tc, buffer, offset + bytes_read);
+            release_mutex(tc, mutex);
+        });
+    }
+    else
+        MVM_exception_throw_adhoc(tc, "Cannot read characters from this kind of handle");
+
+    return bytes_read;
+}
+
 void MVM_io_write_bytes(MVMThreadContext *tc, MVMObject *oshandle, MVMObject *buffer) {
     MVMOSHandle *handle = verify_is_handle(tc, oshandle, "write bytes");
     char *output;
@@ -165,6 +214,209 @@ void MVM_io_write_bytes(MVMThreadContext *tc, MVMObject *oshandle, MVMObject *bu
         MVM_exception_throw_adhoc(tc, "Cannot write bytes to this kind of handle");
 }
 
+/* Writes length elements of a buffer, starting at the given offset, so that
+ * callers can write part of a buffer without copying it out first. */
+void MVM_io_write_bytes_slice(MVMThreadContext *tc, MVMObject *oshandle, MVMObject *buffer,
+        MVMint64 offset, MVMint64 length) {
+    MVMOSHandle *handle = verify_is_handle(tc, oshandle, "write bytes");
+    MVMArrayBody *body;
+    MVMint64 elem_size;
+
+    /* Ensure the target is in the correct form. */
+    if (!IS_CONCRETE(buffer) || REPR(buffer)->ID != MVM_REPR_ID_VMArray)
+        MVM_exception_throw_adhoc(tc, "writeslice_fhb requires a native array to read from");
+    switch (((MVMArrayREPRData *)STABLE(buffer)->REPR_data)->slot_type) {
+        case MVM_ARRAY_U8:
+        case MVM_ARRAY_I8:
+            elem_size = 1;
+            break;
+        case MVM_ARRAY_U16:
+        case MVM_ARRAY_I16:
+            elem_size = sizeof(MVMuint16);
+            break;
+        default:
+            MVM_exception_throw_adhoc(tc, "writeslice_fhb requires a native array of uint8, int8, uint16 or int16");
+    }
+    body = &((MVMArray *)buffer)->body;
+    if (offset < 0 || length < 0 || (MVMuint64)offset > body->elems
+            || (MVMuint64)length > body->elems - offset)
+        MVM_exception_throw_adhoc(tc,
+            "Out of range: attempted to write %"PRId64" elements at offset %"PRId64" of a buffer with %"PRIu64,
+            length, offset, body->elems);
+
+    MVM_io_write_bytes_c(tc, oshandle,
+        (char *)(body->slots.i8 + (body->start + offset) * elem_size),
+        length * elem_size);
+}
+
+/* Moves bytes from one handle to another without them ever becoming a VM
+ * buffer; where the source can hand them straight to the destination's
+ * descriptor, the kernel does the copying. A negative length means until
+ * the source reaches EOF. Returns the number of bytes moved. */
+#define TRANSFER_BUFFER_SIZE 65536
+MVMint64 MVM_io_transfer(MVMThreadContext *tc, MVMObject *dest, MVMObject *source, MVMint64 length) {
+    MVMOSHandle *dest_handle   = verify_is_handle(tc, dest, "transfer bytes");
+    MVMOSHandle *source_handle = verify_is_handle(tc, source, "transfer bytes");
+    MVMint64     total         = 0;
+    MVMint64     fd            = -1;
+    int          use_fd;
+    if (!source_handle->body.ops->sync_readable)
+        MVM_exception_throw_adhoc(tc, "Cannot transfer bytes from this kind of handle");
+    if (!dest_handle->body.ops->sync_writable)
+        MVM_exception_throw_adhoc(tc, "Cannot transfer bytes to this kind of handle");
+#ifdef _WIN32
+    /* Sockets don't have C runtime descriptors that could be written to. */
+    use_fd = 0;
+#else
+    use_fd = source_handle->body.ops->sync_readable->transfer_to
+        && dest_handle->body.ops->introspection;
+#endif
+
+    MVMROOT2(tc, dest_handle, source_handle, {
+        /* The destination's own buffered output has to go out first. Only
+         * one handle is locked at a time, so that two transfers going in
+         * opposite directions can't deadlock. */
+        if (use_fd) {
+            uv_mutex_t *mutex = acquire_mutex(tc, dest_handle);
+            dest_handle->body.ops->sync_writable->flush(tc, dest_handle, 0);
+            fd = dest_handle->body.ops->introspection->native_descriptor(tc, dest_handle);
+            release_mutex(tc, mutex);
+        }
+        if (fd >= 0) {
+            uv_mutex_t *mutex = acquire_mutex(tc, source_handle);
+            total = source_handle->body.ops->sync_readable->transfer_to(tc,
+                source_handle, (int)fd, length);
+            release_mutex(tc, mutex);
+            if (total > 0 && dest_handle->body.ops->sync_writable->wrote_to_descriptor) {
+                mutex = acquire_mutex(tc, dest_handle);
+                dest_handle->body.ops->sync_writable->wrote_to_descriptor(tc, dest_handle, total);
+                release_mutex(tc, mutex);
+            }
+        }
+
+        /* Otherwise, go through the handles a chunk at a time. The chunks
+         * pass through a buffer kept by the thread, so that nothing is
+         * leaked if writing one throws. */
+        if (fd < 0 && !tc->io_transfer_buffer)
+            tc->io_transfer_buffer = MVM_malloc(TRANSFER_BUFFER_SIZE);
+        while (fd < 0 && (length < 0 || total < length)) {
+            const MVMIOSyncReadable *readable = source_handle->body.ops->sync_readable;
+            MVMint64 want = length < 0 || length - total > TRANSFER_BUFFER_SIZE
+                ? TRANSFER_BUFFER_SIZE
+                : length - total;
+            MVMint64 got;
+            uv_mutex_t *mutex = acquire_mutex(tc, source_handle);
+            if (readable->read_bytes_into) {
+                got = readable->read_bytes_into(tc, source_handle, tc->io_transfer_buffer, want);
+            }
+            else {
+                char *buf = NULL;
+                got = readable->read_bytes(tc, source_handle, &buf, want);
+                if (got > 0)
+                    memcpy(tc->io_transfer_buffer, buf, got);
+                MVM_free(buf);
+            }
+            release_mutex(tc, mutex);
+            if (got <= 0)
+                break;
+            mutex = acquire_mutex(tc, dest_handle);
+            dest_handle->body.ops->sync_writable->write_bytes(tc, dest_handle,
+                tc->io_transfer_buffer, got);
+            release_mutex(tc, mutex);
+            total += got;
+        }
+    });
+    return total;
+}
+
+/* Starts writing bytes from a source handle to an asynchronous handle,
+ * taking them straight from the source's descriptor. The source mustn't
+ * be closed until the transfer completes. */
+MVMObject * MVM_io_transfer_async(MVMThreadContext *tc, MVMObject *dest, MVMObject *queue,
+                                  MVMObject *schedulee, MVMObject *source, MVMint64 length,
+                                  MVMObject *async_type) {
+    MVMOSHandle *dest_handle   = verify_is_handle(tc, dest, "transfer bytes asynchronously");
+    MVMOSHandle *source_handle = verify_is_handle(tc, source, "transfer bytes asynchronously");
+    MVMObject   *result;
+    MVMint64     fd;
+    if (!dest_handle->body.ops->async_writable || !dest_handle->body.ops->async_writable->transfer_from)
+        MVM_exception_throw_adhoc(tc, "Cannot transfer bytes asynchronously to this kind of handle");
+    if (!source_handle->body.ops->sync_readable || !source_handle->body.ops->sync_readable->transfer_to
+            || !source_handle->body.ops->introspection)
+        MVM_exception_throw_adhoc(tc, "Cannot transfer bytes asynchronously from this kind of handle");
+    MVMROOT5(tc, queue, schedulee, source_handle, async_type, dest_handle, {
+        uv_mutex_t *mutex;
+        fd = MVM_io_fileno(tc, (MVMObject *)source_handle);
+        if (fd < 0)
+            MVM_exception_throw_adhoc(tc, "Cannot transfer bytes asynchronously from a closed handle");
+        mutex = acquire_mutex(tc, dest_handle);
+        result = (MVMObject *)dest_handle->body.ops->async_writable->transfer_from(tc,
+            dest_handle, queue, schedulee, source_handle, (int)fd, length, async_type);
+        release_mutex(tc, mutex);
+    });
+    return result;
+}
+
+/* Checks that a list of buffers to write holds only native arrays of uint8
+ * or int8, returning how many there are. */
+MVMint64 MVM_io_buffer_list_count(MVMThreadContext *tc, MVMObject *buffers, const char *op) {
+    MVMint64 num, i;
+    if (!IS_CONCRETE(buffers) || REPR(buffers)->ID != MVM_REPR_ID_VMArray
+            || ((MVMArrayREPRData *)STABLE(buffers)->REPR_data)->slot_type != MVM_ARRAY_OBJ)
+        MVM_exception_throw_adhoc(tc, "%s requires a list of buffers", op);
+    num = MVM_repr_elems(tc, buffers);
+    for (i = 0; i < num; i++)
+        MVM_io_buffer_list_at(tc, buffers, i, op);
+    return num;
+}
+
+/* Gets a buffer from a list of them, checking that it is a byte array. */
+MVMObject * MVM_io_buffer_list_get(MVMThreadContext *tc, MVMObject *buffers, MVMint64 i, const char *op) {
+    MVMObject *buffer = MVM_repr_at_pos_o(tc, buffers, i);
+    if (!IS_CONCRETE(buffer) || REPR(buffer)->ID != MVM_REPR_ID_VMArray)
+        MVM_exception_throw_adhoc(tc, "%s requires a list of native arrays", op);
+    if (((MVMArrayREPRData *)STABLE(buffer)->REPR_data)->slot_type != MVM_ARRAY_U8
+        && ((MVMArrayREPRData *)STABLE(buffer)->REPR_data)->slot_type != MVM_ARRAY_I8)
+        MVM_exception_throw_adhoc(tc, "%s requires a list of native arrays of uint8 or int8", op);
+    return buffer;
+}
+
+/* Gets where the data of a buffer in a list of them is. */
+uv_buf_t MVM_io_buffer_list_at(MVMThreadContext *tc, MVMObject *buffers, MVMint64 i, const char *op) {
+    MVMArrayBody *body = &((MVMArray *)MVM_io_buffer_list_get(tc, buffers, i, op))->body;
+    return uv_buf_init((char *)(body->slots.i8 + body->start), (unsigned int)body->elems);
+}
+
+/* Writes a list of buffers, handing them to the handle a batch at a time so
+ * that it can write each batch with a single system call. */
+#define WRITEV_BATCH 16
+void MVM_io_write_bytes_vec(MVMThreadContext *tc, MVMObject *oshandle, MVMObject *buffers) {
+    MVMOSHandle *handle = verify_is_handle(tc, oshandle, "write bytes");
+    MVMint64 num = MVM_io_buffer_list_count(tc, buffers, "writev_fhb");
+    if (handle->body.ops->sync_writable) {
+        MVMROOT2(tc, handle, buffers, {
+            uv_mutex_t *mutex = acquire_mutex(tc, handle);
+            const MVMIOSyncWritable *writable = handle->body.ops->sync_writable;
+            uv_buf_t bufs[WRITEV_BATCH];
+            MVMint64 i = 0;
+            while (i < num) {
+                MVMuint32 n = 0;
+                MVMuint32 j;
+                while (n < WRITEV_BATCH && i < num)
+                    bufs[n++] = MVM_io_buffer_list_at(tc, buffers, i++, "writev_fhb");
+                if (writable->write_bytes_vec)
+                    writable->write_bytes_vec(tc, handle, bufs, n);
+                else
+                    for (j = 0; j < n; j++)
+                        writable->write_bytes(tc, handle, bufs[j].base, bufs[j].len);
+            }
+            release_mutex(tc, mutex);
+        });
+    }
+    else
+        MVM_exception_throw_adhoc(tc, "Cannot write bytes to this kind of handle");
+}
+
 void MVM_io_write_bytes_c(MVMThreadContext *tc, MVMObject *oshandle, char *output,
                           MVMuint64 output_size) {
     MVMOSHandle *handle = verify_is_handle(tc, oshandle, "write bytes");
@@ -196,6 +448,26 @@ MVMObject * MVM_io_read_bytes_async(MVMThreadContext *tc, MVMObject *oshandle, M
         MVM_exception_throw_adhoc(tc, "Cannot read bytes asynchronously from this kind of handle");
 }
 
+MVMObject * MVM_io_read_batch_async(MVMThreadContext *tc, MVMObject *oshandle, MVMObject *queue,
+                                    MVMObject *schedulee, MVMObject *buf_type, MVMint64 max,
+                                    MVMObject *async_type) {
+    MVMOSHandle *handle = verify_is_handle(tc, oshandle, "read datagrams asynchronously");
+    if (max < 1)
+        MVM_exception_throw_adhoc(tc, "Batch size for reading datagrams must be at least 1 (got %"PRId64")", max);
+    if (handle->body.ops->async_readable && handle->body.ops->async_readable->read_datagrams) {
+        MVMObject *result;
+        MVMROOT5(tc, queue, schedulee, buf_type, async_type, handle, {
+            uv_mutex_t *mutex = acquire_mutex(tc, handle);
+            result = (MVMObject *)handle->body.ops->async_readable->read_datagrams(tc,
+                handle, queue, schedulee, buf_type, max, async_type);
+            release_mutex(tc, mutex);
+        });
+        return result;
+    }
+    else
+        MVM_exception_throw_adhoc(tc, "Cannot read datagrams in batches from this kind of handle");
+}
+
 MVMObject * MVM_io_write_bytes_async(MVMThreadContext *tc, MVMObject *oshandle, MVMObject *queue,
                                      MVMObject *schedulee, MVMObject *buffer, MVMObject *async_type) {
     MVMOSHandle *handle = verify_is_handle(tc, oshandle, "write buffer asynchronously");
@@ -215,6 +487,24 @@ MVMObject * MVM_io_write_bytes_async(MVMThreadContext *tc, MVMObject *oshandle,
         MVM_exception_throw_adhoc(tc, "Cannot write bytes asynchronously to this kind of handle");
 }
 
+MVMObject * MVM_io_write_bytes_vec_async(MVMThreadContext *tc, MVMObject *oshandle, MVMObject *queue,
+                                         MVMObject *schedulee, MVMObject *buffers, MVMObject *async_type) {
+    MVMOSHandle *handle = verify_is_handle(tc, oshandle, "write buffers asynchronously");
+    MVM_io_buffer_list_count(tc, buffers, "asyncwritevbytes");
+    if (handle->body.ops->async_writable && handle->body.ops->async_writable->write_bytes_vec) {
+        MVMObject *result;
+        MVMROOT5(tc, queue, schedulee, buffers, async_type, handle, {
+            uv_mutex_t *mutex = acquire_mutex(tc, handle);
+            result = (MVMObject *)handle->body.ops->async_writable->write_bytes_vec(tc,
+                handle, queue, schedulee, buffers, async_type);
+            release_mutex(tc, mutex);
+        });
+        return result;
+    }
+    else
+        MVM_exception_throw_adhoc(tc, "Cannot write a list of buffers asynchronously to this kind of handle");
+}
+
 MVMObject * MVM_io_write_bytes_to_async(MVMThreadContext *tc, MVMObject *oshandle, MVMObject *queue,
                                         MVMObject *schedulee, MVMObject *buffer, MVMObject *async_type,
                                         MVMString *host, MVMint64 port) {
@@ -235,6 +525,26 @@ MVMObject * MVM_io_write_bytes_to_async(MVMThreadContext *tc, MVMObject *oshandl
         MVM_exception_throw_adhoc(tc, "Cannot write bytes to a destination asynchronously to this kind of handle");
 }
 
+MVMObject * MVM_io_write_batch_to_async(MVMThreadContext *tc, MVMObject *oshandle, MVMObject *queue,
+                                        MVMObject *schedulee, MVMObject *buffer, MVMObject *meta,
+                                        MVMObject *async_type) {
+    MVMOSHandle *handle = verify_is_handle(tc, oshandle, "write datagrams asynchronously");
+    if (buffer == NULL)
+        MVM_exception_throw_adhoc(tc, "Failed to write to filehandle: NULL buffer given");
+    if (handle->body.ops->async_writable_to && handle->body.ops->async_writable_to->write_batch_to) {
+        MVMObject *result;
+        MVMROOT6(tc, meta, queue, schedulee, buffer, async_type, handle, {
+            uv_mutex_t *mutex = acquire_mutex(tc, handle);
+            result = (MVMObject *)handle->body.ops->async_writable_to->write_batch_to(tc,
+                handle, queue, schedulee, buffer, meta, async_type);
+            release_mutex(tc, mutex);
+        });
+        return result;
+    }
+    else
+        MVM_exception_throw_adhoc(tc, "Cannot write datagrams in batches to this kind of handle");
+}
+
 MVMint64 MVM_io_eof(MVMThreadContext *tc, MVMObject *oshandle) {
     MVMOSHandle *handle = verify_is_handle(tc, oshandle, "eof");
     if (handle->body.ops->sync_readable) {
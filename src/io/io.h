@@ -31,6 +31,15 @@ struct MVMIOClosable {
 struct MVMIOSyncReadable {
     MVMint64 (*read_bytes) (MVMThreadContext *tc, MVMOSHandle *h, char **buf, MVMint64 bytes);
     MVMint64 (*eof) (MVMThreadContext *tc, MVMOSHandle *h);
+
+    /* Reads into memory the caller provides, for handles that can do so
+     * without going through a buffer of their own; may be NULL. */
+    MVMint64 (*read_bytes_into) (MVMThreadContext *tc, MVMOSHandle *h, char *buf, MVMint64 bytes);
+
+    /* Moves bytes straight to a descriptor, without them passing through VM
+     * memory, for handles that don't buffer input; a negative count means
+     * until EOF. May be NULL. */
+    MVMint64 (*transfer_to) (MVMThreadContext *tc, MVMOSHandle *h, int fd, MVMint64 bytes);
 };
 
 /* I/O operations on handles that can do synchronous writing. */
@@ -38,18 +47,40 @@ struct MVMIOSyncWritable {
     MVMint64 (*write_bytes) (MVMThreadContext *tc, MVMOSHandle *h, char *buf, MVMint64 bytes);
     void (*flush) (MVMThreadContext *tc, MVMOSHandle *h, MVMint32 sync);
     void (*truncate) (MVMThreadContext *tc, MVMOSHandle *h, MVMint64 bytes);
+
+    /* Writes several buffers at once, for handles that can do better than
+     * writing them one at a time; may be NULL. */
+    MVMint64 (*write_bytes_vec) (MVMThreadContext *tc, MVMOSHandle *h, uv_buf_t *bufs, MVMuint32 nbufs);
+
+    /* Tells the handle that bytes were written straight to its descriptor,
+     * so that it can keep its position up to date; may be NULL. */
+    void (*wrote_to_descriptor) (MVMThreadContext *tc, MVMOSHandle *h, MVMint64 bytes);
 };
 
 /* I/O operations on handles that can do asynchronous reading. */
 struct MVMIOAsyncReadable {
     MVMAsyncTask * (*read_bytes) (MVMThreadContext *tc, MVMOSHandle *h, MVMObject *queue,
         MVMObject *schedulee, MVMObject *buf_type, MVMObject *async_type);
+
+    /* Optional; reads datagrams, delivering up to max of them at a time. */
+    MVMAsyncTask * (*read_datagrams) (MVMThreadContext *tc, MVMOSHandle *h, MVMObject *queue,
+        MVMObject *schedulee, MVMObject *buf_type, MVMint64 max, MVMObject *async_type);
 };
 
 /* I/O operations on handles that can do asynchronous writing. */
 struct MVMIOAsyncWritable {
     MVMAsyncTask * (*write_bytes) (MVMThreadContext *tc, MVMOSHandle *h, MVMObject *queue,
         MVMObject *schedulee, MVMObject *buffer, MVMObject *async_type);
+
+    /* Writes a list of buffers as one write; may be NULL. */
+    MVMAsyncTask * (*write_bytes_vec) (MVMThreadContext *tc, MVMOSHandle *h, MVMObject *queue,
+        MVMObject *schedulee, MVMObject *buffers, MVMObject *async_type);
+
+    /* Writes bytes read straight from the descriptor of a source handle,
+     * which is kept alive until done; a negative count means until EOF.
+     * May be NULL. */
+    MVMAsyncTask * (*transfer_from) (MVMThreadContext *tc, MVMOSHandle *h, MVMObject *queue,
+        MVMObject *schedulee, MVMOSHandle *source, int fd, MVMint64 bytes, MVMObject *async_type);
 };
 
 /* I/O operations on handles that can do asynchronous writing to a given
@@ -57,6 +88,10 @@ struct MVMIOAsyncWritable {
 struct MVMIOAsyncWritableTo {
     MVMAsyncTask * (*write_bytes_to) (MVMThreadContext *tc, MVMOSHandle *h, MVMObject *queue,
         MVMObject *schedulee, MVMObject *buffer, MVMObject *async_type, MVMString *host, MVMint64 port);
+
+    /* Optional; sends a batch of datagrams, each to its own destination. */
+    MVMAsyncTask * (*write_batch_to) (MVMThreadContext *tc, MVMOSHandle *h, MVMObject *queue,
+        MVMObject *schedulee, MVMObject *buffer, MVMObject *meta, MVMObject *async_type);
 };
 
 /* I/O operations on handles that can seek/tell. */
@@ -92,14 +127,31 @@ void MVM_io_seek(MVMThreadContext *tc, MVMObject *oshandle, MVMint64 offset, MVM
 MVMint64 MVM_io_tell(MVMThreadContext *tc, MVMObject *oshandle);
 void MVM_io_read_bytes(MVMThreadContext *tc, MVMObject *oshandle, MVMObject *result, MVMint64 length);
 void MVM_io_write_bytes(MVMThreadContext *tc, MVMObject *oshandle, MVMObject *buffer);
+MVMint64 MVM_io_read_bytes_into(MVMThreadContext *tc, MVMObject *oshandle, MVMObject *buffer,
+    MVMint64 offset, MVMint64 length);
+void MVM_io_write_bytes_slice(MVMThreadContext *tc, MVMObject *oshandle, MVMObject *buffer,
+    MVMint64 offset, MVMint64 length);
+void MVM_io_write_bytes_vec(MVMThreadContext *tc, MVMObject *oshandle, MVMObject *buffers);
+MVMint64 MVM_io_transfer(MVMThreadContext *tc, MVMObject *dest, MVMObject *source, MVMint64 length);
+MVMObject * MVM_io_transfer_async(MVMThreadContext *tc, MVMObject *dest, MVMObject *queue,
+    MVMObject *schedulee, MVMObject *source, MVMint64 length, MVMObject *async_type);
+MVMint64 MVM_io_buffer_list_count(MVMThreadContext *tc, MVMObject *buffers, const char *op);
+MVMObject * MVM_io_buffer_list_get(MVMThreadContext *tc, MVMObject *buffers, MVMint64 i, const char *op);
+uv_buf_t MVM_io_buffer_list_at(MVMThreadContext *tc, MVMObject *buffers, MVMint64 i, const char *op);
 void MVM_io_write_bytes_c(MVMThreadContext *tc, MVMObject *oshandle, char *output,
     MVMuint64 output_size);
 MVMObject * MVM_io_read_bytes_async(MVMThreadContext *tc, MVMObject *oshandle, MVMObject *queue,
     MVMObject *schedulee, MVMObject *buf_type, MVMObject *async_type);
+MVMObject * MVM_io_read_batch_async(MVMThreadContext *tc, MVMObject *oshandle, MVMObject *queue,
+    MVMObject *schedulee, MVMObject *buf_type, MVMint64 max, MVMObject *async_type);
 MVMObject * MVM_io_write_bytes_async(MVMThreadContext *tc, MVMObject *oshandle, MVMObject *queue,
         MVMObject *schedulee, MVMObject *buffer, MVMObject *async_type);
+MVMObject * MVM_io_write_bytes_vec_async(MVMThreadContext *tc, MVMObject *oshandle, MVMObject *queue,
+    MVMObject *schedulee, MVMObject *buffers, MVMObject *async_type);
 MVMObject * MVM_io_write_bytes_to_async(MVMThreadContext *tc, MVMObject *oshandle, MVMObject *queue,
         MVMObject *schedulee, MVMObject *buffer, MVMObject *async_type, MVMString *host, MVMint64 port);
+MVMObject * MVM_io_write_batch_to_async(MVMThreadContext *tc, MVMObject *oshandle, MVMObject *queue,
+        MVMObject *schedulee, MVMObject *buffer, MVMObject *meta, MVMObject *async_type);
 MVMint64 MVM_io_eof(MVMThreadContext *tc, MVMObject *oshandle);
 MVMint64 MVM_io_lock(MVMThreadContext *tc, MVMObject *oshandle, MVMint64 flag);
 void MVM_io_unlock(MVMThreadContext *tc, MVMObject *oshandle);
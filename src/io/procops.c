@@ -194,7 +194,6 @@ typedef struct {
     ProcessState       state;
     int                using;
     int                merge;
-    size_t             last_read;
 } SpawnInfo;
 
 /* Info we convey about a write task. */
@@ -318,6 +317,7 @@ static const MVMAsyncTaskOps write_op_table = {
 static MVMAsyncTask * write_bytes(MVMThreadContext *tc, MVMOSHandle *h, MVMObject *queue,
                                   MVMObject *schedulee, MVMObject *buffer, MVMObject *async_type) {
     MVMAsyncTask *task;
+    MVMAsyncTask *spawn_task;
     SpawnWriteInfo    *wi;
 
     /* Validate REPRs. */
@@ -340,6 +340,9 @@ static MVMAsyncTask * write_bytes(MVMThreadContext *tc, MVMOSHandle *h, MVMObjec
     MVM_ASSIGN_REF(tc, &(task->common.header), task->body.queue, queue);
     MVM_ASSIGN_REF(tc, &(task->common.header), task->body.schedulee, schedulee);
     task->body.ops  = &write_op_table;
+    spawn_task      = (MVMAsyncTask *)((MVMIOAsyncProcessData *)h->body.data)->async_task;
+    if (spawn_task)
+        task->body.loop = spawn_task->body.loop;
     wi              = MVM_calloc(1, sizeof(SpawnWriteInfo));
     MVM_ASSIGN_REF(tc, &(task->common.header), wi->handle, h);
     MVM_ASSIGN_REF(tc, &(task->common.header), wi->buf_data, buffer);
@@ -398,6 +401,7 @@ static MVMint64 close_stdin(MVMThreadContext *tc, MVMOSHandle *h) {
                 tc->instance->boot_types.BOOTAsync);
         });
         task->body.ops  = &deferred_close_op_table;
+        task->body.loop = spawn_task->body.loop;
         task->body.data = si;
         MVM_io_eventloop_queue_work(tc, (MVMObject *)task);
         return 0;
@@ -409,6 +413,7 @@ static MVMint64 close_stdin(MVMThreadContext *tc, MVMOSHandle *h) {
                 tc->instance->boot_types.BOOTAsync);
         });
         task->body.ops  = &close_op_table;
+        task->body.loop = spawn_task->body.loop;
         task->body.data = si->stdin_handle;
         MVM_io_eventloop_queue_work(tc, (MVMObject *)task);
         si->stdin_handle = NULL;
@@ -427,6 +432,7 @@ static void deferred_close_perform(MVMThreadContext *tc, uv_loop_t *loop, MVMObj
                 tc->instance->boot_types.BOOTAsync);
         });
         task->body.ops  = &deferred_close_op_table;
+        task->body.loop = tc->event_loop;
         task->body.data = si;
         MVM_io_eventloop_queue_work(tc, (MVMObject *)task);
         return;
@@ -442,7 +448,7 @@ MVMObject * get_async_task_handle(MVMThreadContext *tc, MVMOSHandle *h) {
 }
 
 /* IO ops table, for async process, populated with functions. */
-static const MVMIOAsyncWritable proc_async_writable = { write_bytes };
+static const MVMIOAsyncWritable proc_async_writable = { write_bytes, NULL, NULL };
 static const MVMIOClosable      closable            = { close_stdin };
 static const MVMIOOps proc_op_table = {
     &closable,
@@ -506,41 +512,6 @@ static void async_spawn_on_exit(uv_process_t *req, MVMint64 exit_status, int ter
         MVM_io_eventloop_remove_active_work(tc, &(si->work_idx));
 }
 
-#ifndef MIN
-    #define MIN(x,y) ((x)<(y)?(x):(y))
-#endif
-
-MVM_STATIC_INLINE void adjust_nursery(MVMThreadContext *tc, size_t read_buffer_size) {
-    int adjustment = MIN(read_buffer_size, 32768) & ~0x7;
-    if (adjustment && (char *)tc->nursery_alloc_limit - adjustment > (char *)tc->nursery_alloc) {
-        tc->nursery_alloc_limit = (char *)(tc->nursery_alloc_limit) - adjustment;
-        /*fprintf(stderr, "made an adjustment of %x: %p - %p == %x; read buffer size %x\n", adjustment, tc->nursery_alloc_limit, tc->nursery_alloc, (char *)tc->nursery_alloc_limit - (char *)tc->nursery_alloc, read_buffer_size);*/
-    }
-    else {
-        /*fprintf(stderr, "did not make an adjustment of %x: %p - %p == %x; read buffer size %x\n", adjustment, tc->nursery_alloc_limit, tc->nursery_alloc, (char *)tc->nursery_alloc_limit - (char *)tc->nursery_alloc, read_buffer_size);*/
-    }
-}
-
-
-/* Allocates a buffer of the suggested size. */
-static void on_alloc(uv_handle_t *handle, size_t suggested_size, uv_buf_t *buf) {
-    SpawnInfo *si = (SpawnInfo *)handle->data;
-    size_t size   = si->last_read ? si->last_read : 64;
-    MVMThreadContext *tc = si->tc;
-
-    if (size < 128) {
-        size = 128;
-    }
-    else {
-        size = MVM_bithacks_next_greater_pow2(size + 1);
-    }
-
-    adjust_nursery(tc, size);
-
-    buf->base = MVM_malloc(size);
-    buf->len  = size;
-}
-
 /* Read functions for stdout/stderr/merged. */
 static void async_read(uv_stream_t *handle, ssize_t nread, const uv_buf_t *buf, SpawnInfo *si,
                        MVMObject *callback, MVMuint32 seq_number, MVMint64 *permit) {
@@ -561,22 +532,16 @@ static void async_read(uv_stream_t *handle, ssize_t nread, const uv_buf_t *buf,
 
             /* Push buffer of data. */
             {
-                MVMObject *buf_type    = MVM_repr_at_key_o(tc, si->callbacks,
-                                            tc->instance->str_consts.buf_type);
-                MVMArray  *res_buf     = (MVMArray *)MVM_repr_alloc_init(tc, buf_type);
-                res_buf->body.slots.i8 = (MVMint8 *)buf->base;
-                res_buf->body.start    = 0;
-                res_buf->body.ssize    = buf->len;
-                res_buf->body.elems    = nread;
-                MVM_repr_push_o(tc, arr, (MVMObject *)res_buf);
+                MVMObject *buf_type = MVM_repr_at_key_o(tc, si->callbacks,
+                                         tc->instance->str_consts.buf_type);
+                MVMObject *res_buf  = MVM_io_eventloop_read_buffer_result(tc,
+                                         handle->loop, buf_type, buf, nread);
+                MVM_repr_push_o(tc, arr, res_buf);
             }
 
             /* Finally, no error. */
             MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTStr);
 
-            /* Update handle with amount read. */
-            si->last_read = nread;
-
             /* Update permit count, stop reading if we run out. */
             if (*permit > 0) {
                 (*permit)--;
@@ -600,8 +565,7 @@ static void async_read(uv_stream_t *handle, ssize_t nread, const uv_buf_t *buf,
             MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTStr);
             MVM_repr_push_o(tc, arr, tc->instance->boot_types.BOOTStr);
         });
-        if (buf->base)
-            MVM_free(buf->base);
+        MVM_io_eventloop_release_read_buffer(handle->loop, buf);
         uv_close((uv_handle_t *)handle, NULL);
         if (--si->using == 0)
             MVM_io_eventloop_remove_active_work(tc, &(si->work_idx));
@@ -616,8 +580,7 @@ static void async_read(uv_stream_t *handle, ssize_t nread, const uv_buf_t *buf,
                 tc->instance->boot_types.BOOTStr, msg_str);
             MVM_repr_push_o(tc, arr, msg_box);
         });
-        if (buf->base)
-            MVM_free(buf->base);
+        MVM_io_eventloop_release_read_buffer(handle->loop, buf);
         uv_close((uv_handle_t *)handle, NULL);
         if (--si->using == 0)
             MVM_io_eventloop_remove_active_work(tc, &(si->work_idx));
@@ -849,9 +812,9 @@ static void spawn_permit(MVMThreadContext *tc, uv_loop_t *loop, MVMObject *async
         else
             si->permit_merge += permits;
         if (!si->reading_stdout && si->permit_merge) {
-            uv_read_start((uv_stream_t *)si->pipe_stdout, on_alloc,
+            uv_read_start((uv_stream_t *)si->pipe_stdout, MVM_io_eventloop_alloc_read_buffer,
                 async_spawn_merge_bytes_read);
-            uv_read_start((uv_stream_t *)si->pipe_stderr, on_alloc,
+            uv_read_start((uv_stream_t *)si->pipe_stderr, MVM_io_eventloop_alloc_read_buffer,
                 async_spawn_merge_bytes_read);
             si->reading_stdout = 1;
             si->reading_stderr = 1;
@@ -871,7 +834,7 @@ static void spawn_permit(MVMThreadContext *tc, uv_loop_t *loop, MVMObject *async
         else
             si->permit_stdout += permits;
         if (!si->reading_stdout && si->permit_stdout) {
-            uv_read_start((uv_stream_t *)si->pipe_stdout, on_alloc,
+            uv_read_start((uv_stream_t *)si->pipe_stdout, MVM_io_eventloop_alloc_read_buffer,
                 async_spawn_stdout_bytes_read);
             si->reading_stdout = 1;
         }
@@ -888,7 +851,7 @@ static void spawn_permit(MVMThreadContext *tc, uv_loop_t *loop, MVMObject *async
         else
             si->permit_stderr += permits;
         if (!si->reading_stderr && si->permit_stderr) {
-            uv_read_start((uv_stream_t *)si->pipe_stderr, on_alloc,
+            uv_read_start((uv_stream_t *)si->pipe_stderr, MVM_io_eventloop_alloc_read_buffer,
                 async_spawn_stderr_bytes_read);
             si->reading_stderr = 1;
         }
@@ -1211,6 +1174,7 @@ MVMint64 MVM_proc_fork(MVMThreadContext *tc) {
     MVMInstance *instance = tc->instance;
     const char *error = NULL;
     MVMint64 pid = -1;
+    MVMuint32 i;
 
     if (!MVM_platform_supports_fork(tc))
         MVM_exception_throw_adhoc(tc, "This platform does not support fork()");
@@ -1228,8 +1192,9 @@ MVMint64 MVM_proc_fork(MVMThreadContext *tc) {
     MVM_io_eventloop_stop(tc);
     MVM_spesh_worker_join(tc);
     MVM_io_eventloop_join(tc);
-    /* Allow MVM_io_eventloop_start to restart the thread if necessary */
-    instance->event_loop_thread = NULL;
+    /* Allow MVM_io_eventloop_start to restart the threads if necessary */
+    for (i = 0; i < instance->num_event_loops; i++)
+        instance->event_loops[i].thread = NULL;
 
     MVM_gc_mark_thread_blocked(tc);
     uv_mutex_lock(&instance->mutex_threads);
@@ -1242,9 +1207,15 @@ MVMint64 MVM_proc_fork(MVMThreadContext *tc) {
         error = "Program has more than one active thread";
     }
 
-    if (pid == 0 && instance->event_loop) {
-        /* Reinitialize uv_loop_t after fork in child */
-        uv_loop_fork(instance->event_loop);
+    if (pid == 0) {
+        /* Reinitialize each uv_loop_t after fork in child */
+        for (i = 0; i < instance->num_event_loops; i++) {
+            MVMEventLoop *el = &instance->event_loops[i];
+            if (el->loop) {
+                uv_loop_fork(el->loop);
+                el->uring = MVM_io_uring_recreate(tc, el->uring, el->loop);
+            }
+        }
     }
 
     /* Release the thread lock, otherwise we can't start them */
@@ -1255,8 +1226,7 @@ MVMint64 MVM_proc_fork(MVMThreadContext *tc) {
     /* However, locks are nonrecursive, so unlocking is needed prior to
      * restarting the event loop */
     uv_mutex_unlock(&instance->mutex_event_loop);
-    if (instance->event_loop)
-        MVM_io_eventloop_start(tc);
+    MVM_io_eventloop_start(tc);
 
     if (error != NULL)
         MVM_exception_throw_adhoc(tc, "fork() failed: %s\n", error);
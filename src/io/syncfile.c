@@ -3,6 +3,7 @@
 
 #ifndef _WIN32
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <unistd.h>
 #define DEFAULT_MODE 0x01B6
 typedef struct stat STAT_t;
@@ -91,6 +92,46 @@ static void perform_write(MVMThreadContext *tc, MVMIOFileData *data, char *buf,
     data->known_writable = 1;
 }
 
+/* Writes several buffers, with one system call where possible. The buffers
+ * are updated to skip over whatever has been written. */
+static void perform_writev(MVMThreadContext *tc, MVMIOFileData *data, uv_buf_t *bufs, MVMuint32 nbufs) {
+#ifdef _WIN32
+    MVMuint32 i;
+    for (i = 0; i < nbufs; i++)
+        perform_write(tc, data, bufs[i].base, bufs[i].len);
+#else
+    /* On POSIX systems, uv_buf_t is laid out just like struct iovec. */
+    struct iovec *iov = (struct iovec *)bufs;
+    MVMint64 bytes_written = 0;
+    MVM_gc_mark_thread_blocked(tc);
+    while (nbufs > 0) {
+        ssize_t r;
+        do {
+            r = writev(data->fd, iov, (int)nbufs);
+        } while (r == -1 && errno == EINTR);
+        if (r == -1) {
+            int save_errno = errno;
+            MVM_gc_mark_thread_unblocked(tc);
+            MVM_exception_throw_adhoc(tc, "Failed to write bytes to filehandle: %s",
+                strerror(save_errno));
+        }
+        bytes_written += r;
+        while (nbufs > 0 && (size_t)r >= iov->iov_len) {
+            r -= iov->iov_len;
+            iov++;
+            nbufs--;
+        }
+        if (nbufs > 0) {
+            iov->iov_base = (char *)iov->iov_base + r;
+            iov->iov_len -= r;
+        }
+    }
+    MVM_gc_mark_thread_unblocked(tc);
+    data->byte_position += bytes_written;
+    data->known_writable = 1;
+#endif
+}
+
 /* Flushes any existing output buffer and clears use back to 0. */
 static void flush_output_buffer(MVMThreadContext *tc, MVMIOFileData *data) {
     if (data->output_buffer_used) {
@@ -125,10 +166,11 @@ static MVMint64 mvm_tell(MVMThreadContext *tc, MVMOSHandle *h) {
 }
 
 /* Reads the specified number of bytes into the supplied buffer, returning
- * the number actually read. */
-static MVMint64 read_bytes(MVMThreadContext *tc, MVMOSHandle *h, char **buf_out, MVMint64 bytes) {
-    MVMIOFileData *data = (MVMIOFileData *)h->body.data;
-    char *buf = MVM_malloc(bytes);
+ * the number actually read; free_on_error is freed before throwing if the
+ * read fails. Used both to read into a fresh buffer and into one that the
+ * caller provides. */
+static MVMint64 read_to_buffer(MVMThreadContext *tc, MVMIOFileData *data, char *buf,
+        MVMint64 bytes, char *free_on_error) {
     unsigned int interval_id = MVM_telemetry_interval_start(tc, "syncfile.read_to_buffer");
     MVMint32 bytes_read;
 #ifdef _WIN32
@@ -146,11 +188,10 @@ static MVMint64 read_bytes(MVMThreadContext *tc, MVMOSHandle *h, char **buf_out,
     } while(bytes_read == -1 && errno == EINTR);
     if (bytes_read  == -1) {
         int save_errno = errno;
-        MVM_free(buf);
+        MVM_free(free_on_error);
         MVM_exception_throw_adhoc(tc, "Reading from filehandle failed: %s",
             strerror(save_errno));
     }
-    *buf_out = buf;
     MVM_telemetry_interval_annotate(bytes_read, interval_id, "read this many bytes");
     MVM_telemetry_interval_stop(tc, interval_id, "syncfile.read_to_buffer");
     data->byte_position += bytes_read;
@@ -158,6 +199,85 @@ static MVMint64 read_bytes(MVMThreadContext *tc, MVMOSHandle *h, char **buf_out,
         data->eof_reported = 1;
     return bytes_read;
 }
+static MVMint64 read_bytes(MVMThreadContext *tc, MVMOSHandle *h, char **buf_out, MVMint64 bytes) {
+    char *buf = MVM_malloc(bytes);
+    MVMint64 bytes_read = read_to_buffer(tc, (MVMIOFileData *)h->body.data, buf, bytes, buf);
+    *buf_out = buf;
+    return bytes_read;
+}
+static MVMint64 read_bytes_into(MVMThreadContext *tc, MVMOSHandle *h, char *buf, MVMint64 bytes) {
+    return read_to_buffer(tc, (MVMIOFileData *)h->body.data, buf, bytes, NULL);
+}
+
+/* Writes all of a buffer to a descriptor, returning -1 with errno set if
+ * that fails. */
+static int write_fully(int fd, const char *buf, MVMint64 bytes) {
+    while (bytes > 0) {
+        int r = write(fd, buf, (int)bytes);
+        if (r == -1) {
+            if (errno == EINTR)
+                continue;
+            return -1;
+        }
+        buf   += r;
+        bytes -= r;
+    }
+    return 0;
+}
+
+/* Moves bytes from the file straight to another descriptor, in the kernel
+ * where the platform allows it, and otherwise through a buffer of our own.
+ * A negative count means until end of file. */
+#define TRANSFER_CHUNK       (1 << 20)
+#define TRANSFER_BUFFER_SIZE 65536
+static MVMint64 transfer_to(MVMThreadContext *tc, MVMOSHandle *h, int fd, MVMint64 bytes) {
+    MVMIOFileData *data   = (MVMIOFileData *)h->body.data;
+    MVMint64       total  = 0;
+    char          *buf    = NULL;
+    int            method = 0;
+    int            error  = 0;
+    flush_output_buffer(tc, data);
+    MVM_gc_mark_thread_blocked(tc);
+    while (bytes < 0 || total < bytes) {
+        MVMint64 want = bytes < 0 || bytes - total > TRANSFER_CHUNK
+            ? TRANSFER_CHUNK
+            : bytes - total;
+        MVMint64 r = MVM_platform_transfer_chunk(fd, data->fd, want, &method);
+        if (r == -1 && errno == ENOSYS) {
+            if (!buf)
+                buf = MVM_malloc(TRANSFER_BUFFER_SIZE);
+            r = read(data->fd, buf, want < TRANSFER_BUFFER_SIZE ? (int)want : TRANSFER_BUFFER_SIZE);
+            if (r > 0 && write_fully(fd, buf, r) == -1)
+                r = -1;
+        }
+        if (r == -1) {
+            if (errno == EINTR)
+                continue;
+            error = errno;
+            break;
+        }
+        if (r == 0) {
+            data->eof_reported = 1;
+            break;
+        }
+        total += r;
+    }
+    MVM_gc_mark_thread_unblocked(tc);
+    MVM_free(buf);
+    data->byte_position += total;
+    if (error)
+        MVM_exception_throw_adhoc(tc, "Failed to transfer bytes from filehandle: %s",
+            strerror(error));
+    return total;
+}
+
+/* Accounts for bytes that were written to the file's descriptor by someone
+ * else, such as a transfer from another handle. */
+static void wrote_to_descriptor(MVMThreadContext *tc, MVMOSHandle *h, MVMint64 bytes) {
+    MVMIOFileData *data = (MVMIOFileData *)h->body.data;
+    data->byte_position += bytes;
+    data->known_writable = 1;
+}
 
 /* Checks if the end of file has been reached. */
 static MVMint64 mvm_eof(MVMThreadContext *tc, MVMOSHandle *h) {
@@ -220,6 +340,29 @@ static MVMint64 write_bytes(MVMThreadContext *tc, MVMOSHandle *h, char *buf, MVM
     return bytes;
 }
 
+/* Writes several buffers; if they all fit in the output buffer they go
+ * there, and otherwise they are written together. */
+static MVMint64 write_bytes_vec(MVMThreadContext *tc, MVMOSHandle *h, uv_buf_t *bufs, MVMuint32 nbufs) {
+    MVMIOFileData *data = (MVMIOFileData *)h->body.data;
+    MVMint64 bytes = 0;
+    MVMuint32 i;
+    for (i = 0; i < nbufs; i++)
+        bytes += bufs[i].len;
+    if (data->output_buffer_size && data->known_writable) {
+        if (data->output_buffer_used + bytes > data->output_buffer_size)
+            flush_output_buffer(tc, data);
+        if (bytes < data->output_buffer_size) {
+            for (i = 0; i < nbufs; i++) {
+                memcpy(data->output_buffer + data->output_buffer_used, bufs[i].base, bufs[i].len);
+                data->output_buffer_used += bufs[i].len;
+            }
+            return bytes;
+        }
+    }
+    perform_writev(tc, data, bufs, nbufs);
+    return bytes;
+}
+
 /* Flushes the file handle. */
 static void flush(MVMThreadContext *tc, MVMOSHandle *h, MVMint32 sync){
     MVMIOFileData *data = (MVMIOFileData *)h->body.data;
@@ -381,8 +524,10 @@ static void gc_free(MVMThreadContext *tc, MVMObject *h, void *d) {
 
 /* IO ops table, populated with functions. */
 static const MVMIOClosable      closable      = { closefh };
-static const MVMIOSyncReadable  sync_readable = { read_bytes, mvm_eof };
-static const MVMIOSyncWritable  sync_writable = { write_bytes, flush, truncatefh };
+static const MVMIOSyncReadable  sync_readable = { read_bytes, mvm_eof, read_bytes_into,
+                                                  transfer_to };
+static const MVMIOSyncWritable  sync_writable = { write_bytes, flush, truncatefh, write_bytes_vec,
+                                                  wrote_to_descriptor };
 static const MVMIOSeekable      seekable      = { seek, mvm_tell };
 static const MVMIOLockable      lockable      = { lock, unlock };
 static const MVMIOIntrospection introspection = { is_tty, mvm_fileno };
@@ -434,8 +579,10 @@ static int resolve_open_mode(int *flag, const char *cp) {
     }
 }
 
-/* Opens a file, returning a synchronous file handle. */
-MVMObject * MVM_file_open_fh(MVMThreadContext *tc, MVMString *filename, MVMString *mode) {
+/* Opens a file with the given mode, returning its file descriptor and
+ * setting flag_out to the flags it was opened with. Used for both synchronous
+ * and asynchronous file handles. */
+int MVM_file_open_fd(MVMThreadContext *tc, MVMString *filename, MVMString *mode, int *flag_out) {
     char * const fname = MVM_string_utf8_c8_encode_C_string(tc, filename);
     int fd;
     int flag;
@@ -476,8 +623,17 @@ MVMObject * MVM_file_open_fh(MVMThreadContext *tc, MVMString *filename, MVMStrin
         MVM_exception_throw_adhoc_free(tc, waste, "Tried to open directory %s", fname);
     }
 
-    /* Set up handle. */
     MVM_free(fname);
+    *flag_out = flag;
+    return fd;
+}
+
+/* Opens a file, returning a synchronous file handle. */
+MVMObject * MVM_file_open_fh(MVMThreadContext *tc, MVMString *filename, MVMString *mode) {
+    int flag;
+    int fd = MVM_file_open_fd(tc, filename, mode, &flag);
+
+    /* Set up handle. */
     {
         MVMIOFileData * const data   = MVM_calloc(1, sizeof(MVMIOFileData));
         MVMOSHandle   * const result = (MVMOSHandle *)MVM_repr_alloc_init(tc,
@@ -1,2 +1,3 @@
+int MVM_file_open_fd(MVMThreadContext *tc, MVMString *filename, MVMString *mode, int *flag_out);
 MVMObject * MVM_file_open_fh(MVMThreadContext *tc, MVMString *filename, MVMString *mode);
 MVMObject * MVM_file_handle_from_fd(MVMThreadContext *tc, uv_file fd);
@@ -335,14 +335,21 @@ struct sockaddr * MVM_io_resolve_host_name(MVMThreadContext *tc, MVMString *host
 
     snprintf(port_cstr, 8, "%d", (int)port);
 
+    /* Use a recent answer if there is one. */
+    if ((dest = MVM_io_dns_cache_lookup(tc, host_cstr, port, family))) {
+        MVM_free(host_cstr);
+        return dest;
+    }
+
     MVM_gc_mark_thread_blocked(tc);
     error = getaddrinfo(host_cstr, port_cstr, &hints, &result);
     MVM_gc_mark_thread_unblocked(tc);
     if (error == 0) {
         size_t size = get_struct_size_for_family(result->ai_addr->sa_family);
-        MVM_free(host_cstr);
         dest = MVM_malloc(size);
         memcpy(dest, result->ai_addr, size);
+        MVM_io_dns_cache_store(tc, host_cstr, family, dest);
+        MVM_free(host_cstr);
     }
     else {
         char *waste[] = { host_cstr, NULL };
@@ -471,10 +478,13 @@ static MVMObject * socket_accept(MVMThreadContext *tc, MVMOSHandle *h);
 /* IO ops table, populated with functions. */
 static const MVMIOClosable      closable      = { close_socket };
 static const MVMIOSyncReadable  sync_readable = { socket_read_bytes,
-                                                  socket_eof };
+                                                  socket_eof,
+                                                  NULL,
+                                                  NULL };
 static const MVMIOSyncWritable  sync_writable = { socket_write_bytes,
                                                   socket_flush,
-                                                  socket_truncate };
+                                                  socket_truncate,
+                                                  NULL };
 static const MVMIOSockety             sockety = { socket_connect,
                                                   socket_bind,
                                                   socket_accept,
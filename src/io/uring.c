@@ -0,0 +1,470 @@
+#include "moar.h"
+
+#ifdef MVM_HAS_IO_URING
+
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <sys/mman.h>
+#include <sys/eventfd.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <errno.h>
+
+/* The kernel tells us about completions by signalling an eventfd, which a
+ * libuv poll handle watches, so they are processed along with everything
+ * else on the loop. Submissions are only written into the ring as they are
+ * made; a prepare handle hands all of them to the kernel in one system call
+ * just before the loop goes to sleep, so that whatever a round of callbacks
+ * started is submitted together.
+ *
+ * A set of read buffers is registered up front, so that reads into them
+ * skip the per-request mapping of the destination memory, and a sparse
+ * table of files is registered for handles to claim slots in, to save the
+ * file lookup on each request. Neither is essential: if registering fails
+ * (most often because the locked memory limit is low), requests just use
+ * ordinary buffers and file descriptors. */
+struct MVMIOUring {
+    int ring_fd;
+    int event_fd;
+
+    /* The submission queue, its entries, and how many of the entries
+     * written so far have not been passed to the kernel yet. */
+    unsigned            *sq_head;
+    unsigned            *sq_tail;
+    unsigned            *sq_mask;
+    unsigned            *sq_array;
+    unsigned             sq_entries;
+    struct io_uring_sqe *sqes;
+    unsigned             sq_pending;
+
+    /* How many submitted requests have not had their callbacks run yet. */
+    unsigned             in_flight;
+
+    /* The completion queue. */
+    unsigned            *cq_head;
+    unsigned            *cq_tail;
+    unsigned            *cq_mask;
+    struct io_uring_cqe *cqes;
+
+    /* The mappings of the above, for cleaning up. */
+    void   *sq_ring;
+    size_t  sq_ring_size;
+    void   *cq_ring;
+    size_t  cq_ring_size;
+    size_t  sqes_size;
+
+    /* The libuv handles, and how many are yet to finish closing. */
+    uv_poll_t    poll;
+    uv_prepare_t prepare;
+    MVMuint32    closing;
+
+    /* Registered read buffers (all in one allocation), and a stack of the
+     * indexes of those that are free. Only used on the loop thread. */
+    char     *buffers;
+    MVMint32  free_buffers[MVM_IO_URING_BUFFERS];
+    MVMint32  num_free_buffers;
+
+    /* Registered file slots. Handles may be freed by the GC on any thread,
+     * giving their slot back, so these are protected by a mutex. */
+    MVMint32   files_registered;
+    MVMuint8   file_used[MVM_IO_URING_FILES];
+    uv_mutex_t mutex_files;
+};
+
+static int sys_setup(unsigned entries, struct io_uring_params *p) {
+    return (int)syscall(__NR_io_uring_setup, entries, p);
+}
+static int sys_enter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags) {
+    return (int)syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, NULL, 0);
+}
+static int sys_register(int fd, unsigned opcode, void *arg, unsigned nr_args) {
+    return (int)syscall(__NR_io_uring_register, fd, opcode, arg, nr_args);
+}
+
+/* Checks that the kernel knows all of the operations we use. */
+static int supports_ops(int ring_fd) {
+    size_t size = sizeof(struct io_uring_probe) + 256 * sizeof(struct io_uring_probe_op);
+    struct io_uring_probe *probe = MVM_calloc(1, size);
+    int ok = sys_register(ring_fd, IORING_REGISTER_PROBE, probe, 256) >= 0
+        && probe->last_op >= IORING_OP_WRITE
+        && (probe->ops[IORING_OP_READ].flags & IO_URING_OP_SUPPORTED)
+        && (probe->ops[IORING_OP_WRITE].flags & IO_URING_OP_SUPPORTED)
+        && (probe->ops[IORING_OP_READ_FIXED].flags & IO_URING_OP_SUPPORTED);
+    MVM_free(probe);
+    return ok;
+}
+
+/* Maps the queues into our address space. */
+static int map_rings(MVMIOUring *ring, struct io_uring_params *p) {
+    char *sq, *cq;
+    ring->sq_ring_size = p->sq_off.array + p->sq_entries * sizeof(unsigned);
+    ring->cq_ring_size = p->cq_off.cqes + p->cq_entries * sizeof(struct io_uring_cqe);
+    if (p->features & IORING_FEAT_SINGLE_MMAP) {
+        if (ring->cq_ring_size > ring->sq_ring_size)
+            ring->sq_ring_size = ring->cq_ring_size;
+        ring->cq_ring_size = ring->sq_ring_size;
+    }
+
+    ring->sq_ring = mmap(NULL, ring->sq_ring_size, PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE, ring->ring_fd, IORING_OFF_SQ_RING);
+    if (ring->sq_ring == MAP_FAILED) {
+        ring->sq_ring = NULL;
+        return 0;
+    }
+    if (p->features & IORING_FEAT_SINGLE_MMAP) {
+        ring->cq_ring = ring->sq_ring;
+    }
+    else {
+        ring->cq_ring = mmap(NULL, ring->cq_ring_size, PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_POPULATE, ring->ring_fd, IORING_OFF_CQ_RING);
+        if (ring->cq_ring == MAP_FAILED) {
+            ring->cq_ring = NULL;
+            return 0;
+        }
+    }
+    ring->sqes_size = p->sq_entries * sizeof(struct io_uring_sqe);
+    ring->sqes      = mmap(NULL, ring->sqes_size, PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE, ring->ring_fd, IORING_OFF_SQES);
+    if (ring->sqes == MAP_FAILED) {
+        ring->sqes = NULL;
+        return 0;
+    }
+
+    sq = (char *)ring->sq_ring;
+    cq = (char *)ring->cq_ring;
+    ring->sq_head    = (unsigned *)(sq + p->sq_off.head);
+    ring->sq_tail    = (unsigned *)(sq + p->sq_off.tail);
+    ring->sq_mask    = (unsigned *)(sq + p->sq_off.ring_mask);
+    ring->sq_array   = (unsigned *)(sq + p->sq_off.array);
+    ring->sq_entries = p->sq_entries;
+    ring->cq_head    = (unsigned *)(cq + p->cq_off.head);
+    ring->cq_tail    = (unsigned *)(cq + p->cq_off.tail);
+    ring->cq_mask    = (unsigned *)(cq + p->cq_off.ring_mask);
+    ring->cqes       = (struct io_uring_cqe *)(cq + p->cq_off.cqes);
+    return 1;
+}
+
+/* Registers the read buffers, if we're allowed to. */
+static void register_buffers(MVMIOUring *ring) {
+    struct iovec iov[MVM_IO_URING_BUFFERS];
+    MVMint32 i;
+    ring->buffers = MVM_malloc(MVM_IO_URING_BUFFERS * MVM_IO_READ_BUFFER_SIZE);
+    for (i = 0; i < MVM_IO_URING_BUFFERS; i++) {
+        iov[i].iov_base = ring->buffers + i * MVM_IO_READ_BUFFER_SIZE;
+        iov[i].iov_len  = MVM_IO_READ_BUFFER_SIZE;
+    }
+    if (sys_register(ring->ring_fd, IORING_REGISTER_BUFFERS, iov, MVM_IO_URING_BUFFERS) < 0) {
+        MVM_free(ring->buffers);
+        ring->buffers = NULL;
+        return;
+    }
+    for (i = 0; i < MVM_IO_URING_BUFFERS; i++)
+        ring->free_buffers[i] = MVM_IO_URING_BUFFERS - 1 - i;
+    ring->num_free_buffers = MVM_IO_URING_BUFFERS;
+}
+
+/* Registers a table of empty file slots, if we're allowed to. */
+static void register_files(MVMIOUring *ring) {
+    int fds[MVM_IO_URING_FILES];
+    MVMint32 i;
+    for (i = 0; i < MVM_IO_URING_FILES; i++)
+        fds[i] = -1;
+    ring->files_registered = sys_register(ring->ring_fd, IORING_REGISTER_FILES,
+        fds, MVM_IO_URING_FILES) >= 0;
+}
+
+/* Unmaps the queues and closes the descriptors; closing the ring also
+ * drops everything registered with it. */
+static void release_ring(MVMIOUring *ring) {
+    if (ring->sqes)
+        munmap(ring->sqes, ring->sqes_size);
+    if (ring->cq_ring && ring->cq_ring != ring->sq_ring)
+        munmap(ring->cq_ring, ring->cq_ring_size);
+    if (ring->sq_ring)
+        munmap(ring->sq_ring, ring->sq_ring_size);
+    if (ring->event_fd >= 0)
+        close(ring->event_fd);
+    if (ring->ring_fd >= 0)
+        close(ring->ring_fd);
+    MVM_free(ring->buffers);
+    ring->buffers = NULL;
+}
+
+/* Runs the callbacks of all requests that have completed. A callback may
+ * well make a new request, which can in turn end up back here if the
+ * submission queue is full, so the head is always re-read. */
+static void reap(MVMIOUring *ring) {
+    unsigned head;
+    while ((head = *ring->cq_head) != __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE)) {
+        struct io_uring_cqe *cqe = &ring->cqes[head & *ring->cq_mask];
+        MVMIOUringRequest   *req = (MVMIOUringRequest *)(uintptr_t)cqe->user_data;
+        MVMint32             res = cqe->res;
+        __atomic_store_n(ring->cq_head, head + 1, __ATOMIC_RELEASE);
+        ring->in_flight--;
+        req->done(req, res);
+    }
+}
+
+/* Blocks until at least one request in flight has completed. Asking the
+ * kernel to wait, rather than polling the eventfd, also has it flush any
+ * completions that overflowed the queue, which is what EBUSY is about. */
+static void wait_for_completion(MVMIOUring *ring) {
+    while (sys_enter(ring->ring_fd, 0, 1, IORING_ENTER_GETEVENTS) < 0)
+        if (errno != EINTR)
+            MVM_panic(1, "Unable to wait for io_uring completions: %s", strerror(errno));
+}
+
+/* Hands everything that has been queued to the kernel. If it has no room,
+ * we make some by running completed requests, waiting for one of those in
+ * flight to finish if need be. If nothing is in flight there is nothing to
+ * wait for, so we give up, leaving the rest for the next time around the
+ * loop, and return 0; otherwise we return 1. */
+static int submit(MVMIOUring *ring) {
+    while (ring->sq_pending) {
+        int r = sys_enter(ring->ring_fd, ring->sq_pending, 0, 0);
+        if (r > 0) {
+            ring->sq_pending -= r;
+            ring->in_flight  += r;
+        }
+        else if (r < 0 && errno == EINTR) {
+            continue;
+        }
+        else if (r == 0 || errno == EAGAIN || errno == EBUSY) {
+            if (*ring->cq_head == __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE)) {
+                if (!ring->in_flight)
+                    return 0;
+                wait_for_completion(ring);
+            }
+            reap(ring);
+        }
+        else {
+            MVM_panic(1, "Unable to submit to io_uring: %s", strerror(errno));
+        }
+    }
+    return 1;
+}
+
+static void on_prepare(uv_prepare_t *handle) {
+    submit((MVMIOUring *)handle->data);
+}
+
+static void on_completion(uv_poll_t *handle, int status, int events) {
+    MVMIOUring *ring = (MVMIOUring *)handle->data;
+    eventfd_t   value;
+    eventfd_read(ring->event_fd, &value);
+    reap(ring);
+}
+
+/* Gets a cleared submission queue entry to fill out, making room for it
+ * first if the queue is full. Making room can run callbacks that queue
+ * entries of their own, so the tail is only read once there is room. */
+static struct io_uring_sqe * get_sqe(MVMIOUring *ring) {
+    unsigned idx;
+    struct io_uring_sqe *sqe;
+    while (*ring->sq_tail - __atomic_load_n(ring->sq_head, __ATOMIC_ACQUIRE) >= ring->sq_entries)
+        if (!submit(ring))
+            MVM_panic(1, "Unable to submit to io_uring: out of resources");
+    idx = *ring->sq_tail & *ring->sq_mask;
+    sqe = &ring->sqes[idx];
+    memset(sqe, 0, sizeof(struct io_uring_sqe));
+    ring->sq_array[idx] = idx;
+    return sqe;
+}
+
+/* Makes a filled out entry visible to the kernel. */
+static void push_sqe(MVMIOUring *ring) {
+    __atomic_store_n(ring->sq_tail, *ring->sq_tail + 1, __ATOMIC_RELEASE);
+    ring->sq_pending++;
+}
+
+static void set_file(struct io_uring_sqe *sqe, int fd, MVMint32 slot) {
+    if (slot >= 0) {
+        sqe->fd     = slot;
+        sqe->flags |= IOSQE_FIXED_FILE;
+    }
+    else {
+        sqe->fd = fd;
+    }
+}
+
+/* Sets up an io_uring for the given loop, returning NULL if the kernel
+ * doesn't support it, or doesn't support everything we need. */
+MVMIOUring * MVM_io_uring_create(MVMThreadContext *tc, uv_loop_t *loop) {
+    struct io_uring_params p;
+    MVMIOUring *ring;
+    int ring_fd;
+
+    memset(&p, 0, sizeof(struct io_uring_params));
+    if ((ring_fd = sys_setup(MVM_IO_URING_ENTRIES, &p)) < 0)
+        return NULL;
+    if (!supports_ops(ring_fd)) {
+        close(ring_fd);
+        return NULL;
+    }
+
+    ring = MVM_calloc(1, sizeof(MVMIOUring));
+    ring->ring_fd  = ring_fd;
+    ring->event_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (!map_rings(ring, &p) || ring->event_fd < 0
+            || sys_register(ring_fd, IORING_REGISTER_EVENTFD, &ring->event_fd, 1) < 0
+            || uv_poll_init(loop, &ring->poll, ring->event_fd) != 0) {
+        release_ring(ring);
+        MVM_free(ring);
+        return NULL;
+    }
+    register_buffers(ring);
+    register_files(ring);
+    uv_mutex_init(&ring->mutex_files);
+
+    ring->poll.data = ring;
+    uv_poll_start(&ring->poll, UV_READABLE, on_completion);
+    uv_prepare_init(loop, &ring->prepare);
+    ring->prepare.data = ring;
+    uv_prepare_start(&ring->prepare, on_prepare);
+    return ring;
+}
+
+static void free_on_close_cb(uv_handle_t *handle) {
+    MVMIOUring *ring = (MVMIOUring *)handle->data;
+    if (--ring->closing == 0)
+        MVM_free(ring);
+}
+
+/* Tears down an io_uring. Any requests still in flight are abandoned. The
+ * memory is freed once the loop has finished closing our handles. */
+void MVM_io_uring_destroy(MVMIOUring *ring) {
+    if (!ring)
+        return;
+    ring->closing = 2;
+    uv_close((uv_handle_t *)&ring->poll, free_on_close_cb);
+    uv_close((uv_handle_t *)&ring->prepare, free_on_close_cb);
+    release_ring(ring);
+    uv_mutex_destroy(&ring->mutex_files);
+}
+
+/* Replaces an io_uring with a fresh one; a child process must do this after
+ * a fork, since it would otherwise share the ring with its parent. */
+MVMIOUring * MVM_io_uring_recreate(MVMThreadContext *tc, MVMIOUring *ring, uv_loop_t *loop) {
+    if (!ring)
+        return NULL;
+    MVM_io_uring_destroy(ring);
+    return MVM_io_uring_create(tc, loop);
+}
+
+/* Puts a file descriptor in a free registered file slot, returning the slot
+ * or -1 if there is none. */
+MVMint32 MVM_io_uring_register_file(MVMIOUring *ring, int fd) {
+    MVMint32 slot = -1;
+    MVMint32 i;
+    if (!ring->files_registered)
+        return -1;
+    uv_mutex_lock(&ring->mutex_files);
+    for (i = 0; i < MVM_IO_URING_FILES; i++) {
+        if (!ring->file_used[i]) {
+            struct io_uring_files_update update;
+            memset(&update, 0, sizeof(struct io_uring_files_update));
+            update.offset = i;
+            update.fds    = (MVMuint64)(uintptr_t)&fd;
+            if (sys_register(ring->ring_fd, IORING_REGISTER_FILES_UPDATE, &update, 1) == 1) {
+                ring->file_used[i] = 1;
+                slot = i;
+            }
+            break;
+        }
+    }
+    uv_mutex_unlock(&ring->mutex_files);
+    return slot;
+}
+
+/* Empties a registered file slot, dropping the ring's reference to the
+ * file. */
+void MVM_io_uring_unregister_file(MVMIOUring *ring, MVMint32 slot) {
+    struct io_uring_files_update update;
+    int fd = -1;
+    if (slot < 0)
+        return;
+    memset(&update, 0, sizeof(struct io_uring_files_update));
+    update.offset = slot;
+    update.fds    = (MVMuint64)(uintptr_t)&fd;
+    uv_mutex_lock(&ring->mutex_files);
+    sys_register(ring->ring_fd, IORING_REGISTER_FILES_UPDATE, &update, 1);
+    ring->file_used[slot] = 0;
+    uv_mutex_unlock(&ring->mutex_files);
+}
+
+/* Takes a free registered read buffer, setting index to its index; returns
+ * NULL if there is none. */
+char * MVM_io_uring_take_buffer(MVMIOUring *ring, MVMint32 *index) {
+    if (!ring->num_free_buffers)
+        return NULL;
+    *index = ring->free_buffers[--ring->num_free_buffers];
+    return ring->buffers + *index * MVM_IO_READ_BUFFER_SIZE;
+}
+
+/* Gives a registered read buffer back. */
+void MVM_io_uring_release_buffer(MVMIOUring *ring, MVMint32 index) {
+    ring->free_buffers[ring->num_free_buffers++] = index;
+}
+
+/* Queues a read of up to len bytes at the given offset (or the current file
+ * position, if it is -1). If buf_index is not -1 then buf is the registered
+ * buffer with that index. */
+void MVM_io_uring_read(MVMIOUring *ring, MVMIOUringRequest *req, int fd, MVMint32 slot,
+        char *buf, MVMint32 buf_index, MVMuint32 len, MVMuint64 offset) {
+    struct io_uring_sqe *sqe = get_sqe(ring);
+    sqe->opcode = buf_index >= 0 ? IORING_OP_READ_FIXED : IORING_OP_READ;
+    set_file(sqe, fd, slot);
+    sqe->addr      = (MVMuint64)(uintptr_t)buf;
+    sqe->len       = len;
+    sqe->off       = offset;
+    sqe->buf_index = buf_index >= 0 ? buf_index : 0;
+    sqe->user_data = (MVMuint64)(uintptr_t)req;
+    push_sqe(ring);
+}
+
+/* Queues a write of len bytes at the given offset (or the current file
+ * position, if it is -1). */
+void MVM_io_uring_write(MVMIOUring *ring, MVMIOUringRequest *req, int fd, MVMint32 slot,
+        const char *buf, MVMuint32 len, MVMuint64 offset) {
+    struct io_uring_sqe *sqe = get_sqe(ring);
+    sqe->opcode = IORING_OP_WRITE;
+    set_file(sqe, fd, slot);
+    sqe->addr      = (MVMuint64)(uintptr_t)buf;
+    sqe->len       = len;
+    sqe->off       = offset;
+    sqe->user_data = (MVMuint64)(uintptr_t)req;
+    push_sqe(ring);
+}
+
+#else
+
+/* Without io_uring, there's never a ring, so none of the rest of these will
+ * ever be called. */
+MVMIOUring * MVM_io_uring_create(MVMThreadContext *tc, uv_loop_t *loop) {
+    return NULL;
+}
+MVMIOUring * MVM_io_uring_recreate(MVMThreadContext *tc, MVMIOUring *ring, uv_loop_t *loop) {
+    return NULL;
+}
+void MVM_io_uring_destroy(MVMIOUring *ring) {
+}
+MVMint32 MVM_io_uring_register_file(MVMIOUring *ring, int fd) {
+    return -1;
+}
+void MVM_io_uring_unregister_file(MVMIOUring *ring, MVMint32 slot) {
+}
+char * MVM_io_uring_take_buffer(MVMIOUring *ring, MVMint32 *index) {
+    return NULL;
+}
+void MVM_io_uring_release_buffer(MVMIOUring *ring, MVMint32 index) {
+}
+void MVM_io_uring_read(MVMIOUring *ring, MVMIOUringRequest *req, int fd, MVMint32 slot,
+        char *buf, MVMint32 buf_index, MVMuint32 len, MVMuint64 offset) {
+    MVM_panic(1, "io_uring is not available");
+}
+void MVM_io_uring_write(MVMIOUring *ring, MVMIOUringRequest *req, int fd, MVMint32 slot,
+        const char *buf, MVMuint32 len, MVMuint64 offset) {
+    MVM_panic(1, "io_uring is not available");
+}
+
+#endif
@@ -0,0 +1,34 @@
+/* On Linux, an event loop can have an io_uring alongside its libuv loop,
+ * which the asynchronous file handles use to do their reads and writes
+ * instead of going through libuv's thread pool. */
+
+/* How many submissions the ring has room for, and how many read buffers and
+ * files are registered with it. */
+#define MVM_IO_URING_ENTRIES 256
+#define MVM_IO_URING_BUFFERS 16
+#define MVM_IO_URING_FILES   256
+
+/* Called on the loop thread when a request completes, with the result being
+ * what the equivalent system call would have returned, or a negated errno
+ * value. */
+typedef void (*MVMIOUringCallback)(MVMIOUringRequest *req, MVMint32 result);
+
+/* A request to the ring; it must stay alive until its callback is run. */
+struct MVMIOUringRequest {
+    MVMIOUringCallback  done;
+    void               *data;
+};
+
+MVMIOUring * MVM_io_uring_create(MVMThreadContext *tc, uv_loop_t *loop);
+MVMIOUring * MVM_io_uring_recreate(MVMThreadContext *tc, MVMIOUring *ring, uv_loop_t *loop);
+void MVM_io_uring_destroy(MVMIOUring *ring);
+
+MVMint32 MVM_io_uring_register_file(MVMIOUring *ring, int fd);
+void MVM_io_uring_unregister_file(MVMIOUring *ring, MVMint32 slot);
+char * MVM_io_uring_take_buffer(MVMIOUring *ring, MVMint32 *index);
+void MVM_io_uring_release_buffer(MVMIOUring *ring, MVMint32 index);
+
+void MVM_io_uring_read(MVMIOUring *ring, MVMIOUringRequest *req, int fd, MVMint32 slot,
+    char *buf, MVMint32 buf_index, MVMuint32 len, MVMuint64 offset);
+void MVM_io_uring_write(MVMIOUring *ring, MVMIOUringRequest *req, int fd, MVMint32 slot,
+    const char *buf, MVMuint32 len, MVMuint64 offset);
@@ -354,6 +354,34 @@ static void * op_to_func(MVMThreadContext *tc, MVMint16 opcode) {
     case MVM_OP_cpucores: return MVM_platform_cpu_count;
     case MVM_OP_freemem: return MVM_platform_free_memory;
     case MVM_OP_totalmem: return MVM_platform_total_memory;
+    case MVM_OP_fillpos_i: return MVM_VMArray_fill_i;
+    case MVM_OP_fillpos_n: return MVM_VMArray_fill_n;
+    case MVM_OP_reducepos_i: return MVM_VMArray_reduce_i;
+    case MVM_OP_reducepos_n: return MVM_VMArray_reduce_n;
+    case MVM_OP_binoppos: return MVM_VMArray_binop;
+    case MVM_OP_indexpos_i: return MVM_VMArray_index_i;
+    case MVM_OP_indexpos_n: return MVM_VMArray_index_n;
+    case MVM_OP_sbappend_s: return MVM_string_builder_append_str;
+    case MVM_OP_sbappend_i: return MVM_string_builder_append_int;
+    case MVM_OP_sbappend_n: return MVM_string_builder_append_num;
+    case MVM_OP_sbappendcp: return MVM_string_builder_append_codepoint;
+    case MVM_OP_sbelems: return MVM_string_builder_elems;
+    case MVM_OP_sbfinish: return MVM_string_builder_finish;
+    case MVM_OP_msconfigure: return MVM_multi_search_configure;
+    case MVM_OP_msindex: return MVM_multi_search_index;
+    case MVM_OP_mslastneedle: return MVM_multi_search_last_needle;
+    case MVM_OP_mssplit: return MVM_multi_search_split;
+    case MVM_OP_unicollkey: return MVM_unicode_string_collation_key;
+    case MVM_OP_parsenums: return MVM_coerce_parse_nums;
+    case MVM_OP_asyncopen: return MVM_file_open_async;
+    case MVM_OP_readinto_fhb: return MVM_io_read_bytes_into;
+    case MVM_OP_writeslice_fhb: return MVM_io_write_bytes_slice;
+    case MVM_OP_writev_fhb: return MVM_io_write_bytes_vec;
+    case MVM_OP_transfer_fh: return MVM_io_transfer;
+    case MVM_OP_mmapfile: return MVM_mapped_buffer_open;
+    case MVM_OP_mmapslice: return MVM_mapped_buffer_slice;
+    case MVM_OP_mmapadvise: return MVM_mapped_buffer_advise;
+    case MVM_OP_mmapindex: return MVM_mapped_buffer_index;
     case MVM_OP_getsignals: return MVM_io_get_signals;
     case MVM_OP_sleep: return MVM_platform_sleep;
     case MVM_OP_getlexref_i32: case MVM_OP_getlexref_i16: case MVM_OP_getlexref_i8: case MVM_OP_getlexref_i: return MVM_nativeref_lex_i;
@@ -1766,6 +1794,12 @@ start:
     case MVM_OP_sp_p6obind_s:
     case MVM_OP_sp_p6obind_o:
     case MVM_OP_sp_p6obind_i32:
+    case MVM_OP_sp_p6oget_i16:
+    case MVM_OP_sp_p6oget_i8:
+    case MVM_OP_sp_p6oget_n32:
+    case MVM_OP_sp_p6obind_i16:
+    case MVM_OP_sp_p6obind_i8:
+    case MVM_OP_sp_p6obind_n32:
     case MVM_OP_sp_bind_i64:
     case MVM_OP_sp_bind_i32:
     case MVM_OP_sp_bind_n:
@@ -2822,7 +2856,8 @@ start:
         jg_append_call_c(tc, jg, op_to_func(tc, op), 2, args, MVM_JIT_RV_VOID, -1);
         break;
     }
-    case MVM_OP_open_fh: {
+    case MVM_OP_open_fh:
+    case MVM_OP_asyncopen: {
         MVMint16 dst  = ins->operands[0].reg.orig;
         MVMint16 path = ins->operands[1].reg.orig;
         MVMint16 mode = ins->operands[2].reg.orig;
@@ -2856,7 +2891,8 @@ start:
         jg_append_call_c(tc, jg, op_to_func(tc, op), 2, args, MVM_JIT_RV_INT, dst);
         break;
     }
-    case MVM_OP_write_fhb: {
+    case MVM_OP_write_fhb:
+    case MVM_OP_writev_fhb: {
         MVMint16 fho = ins->operands[0].reg.orig;
         MVMint16 buf = ins->operands[1].reg.orig;
         MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
@@ -2865,6 +2901,96 @@ start:
         jg_append_call_c(tc, jg, op_to_func(tc, op), 3, args, MVM_JIT_RV_VOID, -1);
         break;
     }
+    case MVM_OP_transfer_fh: {
+        MVMint16 dst    = ins->operands[0].reg.orig;
+        MVMint16 dest   = ins->operands[1].reg.orig;
+        MVMint16 source = ins->operands[2].reg.orig;
+        MVMint16 len    = ins->operands[3].reg.orig;
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { dest } },
+                                 { MVM_JIT_REG_VAL, { source } },
+                                 { MVM_JIT_REG_VAL, { len } } };
+        jg_append_call_c(tc, jg, op_to_func(tc, op), 4, args, MVM_JIT_RV_INT, dst);
+        break;
+    }
+    case MVM_OP_mmapfile: {
+        MVMint16 dst    = ins->operands[0].reg.orig;
+        MVMint16 type   = ins->operands[1].reg.orig;
+        MVMint16 path   = ins->operands[2].reg.orig;
+        MVMint16 offset = ins->operands[3].reg.orig;
+        MVMint16 len    = ins->operands[4].reg.orig;
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { type } },
+                                 { MVM_JIT_REG_VAL, { path } },
+                                 { MVM_JIT_REG_VAL, { offset } },
+                                 { MVM_JIT_REG_VAL, { len } } };
+        jg_append_call_c(tc, jg, op_to_func(tc, op), 5, args, MVM_JIT_RV_PTR, dst);
+        break;
+    }
+    case MVM_OP_mmapslice: {
+        MVMint16 dst    = ins->operands[0].reg.orig;
+        MVMint16 buf    = ins->operands[1].reg.orig;
+        MVMint16 offset = ins->operands[2].reg.orig;
+        MVMint16 len    = ins->operands[3].reg.orig;
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { buf } },
+                                 { MVM_JIT_REG_VAL, { offset } },
+                                 { MVM_JIT_REG_VAL, { len } } };
+        jg_append_call_c(tc, jg, op_to_func(tc, op), 4, args, MVM_JIT_RV_PTR, dst);
+        break;
+    }
+    case MVM_OP_mmapadvise: {
+        MVMint16 buf    = ins->operands[0].reg.orig;
+        MVMint16 offset = ins->operands[1].reg.orig;
+        MVMint16 len    = ins->operands[2].reg.orig;
+        MVMint16 advice = ins->operands[3].reg.orig;
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { buf } },
+                                 { MVM_JIT_REG_VAL, { offset } },
+                                 { MVM_JIT_REG_VAL, { len } },
+                                 { MVM_JIT_REG_VAL, { advice } } };
+        jg_append_call_c(tc, jg, op_to_func(tc, op), 5, args, MVM_JIT_RV_VOID, -1);
+        break;
+    }
+    case MVM_OP_mmapindex: {
+        MVMint16 dst    = ins->operands[0].reg.orig;
+        MVMint16 buf    = ins->operands[1].reg.orig;
+        MVMint16 needle = ins->operands[2].reg.orig;
+        MVMint16 start  = ins->operands[3].reg.orig;
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { buf } },
+                                 { MVM_JIT_REG_VAL, { needle } },
+                                 { MVM_JIT_REG_VAL, { start } } };
+        jg_append_call_c(tc, jg, op_to_func(tc, op), 4, args, MVM_JIT_RV_INT, dst);
+        break;
+    }
+    case MVM_OP_writeslice_fhb: {
+        MVMint16 fho    = ins->operands[0].reg.orig;
+        MVMint16 buf    = ins->operands[1].reg.orig;
+        MVMint16 offset = ins->operands[2].reg.orig;
+        MVMint16 len    = ins->operands[3].reg.orig;
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { fho } },
+                                 { MVM_JIT_REG_VAL, { buf } },
+                                 { MVM_JIT_REG_VAL, { offset } },
+                                 { MVM_JIT_REG_VAL, { len } } };
+        jg_append_call_c(tc, jg, op_to_func(tc, op), 5, args, MVM_JIT_RV_VOID, -1);
+        break;
+    }
+    case MVM_OP_readinto_fhb: {
+        MVMint16 dst    = ins->operands[0].reg.orig;
+        MVMint16 fho    = ins->operands[1].reg.orig;
+        MVMint16 buf    = ins->operands[2].reg.orig;
+        MVMint16 offset = ins->operands[3].reg.orig;
+        MVMint16 len    = ins->operands[4].reg.orig;
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { fho } },
+                                 { MVM_JIT_REG_VAL, { buf } },
+                                 { MVM_JIT_REG_VAL, { offset } },
+                                 { MVM_JIT_REG_VAL, { len } } };
+        jg_append_call_c(tc, jg, op_to_func(tc, op), 5, args, MVM_JIT_RV_INT, dst);
+        break;
+    }
     case MVM_OP_read_fhb: {
         MVMint16 fho = ins->operands[0].reg.orig;
         MVMint16 res = ins->operands[1].reg.orig;
@@ -3581,6 +3707,173 @@ start:
         jg_append_call_c(tc, jg, op_to_func(tc, op), 0, NULL, MVM_JIT_RV_INT, dst);
         break;
     }
+    case MVM_OP_fillpos_i:
+    case MVM_OP_fillpos_n: {
+        MVMint16 arr   = ins->operands[0].reg.orig;
+        MVMint16 value = ins->operands[1].reg.orig;
+        MVMint16 start = ins->operands[2].reg.orig;
+        MVMint16 count = ins->operands[3].reg.orig;
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { arr } },
+                                 { op == MVM_OP_fillpos_n ? MVM_JIT_REG_VAL_F : MVM_JIT_REG_VAL, { value } },
+                                 { MVM_JIT_REG_VAL, { start } },
+                                 { MVM_JIT_REG_VAL, { count } } };
+        jg_append_call_c(tc, jg, op_to_func(tc, op), 5, args, MVM_JIT_RV_VOID, -1);
+        jg_sc_wb(tc, jg, ins->operands[0]);
+        break;
+    }
+    case MVM_OP_reducepos_i:
+    case MVM_OP_reducepos_n: {
+        MVMint16 dst  = ins->operands[0].reg.orig;
+        MVMint16 arr  = ins->operands[1].reg.orig;
+        MVMint16 kind = ins->operands[2].reg.orig;
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { arr } },
+                                 { MVM_JIT_REG_VAL, { kind } } };
+        jg_append_call_c(tc, jg, op_to_func(tc, op), 3, args,
+            op == MVM_OP_reducepos_n ? MVM_JIT_RV_NUM : MVM_JIT_RV_INT, dst);
+        break;
+    }
+    case MVM_OP_binoppos: {
+        MVMint16 dest = ins->operands[0].reg.orig;
+        MVMint16 a    = ins->operands[1].reg.orig;
+        MVMint16 b    = ins->operands[2].reg.orig;
+        MVMint16 kind = ins->operands[3].reg.orig;
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { dest } },
+                                 { MVM_JIT_REG_VAL, { a } },
+                                 { MVM_JIT_REG_VAL, { b } },
+                                 { MVM_JIT_REG_VAL, { kind } } };
+        jg_append_call_c(tc, jg, op_to_func(tc, op), 5, args, MVM_JIT_RV_VOID, -1);
+        jg_sc_wb(tc, jg, ins->operands[0]);
+        break;
+    }
+    case MVM_OP_indexpos_i:
+    case MVM_OP_indexpos_n: {
+        MVMint16 dst   = ins->operands[0].reg.orig;
+        MVMint16 arr   = ins->operands[1].reg.orig;
+        MVMint16 value = ins->operands[2].reg.orig;
+        MVMint16 start = ins->operands[3].reg.orig;
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { arr } },
+                                 { op == MVM_OP_indexpos_n ? MVM_JIT_REG_VAL_F : MVM_JIT_REG_VAL, { value } },
+                                 { MVM_JIT_REG_VAL, { start } } };
+        jg_append_call_c(tc, jg, op_to_func(tc, op), 4, args, MVM_JIT_RV_INT, dst);
+        break;
+    }
+    case MVM_OP_sbappend_s:
+    case MVM_OP_sbappend_i:
+    case MVM_OP_sbappend_n:
+    case MVM_OP_sbappendcp: {
+        MVMint16 sb    = ins->operands[0].reg.orig;
+        MVMint16 value = ins->operands[1].reg.orig;
+        MVMJitCallArg argc[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { sb } },
+                                 { MVM_JIT_LITERAL_PTR, { (uintptr_t)MVM_op_get_op(op)->name } } };
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { sb } },
+                                 { op == MVM_OP_sbappend_n ? MVM_JIT_REG_VAL_F : MVM_JIT_REG_VAL, { value } } };
+        jg_append_call_c(tc, jg, &MVM_string_builder_ensure, 3, argc, MVM_JIT_RV_VOID, -1);
+        jg_append_call_c(tc, jg, op_to_func(tc, op), 3, args, MVM_JIT_RV_VOID, -1);
+        break;
+    }
+    case MVM_OP_sbelems:
+    case MVM_OP_sbfinish: {
+        MVMint16 dst = ins->operands[0].reg.orig;
+        MVMint16 sb  = ins->operands[1].reg.orig;
+        MVMJitCallArg argc[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { sb } },
+                                 { MVM_JIT_LITERAL_PTR, { (uintptr_t)MVM_op_get_op(op)->name } } };
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { sb } } };
+        jg_append_call_c(tc, jg, &MVM_string_builder_ensure, 3, argc, MVM_JIT_RV_VOID, -1);
+        jg_append_call_c(tc, jg, op_to_func(tc, op), 2, args,
+            op == MVM_OP_sbelems ? MVM_JIT_RV_INT : MVM_JIT_RV_PTR, dst);
+        break;
+    }
+    case MVM_OP_msconfigure: {
+        MVMint16 ms      = ins->operands[0].reg.orig;
+        MVMint16 needles = ins->operands[1].reg.orig;
+        MVMJitCallArg argc[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { ms } },
+                                 { MVM_JIT_LITERAL_PTR, { (uintptr_t)MVM_op_get_op(op)->name } } };
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { ms } },
+                                 { MVM_JIT_REG_VAL, { needles } } };
+        jg_append_call_c(tc, jg, &MVM_multi_search_ensure, 3, argc, MVM_JIT_RV_VOID, -1);
+        jg_append_call_c(tc, jg, op_to_func(tc, op), 3, args, MVM_JIT_RV_VOID, -1);
+        break;
+    }
+    case MVM_OP_msindex: {
+        MVMint16 dst      = ins->operands[0].reg.orig;
+        MVMint16 ms       = ins->operands[1].reg.orig;
+        MVMint16 haystack = ins->operands[2].reg.orig;
+        MVMint16 start    = ins->operands[3].reg.orig;
+        MVMJitCallArg argc[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { ms } },
+                                 { MVM_JIT_LITERAL_PTR, { (uintptr_t)MVM_op_get_op(op)->name } } };
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { ms } },
+                                 { MVM_JIT_REG_VAL, { haystack } },
+                                 { MVM_JIT_REG_VAL, { start } } };
+        jg_append_call_c(tc, jg, &MVM_multi_search_ensure, 3, argc, MVM_JIT_RV_VOID, -1);
+        jg_append_call_c(tc, jg, op_to_func(tc, op), 4, args, MVM_JIT_RV_INT, dst);
+        break;
+    }
+    case MVM_OP_mslastneedle: {
+        MVMint16 dst = ins->operands[0].reg.orig;
+        MVMint16 ms  = ins->operands[1].reg.orig;
+        MVMJitCallArg argc[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { ms } },
+                                 { MVM_JIT_LITERAL_PTR, { (uintptr_t)MVM_op_get_op(op)->name } } };
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { ms } } };
+        jg_append_call_c(tc, jg, &MVM_multi_search_ensure, 3, argc, MVM_JIT_RV_VOID, -1);
+        jg_append_call_c(tc, jg, op_to_func(tc, op), 2, args, MVM_JIT_RV_INT, dst);
+        break;
+    }
+    case MVM_OP_mssplit: {
+        MVMint16 dst   = ins->operands[0].reg.orig;
+        MVMint16 ms    = ins->operands[1].reg.orig;
+        MVMint16 input = ins->operands[2].reg.orig;
+        MVMJitCallArg argc[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { ms } },
+                                 { MVM_JIT_LITERAL_PTR, { (uintptr_t)MVM_op_get_op(op)->name } } };
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { ms } },
+                                 { MVM_JIT_REG_VAL, { input } } };
+        jg_append_call_c(tc, jg, &MVM_multi_search_ensure, 3, argc, MVM_JIT_RV_VOID, -1);
+        jg_append_call_c(tc, jg, op_to_func(tc, op), 3, args, MVM_JIT_RV_PTR, dst);
+        break;
+    }
+    case MVM_OP_unicollkey: {
+        MVMint16 dst     = ins->operands[0].reg.orig;
+        MVMint16 str     = ins->operands[1].reg.orig;
+        MVMint16 mode    = ins->operands[2].reg.orig;
+        MVMint16 lang    = ins->operands[3].reg.orig;
+        MVMint16 country = ins->operands[4].reg.orig;
+        MVMint16 buf     = ins->operands[5].reg.orig;
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { str } },
+                                 { MVM_JIT_REG_VAL, { mode } },
+                                 { MVM_JIT_REG_VAL, { lang } },
+                                 { MVM_JIT_REG_VAL, { country } },
+                                 { MVM_JIT_REG_VAL, { buf } } };
+        jg_append_call_c(tc, jg, op_to_func(tc, op), 6, args, MVM_JIT_RV_PTR, dst);
+        break;
+    }
+    case MVM_OP_parsenums: {
+        MVMint16 dst    = ins->operands[0].reg.orig;
+        MVMint16 dest   = ins->operands[1].reg.orig;
+        MVMint16 source = ins->operands[2].reg.orig;
+        MVMint16 sep    = ins->operands[3].reg.orig;
+        MVMJitCallArg args[] = { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } },
+                                 { MVM_JIT_REG_VAL, { dest } },
+                                 { MVM_JIT_REG_VAL, { source } },
+                                 { MVM_JIT_REG_VAL, { sep } } };
+        jg_append_call_c(tc, jg, op_to_func(tc, op), 4, args, MVM_JIT_RV_INT, dst);
+        break;
+    }
     case MVM_OP_getsignals: {
         MVMint16 dst = ins->operands[0].reg.orig;
         MVMJitCallArg args[] =  { { MVM_JIT_INTERP_VAR, { MVM_JIT_INTERP_TC } } };
@@ -885,6 +885,13 @@ MVMObject * MVM_coerce_sI(MVMThreadContext *tc, MVMString *s, MVMObject *type) {
                     : '?'; /* Add a filler bogus char if it can't fit */
             }
             break;
+        case MVM_STRING_GRAPHEME_16:
+            for (i = 0; i < s->body.num_graphs; i++) {
+                buf[i] = s->body.storage.blob_16[i] < 0x80
+                    ? s->body.storage.blob_16[i]
+                    : '?';
+            }
+            break;
         case MVM_STRING_STRAND: {
             MVMGraphemeIter gi;
             MVM_string_gi_init(tc, &gi, s);
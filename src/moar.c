@@ -76,7 +76,7 @@ MVMInstance * MVM_vm_create_instance(void) {
     MVMInstance *instance;
 
     char *spesh_log, *spesh_nodelay, *spesh_disable, *spesh_inline_disable,
-         *spesh_osr_disable, *spesh_limit, *spesh_blocking, *spesh_inline_log,
+         *spesh_osr_disable, *spesh_osr_sync, *spesh_limit, *spesh_blocking, *spesh_inline_log,
          *spesh_pea_disable;
     char *jit_expr_disable, *jit_disable, *jit_last_frame, *jit_last_bb;
     char *dynvar_log;
@@ -99,6 +99,15 @@ MVMInstance * MVM_vm_create_instance(void) {
     instance->hashSecrets[0] = 0;
     instance->hashSecrets[1] = 0;
 #endif
+    {
+        char *string_hash = getenv("MVM_STRING_HASH");
+        if (string_hash && strcmp(string_hash, "siphash") == 0)
+            instance->string_hash_function = MVM_STRING_HASH_SIPHASH;
+        else if (string_hash && strcmp(string_hash, "wyhash") == 0)
+            instance->string_hash_function = MVM_STRING_HASH_WYHASH;
+        else
+            instance->string_hash_function = MVM_STRING_HASH_DEFAULT;
+    }
     instance->main_thread->thread_id = 1;
 
     /* Next thread to be created gets ID 2 (the main thread got ID 1). */
@@ -170,8 +179,24 @@ MVMInstance * MVM_vm_create_instance(void) {
     /* Set up main thread's last_payload. */
     instance->main_thread->last_payload = instance->VMNull;
 
-    /* Initialize event loop thread starting mutex. */
+    /* Initialize event loop thread starting mutex, and decide how many
+     * event loops to spread async tasks over. */
     init_mutex(instance->mutex_event_loop, "event loop thread start");
+    {
+        char *event_loops = getenv("MVM_EVENT_LOOPS");
+        MVMint64 num = event_loops ? strtoll(event_loops, NULL, 10) : 0;
+        if (num < 1)
+            num = MVM_io_eventloop_default_count();
+        if (num > MVM_EVENT_LOOP_MAX)
+            num = MVM_EVENT_LOOP_MAX;
+        instance->num_event_loops = (MVMuint32)num;
+        instance->event_loops     = MVM_calloc(num, sizeof(MVMEventLoop));
+    }
+    {
+        char *io_uring = getenv("MVM_IO_URING");
+        instance->use_io_uring = !io_uring || strcmp(io_uring, "0") != 0;
+    }
+    instance->dns_cache = MVM_io_dns_cache_create();
 
     /* Create main thread object, and also make it the start of the all threads
      * linked list. Set up the mutex to protect it. */
@@ -227,6 +252,9 @@ MVMInstance * MVM_vm_create_instance(void) {
         spesh_osr_disable = getenv("MVM_SPESH_OSR_DISABLE");
         if (!spesh_osr_disable || !spesh_osr_disable[0])
             instance->spesh_osr_enabled = 1;
+        spesh_osr_sync = getenv("MVM_SPESH_OSR_SYNC");
+        if (spesh_osr_sync && spesh_osr_sync[0])
+            instance->spesh_osr_sync = 1;
         spesh_pea_disable = getenv("MVM_SPESH_PEA_DISABLE");
         if (!spesh_pea_disable || !spesh_pea_disable[0])
             instance->spesh_pea_enabled = 1;
@@ -357,6 +385,8 @@ MVMInstance * MVM_vm_create_instance(void) {
     else
         instance->dynvar_log_fh = NULL;
     instance->nfa_debug_enabled = getenv("MVM_NFA_DEB") ? 1 : 0;
+    instance->nfa_dfa_enabled = getenv("MVM_NFA_DFA_DISABLE") ? 0 : 1;
+    init_mutex(instance->mutex_nfa_dfa, "NFA DFA construction");
     if (getenv("MVM_CROSS_THREAD_WRITE_LOG")) {
         instance->cross_thread_write_logging = 1;
         instance->cross_thread_write_logging_include_locked =
@@ -557,6 +587,8 @@ void MVM_vm_destroy_instance(MVMInstance *instance) {
     MVM_spesh_worker_stop(instance->main_thread);
     MVM_spesh_worker_join(instance->main_thread);
     MVM_io_eventloop_destroy(instance->main_thread);
+    MVM_io_dns_cache_destroy(instance->dns_cache);
+    instance->dns_cache = NULL;
 
     /* Run the GC global destruction phase. After this,
      * no 6model object pointers should be accessed. */
@@ -623,6 +655,9 @@ void MVM_vm_destroy_instance(MVMInstance *instance) {
     /* Clean up parameterization addition mutex. */
     uv_mutex_destroy(&instance->mutex_parameterization_add);
 
+    /* Clean up NFA DFA construction mutex. */
+    uv_mutex_destroy(&instance->mutex_nfa_dfa);
+
     /* Clean up interned callsites */
     uv_mutex_destroy(&instance->mutex_callsite_interns);
     cleanup_callsite_interns(instance);
@@ -660,7 +695,8 @@ void MVM_vm_destroy_instance(MVMInstance *instance) {
     MVM_free(instance->int_const_cache);
     MVM_free(instance->int_to_str_cache);
 
-    /* Clean up event loop mutex. */
+    /* Clean up event loops and their mutex. */
+    MVM_free(instance->event_loops);
     uv_mutex_destroy(&instance->mutex_event_loop);
 
     /* Destroy main thread contexts and thread list mutex. */
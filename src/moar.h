@@ -170,6 +170,7 @@ MVM_PUBLIC const MVMint32 MVM_jit_support(void);
 #include "strings/nfg.h"
 #include "strings/normalize.h"
 #include "strings/decode_stream.h"
+#include "strings/multisearch.h"
 #include "strings/ascii.h"
 #include "strings/parse_num.h"
 #include "strings/utf8.h"
@@ -189,6 +190,7 @@ MVM_PUBLIC const MVMint32 MVM_jit_support(void);
 #include "io/eventloop.h"
 #include "io/syncfile.h"
 #include "io/syncsocket.h"
+#include "io/dnscache.h"
 #include "io/fileops.h"
 #include "io/dirops.h"
 #include "io/procops.h"
@@ -197,6 +199,8 @@ MVM_PUBLIC const MVMint32 MVM_jit_support(void);
 #include "io/signals.h"
 #include "io/asyncsocket.h"
 #include "io/asyncsocketudp.h"
+#include "io/uring.h"
+#include "io/asyncfile.h"
 #include "math/bigintops.h"
 #include "core/intcache.h"
 #include "core/fixedsizealloc.h"
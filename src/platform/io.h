@@ -13,3 +13,5 @@ short MVM_platform_is_fd_seekable(int fd);
 #else
 #define MVM_platform_is_fd_seekable(x) (MVM_platform_lseek((x), 0, SEEK_CUR) != -1)
 #endif
+
+MVMint64 MVM_platform_transfer_chunk(int out_fd, int in_fd, MVMint64 len, int *method);
@@ -2,8 +2,18 @@
 #define MVM_PAGE_WRITE   2
 #define MVM_PAGE_EXEC    4
 
+/* Hints about how a mapped range of a file is going to be accessed. */
+#define MVM_MAP_ADVISE_NORMAL     0
+#define MVM_MAP_ADVISE_RANDOM     1
+#define MVM_MAP_ADVISE_SEQUENTIAL 2
+#define MVM_MAP_ADVISE_WILLNEED   3
+#define MVM_MAP_ADVISE_DONTNEED   4
+
 void *MVM_platform_alloc_pages(size_t size, int mode);
 int MVM_platform_set_page_mode(void * block, size_t size, int mode);
 int MVM_platform_free_pages(void *block, size_t size);
 void *MVM_platform_map_file(int fd, void **handle, size_t size, int writable);
 int MVM_platform_unmap_file(void *block, void *handle, size_t size);
+size_t MVM_platform_map_granularity(void);
+void *MVM_platform_map_file_at(int fd, void **handle, MVMuint64 offset, size_t size);
+int MVM_platform_advise_mapping(void *addr, size_t size, int advice);
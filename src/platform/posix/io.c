@@ -1,9 +1,20 @@
-#if defined(__APPLE__) || defined(__Darwin__)
+#if defined(__linux__)
+/* splice needs _GNU_SOURCE, which must come before any system header. */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include <fcntl.h>
+#include <sys/sendfile.h>
+#include <sys/syscall.h>
+#endif
 #include <moar.h>
 #include <platform/io.h>
 #include <sys/types.h>
+#include <errno.h>
 #include <unistd.h>
 
+#if defined(__APPLE__) || defined(__Darwin__)
+
 short MVM_platform_is_fd_seekable(int fd) {
     off_t can_seek = MVM_platform_lseek(fd, 0, SEEK_CUR);
     if (can_seek != -1) {
@@ -20,3 +31,64 @@ short MVM_platform_is_fd_seekable(int fd) {
         return 0;
 }
 #endif
+
+#if defined(__linux__)
+/* The ways of moving data between descriptors, tried in this order until
+ * one of them works for the pair in question. */
+#define TRANSFER_COPY_FILE_RANGE 0
+#define TRANSFER_SENDFILE        1
+#define TRANSFER_SPLICE          2
+#define TRANSFER_NONE            3
+
+/* Whether a failure means the mechanism can't be used for these descriptors,
+ * rather than that the transfer itself went wrong. */
+static int transfer_unsupported(int err) {
+    return err == EINVAL || err == ENOSYS || err == EXDEV || err == EOPNOTSUPP
+        || err == ESPIPE;
+}
+#endif
+
+/* Moves up to len bytes from in_fd to out_fd without them being copied
+ * through user space, using the current position of both. method should
+ * start out as 0; it remembers which mechanism works between calls. Returns
+ * the number of bytes moved, 0 at the end of the input, or -1 with errno
+ * set; errno is ENOSYS when there's no way to do it here, and the caller
+ * should read and write instead. */
+MVMint64 MVM_platform_transfer_chunk(int out_fd, int in_fd, MVMint64 len, int *method) {
+#if defined(__linux__)
+    ssize_t r;
+    if (len > 0x7ffff000)
+        len = 0x7ffff000;
+    switch (*method) {
+        case TRANSFER_COPY_FILE_RANGE:
+#if defined(SYS_copy_file_range)
+            /* Some pseudo-filesystems claim to be empty to copy_file_range,
+             * so a zero result is checked with sendfile. An O_APPEND target
+             * is refused with EBADF. */
+            r = syscall(SYS_copy_file_range, in_fd, NULL, out_fd, NULL, (size_t)len, 0);
+            if (r > 0 || (r < 0 && !transfer_unsupported(errno) && errno != EBADF))
+                return r;
+            if (r < 0)
+                *method = TRANSFER_SENDFILE;
+#else
+            *method = TRANSFER_SENDFILE;
+#endif
+            /* Fall through. */
+        case TRANSFER_SENDFILE:
+            r = sendfile(out_fd, in_fd, NULL, (size_t)len);
+            if (r >= 0 || !transfer_unsupported(errno))
+                return r;
+            *method = TRANSFER_SPLICE;
+            /* Fall through. */
+        case TRANSFER_SPLICE:
+            /* Only works when one side is a pipe. */
+            r = splice(in_fd, NULL, out_fd, NULL, (size_t)len, SPLICE_F_MOVE);
+            if (r >= 0 || !transfer_unsupported(errno))
+                return r;
+            *method = TRANSFER_NONE;
+            break;
+    }
+#endif
+    errno = ENOSYS;
+    return -1;
+}
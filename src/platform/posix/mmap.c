@@ -3,6 +3,7 @@
 #include "moar.h"
 #include "platform/mmap.h"
 #include <errno.h>
+#include <unistd.h>
 
 /* MAP_ANONYMOUS is Linux, MAP_ANON is BSD */
 #ifndef MVM_MAP_ANON
@@ -75,3 +76,47 @@ int MVM_platform_unmap_file(void *block, void *handle, size_t size)
     (void)handle;
     return munmap(block, size) == 0;
 }
+
+/* Offsets into a file that is mapped have to be a multiple of this. */
+size_t MVM_platform_map_granularity(void)
+{
+    return (size_t)sysconf(_SC_PAGESIZE);
+}
+
+/* Maps part of a file read-only, starting at an offset that is a multiple
+ * of the granularity. */
+void *MVM_platform_map_file_at(int fd, void **handle, MVMuint64 offset, size_t size)
+{
+    void *block = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, (off_t)offset);
+
+    (void)handle;
+    return block != MAP_FAILED ? block : NULL;
+}
+
+/* Passes on a hint about how a mapped range will be accessed; the start
+ * need not be on a page boundary. */
+int MVM_platform_advise_mapping(void *addr, size_t size, int advice)
+{
+    size_t page  = MVM_platform_map_granularity();
+    size_t slack = (size_t)((uintptr_t)addr % page);
+    int    posix_advice;
+
+    switch (advice) {
+    case MVM_MAP_ADVISE_RANDOM:
+        posix_advice = POSIX_MADV_RANDOM;
+        break;
+    case MVM_MAP_ADVISE_SEQUENTIAL:
+        posix_advice = POSIX_MADV_SEQUENTIAL;
+        break;
+    case MVM_MAP_ADVISE_WILLNEED:
+        posix_advice = POSIX_MADV_WILLNEED;
+        break;
+    case MVM_MAP_ADVISE_DONTNEED:
+        posix_advice = POSIX_MADV_DONTNEED;
+        break;
+    default:
+        posix_advice = POSIX_MADV_NORMAL;
+        break;
+    }
+    return posix_madvise((char *)addr - slack, size + slack, posix_advice) == 0;
+}
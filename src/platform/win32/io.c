@@ -119,3 +119,10 @@ int MVM_platform_fsync(int fd) {
         return 0; /* Not something we can flush. */
     return -1;
 }
+
+/* There's no way to move bytes between arbitrary descriptors without them
+ * passing through user space, so callers always read and write. */
+MVMint64 MVM_platform_transfer_chunk(int out_fd, int in_fd, MVMint64 len, int *method) {
+    errno = ENOSYS;
+    return -1;
+}
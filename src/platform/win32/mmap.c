@@ -1,3 +1,4 @@
+#include "moar.h"
 #include <windows.h>
 #include <io.h>
 #include "platform/mmap.h"
@@ -79,3 +80,44 @@ int MVM_platform_unmap_file(void *block, void *handle, size_t size) {
     (void)size;
     return unmapped && closed;
 }
+
+size_t MVM_platform_map_granularity(void) {
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwAllocationGranularity;
+}
+
+void *MVM_platform_map_file_at(int fd, void **handle, MVMuint64 offset, size_t size) {
+    HANDLE fh, mapping;
+    LARGE_INTEGER li;
+    void *block;
+
+    fh = (HANDLE)_get_osfhandle(fd);
+    if (fh == INVALID_HANDLE_VALUE)
+        return NULL;
+
+    mapping = CreateFileMapping(fh, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mapping == NULL)
+        return NULL;
+
+    li.QuadPart = offset;
+    block = MapViewOfFile(mapping, FILE_MAP_READ, li.HighPart, li.LowPart, size);
+    if (block == NULL) {
+        CloseHandle(mapping);
+        return NULL;
+    }
+
+    if (handle)
+        *handle = mapping;
+
+    return block;
+}
+
+/* Windows has no equivalent of these hints for file mappings, so they are
+ * accepted and ignored. */
+int MVM_platform_advise_mapping(void *addr, size_t size, int advice) {
+    (void)addr;
+    (void)size;
+    (void)advice;
+    return 1;
+}
@@ -21,10 +21,10 @@ MVMSpeshLog * MVM_spesh_log_create(MVMThreadContext *tc, MVMThread *target_threa
     return result;
 }
 
-/* Increments the used count and - if it hits the limit - sends the log off
- * to the worker thread and NULLs it out. */
-void send_log(MVMThreadContext *tc, MVMSpeshLog *sl) {
-    if (tc->instance->spesh_blocking) {
+/* Sends the log off to the worker thread and NULLs it out, optionally
+ * waiting until the worker has processed it. */
+static void send_log_internal(MVMThreadContext *tc, MVMSpeshLog *sl, MVMint32 block) {
+    if (block) {
         uv_mutex_t *block_mutex;
         uv_cond_t *block_condvar;
         block_mutex = sl->body.block_mutex = MVM_malloc(sizeof(uv_mutex_t));
@@ -52,6 +52,12 @@ void send_log(MVMThreadContext *tc, MVMSpeshLog *sl) {
         tc->spesh_log = NULL;
     }
 }
+void send_log(MVMThreadContext *tc, MVMSpeshLog *sl) {
+    send_log_internal(tc, sl, tc->instance->spesh_blocking);
+}
+
+/* Increments the used count and - if it hits the limit - sends the log off
+ * to the worker thread. */
 void commit_entry(MVMThreadContext *tc, MVMSpeshLog *sl) {
     sl->body.used++;
     if (sl->body.used == sl->body.limit)
@@ -147,6 +153,15 @@ void MVM_spesh_log_osr(MVMThreadContext *tc) {
     commit_entry(tc, sl);
 }
 
+/* Sends the current log off early and waits for the worker to process it,
+ * so a hot loop gets specialized (and JIT-compiled) by the time we return,
+ * rather than after the log has filled up. */
+void MVM_spesh_log_send_and_wait(MVMThreadContext *tc) {
+    MVMSpeshLog *sl = tc->spesh_log;
+    if (sl && sl->body.used)
+        send_log_internal(tc, sl, 1);
+}
+
 /* Log a type. */
 void MVM_spesh_log_type(MVMThreadContext *tc, MVMObject *value) {
     MVMSpeshLog *sl = tc->spesh_log;
@@ -118,11 +118,34 @@ void perform_osr(MVMThreadContext *tc, MVMSpeshCandidate *specialized) {
     *(tc->interp_reg_base) = tc->cur_frame->work;
 }
 
+/* Counts OSR point hits in the current frame invocation and, once a loop is
+ * hot enough, hands the logged data to the specializer and waits for it, so
+ * we can move into the optimized code straight away. */
+static void maybe_specialize_now(MVMThreadContext *tc) {
+    MVMint32 seq_nr = tc->cur_frame->sequence_nr;
+    if (seq_nr != tc->osr_sync_frame_nr) {
+        tc->osr_sync_frame_nr = seq_nr;
+        tc->osr_sync_hits = 0;
+    }
+    if (++tc->osr_sync_hits == MVM_SPESH_OSR_SYNC_HITS && MVM_spesh_log_is_logging(tc)) {
+#if MVM_LOG_OSR
+    fprintf(stderr, "Synchronously specializing frame '%s' (cuid: %s) for OSR\n",
+        MVM_string_utf8_encode_C_string(tc, tc->cur_frame->static_info->body.name),
+        MVM_string_utf8_encode_C_string(tc, tc->cur_frame->static_info->body.cuuid));
+#endif
+        MVM_spesh_log_send_and_wait(tc);
+    }
+}
+
 /* Polls for an optimization and, when one is produced, jumps into it. */
 void MVM_spesh_osr_poll_for_result(MVMThreadContext *tc) {
-    MVMStaticFrameSpesh *spesh = tc->cur_frame->static_info->body.spesh;
-    MVMint32 num_cands = spesh->body.num_spesh_candidates;
+    MVMStaticFrameSpesh *spesh;
+    MVMint32 num_cands;
     MVMint32 seq_nr = tc->cur_frame->sequence_nr;
+    if (tc->instance->spesh_osr_sync && tc->instance->spesh_osr_enabled)
+        maybe_specialize_now(tc);
+    spesh = tc->cur_frame->static_info->body.spesh;
+    num_cands = spesh->body.num_spesh_candidates;
     if (seq_nr != tc->osr_hunt_frame_nr || num_cands != tc->osr_hunt_num_spesh_candidates) {
         /* Provided OSR is enabled... */
         if (tc->instance->spesh_osr_enabled) {
@@ -1 +1,6 @@
+/* Number of OSR point hits in a single frame invocation before we will, if
+ * MVM_SPESH_OSR_SYNC is set, specialize the frame synchronously. This must be
+ * above the planner's OSR thresholds, so a specialization will be made. */
+#define MVM_SPESH_OSR_SYNC_HITS 500
+
 void MVM_spesh_osr_poll_for_result(MVMThreadContext *tc);
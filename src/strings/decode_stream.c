@@ -309,31 +309,17 @@ MVMString * MVM_string_decodestream_get_chars(MVMThreadContext *tc, MVMDecodeStr
  * we do not encounter it, returns 0. This may mean more input buffers are needed
  * or that we reached the end of the stream. Note that it assumes the separator
  * will exist near the end of the buffer, if it occurs at all, due to decode
- * streams looking for stoppers. */
-static MVMint32 have_separator(MVMThreadContext *tc, MVMDecodeStreamChars *start_chars, MVMint32 start_pos,
-                               MVMDecodeStreamSeparators *sep_spec, MVMint32 sep_idx, MVMint32 sep_graph_pos) {
-    MVMint32 sep_pos = 1;
-    MVMint32 sep_length = sep_spec->sep_lengths[sep_idx];
-    MVMDecodeStreamChars *cur_chars = start_chars;
-    while (cur_chars) {
-        MVMint32 start = cur_chars == start_chars ? start_pos : 0;
-        MVMint32 i;
-        for (i = start; i < cur_chars->length; i++) {
-            if (cur_chars->chars[i] != sep_spec->sep_graphemes[sep_graph_pos])
-                return 0;
-            sep_pos++;
-            if (sep_pos == sep_length)
-                return 1;
-            sep_graph_pos++;
-        }
-        cur_chars = cur_chars->next;
-    }
-    return 0;
-}
+ * streams looking for stoppers. The separators are all matched in one pass by
+ * the separator spec's automaton; of those found, the one starting leftmost
+ * wins. */
 static MVMint32 find_separator(MVMThreadContext *tc, const MVMDecodeStream *ds,
                                MVMDecodeStreamSeparators *sep_spec, MVMint32 *sep_length,
                                int eof) {
+    MVMStringMultiSearch *ms = sep_spec->matcher;
     MVMint32 sep_loc = 0;
+    MVMint32 state = 0;
+    MVMint64 best_start = 0;
+    MVMint32 best_needle = -1;
     MVMDecodeStreamChars *cur_chars = ds->chars_head;
 
     /* First, skip over any buffers we need not consider. */
@@ -347,7 +333,7 @@ static MVMint32 find_separator(MVMThreadContext *tc, const MVMDecodeStream *ds,
 
     /* Now scan for the separator. */
     while (cur_chars) {
-        MVMint32 i, j;
+        MVMint32 i;
         MVMint32 start;
         if (eof) {
             start = cur_chars == ds->chars_head ? ds->chars_head_pos : 0;
@@ -361,34 +347,38 @@ static MVMint32 find_separator(MVMThreadContext *tc, const MVMDecodeStream *ds,
                     start = ds->chars_head_pos;
             }
             else {
-                if (start >= 0)
+                /* If a separator may be continuing over from the previous
+                 * buffer, we can't skip the start of this one. */
+                if (start >= 0 && state == 0)
                     sep_loc += start;
                 else
                     start = 0;
             }
         }
+
         for (i = start; i < cur_chars->length; i++) {
-            MVMint32 sep_graph_pos = 0;
             MVMGrapheme32 cur_char = cur_chars->chars[i];
             sep_loc++;
-            for (j = 0; j < sep_spec->num_seps; j++) {
-                if (sep_spec->sep_graphemes[sep_graph_pos] == cur_char) {
-                    if (sep_spec->sep_lengths[j] == 1) {
-                        *sep_length = 1;
-                        return sep_loc;
-                    }
-                    else if (have_separator(tc, cur_chars, i + 1, sep_spec, j, sep_graph_pos + 1)) {
-                        *sep_length = sep_spec->sep_lengths[j];
-                        sep_loc += sep_spec->sep_lengths[j] - 1;
-                        return sep_loc;
-                    }
-                }
-                sep_graph_pos += sep_spec->sep_lengths[j];
+            if (state == 0) {
+                if (best_needle >= 0)
+                    break;
+                if (!MVM_string_multi_search_may_start(ms, cur_char))
+                    continue;
             }
+            state = MVM_string_multi_search_step(ms, state, cur_char);
+            MVM_string_multi_search_consider(tc, ms, state, sep_loc, &best_start, &best_needle);
+            if (best_needle >= 0 && sep_loc - best_start + 1 >= ms->max_needle_length)
+                break;
         }
+        if (best_needle >= 0 && (i < cur_chars->length || state == 0))
+            break;
         cur_chars = cur_chars->next;
     }
-    return 0;
+
+    if (best_needle < 0)
+        return 0;
+    *sep_length = ms->needle_lengths[best_needle];
+    return (MVMint32)best_start + *sep_length - 1;
 }
 MVMString * MVM_string_decodestream_get_until_sep(MVMThreadContext *tc, MVMDecodeStream *ds,
                                                   MVMDecodeStreamSeparators *sep_spec, MVMint32 chomp) {
@@ -643,6 +633,10 @@ static void cache_sep_info(MVMThreadContext *tc, MVMDecodeStreamSeparators *sep_
     sep_spec->max_sep_length = max_sep_length;
     sep_spec->final_graphemes = final_graphemes;
     sep_spec->max_final_grapheme = max_final_grapheme;
+
+    MVM_string_multi_search_destroy(tc, sep_spec->matcher);
+    sep_spec->matcher = MVM_string_multi_search_create(tc, sep_spec->sep_graphemes,
+        sep_spec->sep_lengths, sep_spec->num_seps);
 }
 
 /* Sets a decode stream separator to its default value. */
@@ -657,6 +651,8 @@ void MVM_string_decode_stream_sep_default(MVMThreadContext *tc, MVMDecodeStreamS
     sep_spec->sep_lengths[1] = 1;
     sep_spec->sep_graphemes[1] = MVM_nfg_crlf_grapheme(tc);
 
+    sep_spec->matcher = NULL;
+
     cache_sep_info(tc, sep_spec);
 }
 
@@ -700,4 +696,5 @@ void MVM_string_decode_stream_sep_destroy(MVMThreadContext *tc, MVMDecodeStreamS
     MVM_free(sep_spec->sep_lengths);
     MVM_free(sep_spec->sep_graphemes);
     MVM_free(sep_spec->final_graphemes);
+    MVM_string_multi_search_destroy(tc, sep_spec->matcher);
 }
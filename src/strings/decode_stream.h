@@ -86,6 +86,9 @@ struct MVMDecodeStreamSeparators {
      * maximum codepoint/synthetic index of any final grapheme and doing a
      * quick comparison. */
     MVMGrapheme32 max_final_grapheme;
+
+    /* Matcher for all of the separators at once, used to locate them. */
+    MVMStringMultiSearch *matcher;
 };
 
 /* Checks if we may have encountered one of the separators. This just looks to
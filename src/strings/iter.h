@@ -3,6 +3,7 @@ struct MVMGraphemeIter {
     /* The blob we're currently iterating over. */
     union {
         MVMGrapheme32    *blob_32;
+        MVMGrapheme16    *blob_16;
         MVMGraphemeASCII *blob_ascii;
         MVMGrapheme8     *blob_8;
         void             *any;
@@ -141,6 +142,9 @@ MVM_STATIC_INLINE MVMStringIndex MVM_string_gi_graphs_left_in_strand(MVMThreadCo
 MVM_STATIC_INLINE MVMGrapheme8 * MVM_string_gi_active_blob_8_pos(MVMThreadContext *tc, MVMGraphemeIter *gi) {
     return gi->active_blob.blob_8 + gi->pos;
 }
+MVM_STATIC_INLINE MVMGrapheme16 * MVM_string_gi_active_blob_16_pos(MVMThreadContext *tc, MVMGraphemeIter *gi) {
+    return gi->active_blob.blob_16 + gi->pos;
+}
 MVM_STATIC_INLINE MVMGrapheme32 * MVM_string_gi_active_blob_32_pos(MVMThreadContext *tc, MVMGraphemeIter *gi) {
     return gi->active_blob.blob_32 + gi->pos;
 }
@@ -158,6 +162,8 @@ MVM_STATIC_INLINE MVMGrapheme32 MVM_string_gi_get_grapheme(MVMThreadContext *tc,
             switch (gi->blob_type) {
                 case MVM_STRING_GRAPHEME_32:
                     return gi->active_blob.blob_32[gi->pos++];
+                case MVM_STRING_GRAPHEME_16:
+                    return gi->active_blob.blob_16[gi->pos++];
                 case MVM_STRING_GRAPHEME_ASCII:
                     return gi->active_blob.blob_ascii[gi->pos++];
                 case MVM_STRING_GRAPHEME_8:
@@ -191,6 +197,8 @@ MVM_STATIC_INLINE MVMGrapheme32 MVM_string_get_grapheme_at_nocheck(MVMThreadCont
     switch (a->body.storage_type) {
         case MVM_STRING_GRAPHEME_32:
             return a->body.storage.blob_32[index];
+        case MVM_STRING_GRAPHEME_16:
+            return a->body.storage.blob_16[index];
         case MVM_STRING_GRAPHEME_ASCII:
             return a->body.storage.blob_ascii[index];
         case MVM_STRING_GRAPHEME_8:
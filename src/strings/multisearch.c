@@ -0,0 +1,242 @@
+#include "moar.h"
+
+/* Trie node used while building; children are kept in a singly linked list
+ * of edges, which is flattened into a sorted array once building is done. */
+typedef struct {
+    MVMGrapheme32 g;
+    MVMint32      target;
+    MVMint32      next;
+} BuildEdge;
+typedef struct {
+    MVMint32 first_child;
+    MVMint32 num_children;
+    MVMint32 needle;
+} BuildNode;
+
+static int compare_edges(const void *a, const void *b) {
+    MVMGrapheme32 ga = ((const MVMStringMultiSearchEdge *)a)->g;
+    MVMGrapheme32 gb = ((const MVMStringMultiSearchEdge *)b)->g;
+    return ga < gb ? -1 : ga > gb ? 1 : 0;
+}
+
+/* Builds a matcher for the given needles. The graphemes of all of them are
+ * in one array, and lengths says how many belong to each. Empty needles are
+ * ignored, since they'd match everywhere. */
+MVMStringMultiSearch * MVM_string_multi_search_create(MVMThreadContext *tc, MVMGrapheme32 *graphemes,
+        MVMint32 *lengths, MVMint32 num_needles) {
+    MVMStringMultiSearch *ms = MVM_calloc(1, sizeof(MVMStringMultiSearch));
+    MVMint32   total_graphs = 0;
+    MVMint32   num_nodes    = 1;
+    MVMint32   num_edges    = 0;
+    MVMint32   graph_pos    = 0;
+    BuildNode *build_nodes;
+    BuildEdge *build_edges;
+    MVMint32  *queue;
+    MVMint32   i, queue_head, queue_tail;
+
+    /* Worst case, every grapheme of every needle gets a node of its own. */
+    for (i = 0; i < num_needles; i++)
+        total_graphs += lengths[i];
+    build_nodes = MVM_malloc((total_graphs + 1) * sizeof(BuildNode));
+    build_edges = MVM_malloc((total_graphs ? total_graphs : 1) * sizeof(BuildEdge));
+    build_nodes[0].first_child  = -1;
+    build_nodes[0].num_children = 0;
+    build_nodes[0].needle       = -1;
+
+    ms->needle_lengths = MVM_malloc((num_needles ? num_needles : 1) * sizeof(MVMint32));
+    ms->num_needles    = num_needles;
+    for (i = 0; i < num_needles; i++) {
+        MVMint32 length = lengths[i];
+        MVMint32 node   = 0;
+        MVMint32 j;
+        ms->needle_lengths[i] = length;
+        if (length > ms->max_needle_length)
+            ms->max_needle_length = length;
+        for (j = 0; j < length; j++) {
+            MVMGrapheme32 g = graphemes[graph_pos + j];
+            MVMint32 edge = build_nodes[node].first_child;
+            while (edge >= 0 && build_edges[edge].g != g)
+                edge = build_edges[edge].next;
+            if (edge < 0) {
+                build_nodes[num_nodes].first_child  = -1;
+                build_nodes[num_nodes].num_children = 0;
+                build_nodes[num_nodes].needle       = -1;
+                build_edges[num_edges].g      = g;
+                build_edges[num_edges].target = num_nodes;
+                build_edges[num_edges].next   = build_nodes[node].first_child;
+                build_nodes[node].first_child = num_edges;
+                build_nodes[node].num_children++;
+                edge = num_edges++;
+                num_nodes++;
+            }
+            node = build_edges[edge].target;
+        }
+        if (length > 0 && build_nodes[node].needle < 0)
+            build_nodes[node].needle = i;
+        graph_pos += length;
+    }
+
+    /* Flatten the edges so each node's are contiguous and sorted. */
+    ms->num_nodes = num_nodes;
+    ms->nodes     = MVM_malloc(num_nodes * sizeof(MVMStringMultiSearchNode));
+    ms->edges     = MVM_malloc((num_edges ? num_edges : 1) * sizeof(MVMStringMultiSearchEdge));
+    num_edges     = 0;
+    for (i = 0; i < num_nodes; i++) {
+        MVMStringMultiSearchNode *node = &(ms->nodes[i]);
+        MVMint32 edge = build_nodes[i].first_child;
+        node->first_edge = num_edges;
+        node->num_edges  = build_nodes[i].num_children;
+        node->fail       = 0;
+        node->dict       = -1;
+        node->needle     = build_nodes[i].needle;
+        while (edge >= 0) {
+            ms->edges[num_edges].g      = build_edges[edge].g;
+            ms->edges[num_edges].target = build_edges[edge].target;
+            num_edges++;
+            edge = build_edges[edge].next;
+        }
+        qsort(ms->edges + node->first_edge, node->num_edges,
+            sizeof(MVMStringMultiSearchEdge), compare_edges);
+    }
+    MVM_free(build_nodes);
+    MVM_free(build_edges);
+
+    /* Compute failure and dictionary links breadth first, so that those of
+     * any shorter suffix are known by the time they're needed. */
+    queue      = MVM_malloc(num_nodes * sizeof(MVMint32));
+    queue_head = 0;
+    queue_tail = 0;
+    for (i = 0; i < (MVMint32)ms->nodes[0].num_edges; i++) {
+        MVMStringMultiSearchEdge *edge = &(ms->edges[ms->nodes[0].first_edge + i]);
+        queue[queue_tail++] = edge->target;
+        if (0 <= edge->g && edge->g < 256)
+            ms->first_low[edge->g >> 3] |= 1 << (edge->g & 7);
+        else
+            ms->first_other = 1;
+    }
+    while (queue_head < queue_tail) {
+        MVMint32 parent = queue[queue_head++];
+        MVMStringMultiSearchNode *parent_node = &(ms->nodes[parent]);
+        MVMuint32 j;
+        for (j = 0; j < parent_node->num_edges; j++) {
+            MVMStringMultiSearchEdge *edge = &(ms->edges[parent_node->first_edge + j]);
+            MVMStringMultiSearchNode *child = &(ms->nodes[edge->target]);
+            MVMint32 fail = MVM_string_multi_search_step(ms, parent_node->fail, edge->g);
+            child->fail = fail;
+            child->dict = ms->nodes[fail].needle >= 0 ? fail : ms->nodes[fail].dict;
+            queue[queue_tail++] = edge->target;
+        }
+    }
+    MVM_free(queue);
+
+    return ms;
+}
+
+/* Builds a matcher from a list of strings. */
+MVMStringMultiSearch * MVM_string_multi_search_from_strings(MVMThreadContext *tc, MVMObject *needles) {
+    MVMStringMultiSearch *ms;
+    MVMGrapheme32 *graphemes;
+    MVMint32 *lengths;
+    MVMint64 num_needles, i;
+    MVMint64 total_graphs = 0;
+    MVMint32 graph_pos    = 0;
+
+    if (!IS_CONCRETE(needles) || REPR(needles)->ID != MVM_REPR_ID_VMArray)
+        MVM_exception_throw_adhoc(tc, "msconfigure needs a concrete list of strings");
+    num_needles = MVM_repr_elems(tc, needles);
+    if (num_needles > 0xFFFFFF)
+        MVM_exception_throw_adhoc(tc, "Too many needles to search for");
+
+    lengths = MVM_malloc((num_needles ? num_needles : 1) * sizeof(MVMint32));
+    for (i = 0; i < num_needles; i++) {
+        MVMString *needle = MVM_repr_at_pos_s(tc, needles, i);
+        MVM_string_check_arg(tc, needle, "msconfigure");
+        lengths[i]    = MVM_string_graphs_nocheck(tc, needle);
+        total_graphs += lengths[i];
+        if (total_graphs > 0x7FFFFFFF) {
+            MVM_free(lengths);
+            MVM_exception_throw_adhoc(tc, "Needles to search for are too long");
+        }
+    }
+
+    graphemes = MVM_malloc((total_graphs ? total_graphs : 1) * sizeof(MVMGrapheme32));
+    for (i = 0; i < num_needles; i++) {
+        MVMString *needle = MVM_repr_at_pos_s(tc, needles, i);
+        MVMGraphemeIter gi;
+        MVM_string_gi_init(tc, &gi, needle);
+        while (MVM_string_gi_has_more(tc, &gi))
+            graphemes[graph_pos++] = MVM_string_gi_get_grapheme(tc, &gi);
+    }
+
+    ms = MVM_string_multi_search_create(tc, graphemes, lengths, (MVMint32)num_needles);
+    MVM_free(graphemes);
+    MVM_free(lengths);
+    return ms;
+}
+
+/* Having just stepped the automaton into the given state over the grapheme
+ * at end_pos, looks at every needle that ends there and keeps the match that
+ * starts leftmost (preferring the lowest needle index on a tie). */
+void MVM_string_multi_search_consider(MVMThreadContext *tc, MVMStringMultiSearch *ms, MVMint32 state,
+        MVMint64 end_pos, MVMint64 *best_start, MVMint32 *best_needle) {
+    MVMint32 node = ms->nodes[state].needle >= 0 ? state : ms->nodes[state].dict;
+    while (node >= 0) {
+        MVMint32 needle = ms->nodes[node].needle;
+        MVMint64 start  = end_pos - ms->needle_lengths[needle] + 1;
+        if (*best_needle < 0 || start < *best_start
+                || (start == *best_start && needle < *best_needle)) {
+            *best_start  = start;
+            *best_needle = needle;
+        }
+        node = ms->nodes[node].dict;
+    }
+}
+
+/* Finds the leftmost occurrence of any of the needles in the haystack at or
+ * after start, returning its position (or -1 if there is none) and setting
+ * needle to the index of the one found. */
+MVMint64 MVM_string_multi_search_index(MVMThreadContext *tc, MVMStringMultiSearch *ms, MVMString *haystack,
+        MVMint64 start, MVMint32 *needle) {
+    MVMGraphemeIter gi;
+    MVMint64 graphs      = MVM_string_graphs(tc, haystack);
+    MVMint64 best_start  = -1;
+    MVMint32 best_needle = -1;
+    MVMint32 state       = 0;
+    MVMint64 pos;
+
+    *needle = -1;
+    if (start < 0 || start > graphs || ms->max_needle_length == 0)
+        return -1;
+
+    MVM_string_gi_init(tc, &gi, haystack);
+    if (start)
+        MVM_string_gi_move_to(tc, &gi, start);
+    for (pos = start; pos < graphs; pos++) {
+        MVMGrapheme32 g = MVM_string_gi_get_grapheme(tc, &gi);
+        if (state == 0) {
+            /* Any match found already began before anything that could start
+             * from here, so it's the leftmost one. */
+            if (best_needle >= 0)
+                break;
+            if (!MVM_string_multi_search_may_start(ms, g))
+                continue;
+        }
+        state = MVM_string_multi_search_step(ms, state, g);
+        MVM_string_multi_search_consider(tc, ms, state, pos, &best_start, &best_needle);
+        if (best_needle >= 0 && pos - best_start + 1 >= ms->max_needle_length)
+            break;
+    }
+
+    *needle = best_needle;
+    return best_start;
+}
+
+/* Frees a matcher. */
+void MVM_string_multi_search_destroy(MVMThreadContext *tc, MVMStringMultiSearch *ms) {
+    if (ms) {
+        MVM_free(ms->nodes);
+        MVM_free(ms->edges);
+        MVM_free(ms->needle_lengths);
+        MVM_free(ms);
+    }
+}
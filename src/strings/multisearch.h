@@ -0,0 +1,73 @@
+/* A compiled set of needles to search for all at once, using an Aho-Corasick
+ * automaton over graphemes. Each node's outgoing edges are stored together,
+ * sorted by grapheme, in one array. */
+struct MVMStringMultiSearchEdge {
+    MVMGrapheme32 g;
+    MVMint32      target;
+};
+struct MVMStringMultiSearchNode {
+    /* This node's edges are edges[first_edge .. first_edge + num_edges). */
+    MVMuint32 first_edge;
+    MVMuint32 num_edges;
+
+    /* The node for the longest proper suffix of this one that is also in the
+     * trie, and the nearest node along that chain at which a needle ends (or
+     * -1 if there is none). */
+    MVMint32 fail;
+    MVMint32 dict;
+
+    /* The lowest-numbered needle ending at exactly this node, or -1. */
+    MVMint32 needle;
+};
+struct MVMStringMultiSearch {
+    MVMStringMultiSearchNode *nodes;
+    MVMStringMultiSearchEdge *edges;
+    MVMint32                 *needle_lengths;
+    MVMint32                  num_nodes;
+    MVMint32                  num_needles;
+    MVMint32                  max_needle_length;
+
+    /* Prefilter used while at the root: a bitmap of the needles' first
+     * graphemes that are in 0..255, and whether any first grapheme falls
+     * outside of that range. */
+    MVMuint8 first_low[32];
+    MVMuint8 first_other;
+};
+
+/* Checks if a grapheme could start a match, so that runs of graphemes that
+ * can't be skipped quickly while the automaton is at the root. */
+MVM_STATIC_INLINE MVMint32 MVM_string_multi_search_may_start(MVMStringMultiSearch *ms, MVMGrapheme32 g) {
+    return 0 <= g && g < 256
+        ? ms->first_low[g >> 3] & (1 << (g & 7))
+        : ms->first_other;
+}
+
+/* Advances the automaton from the given state over one grapheme. */
+MVM_STATIC_INLINE MVMint32 MVM_string_multi_search_step(MVMStringMultiSearch *ms, MVMint32 state, MVMGrapheme32 g) {
+    while (1) {
+        MVMStringMultiSearchNode *node  = &(ms->nodes[state]);
+        MVMStringMultiSearchEdge *edges = ms->edges + node->first_edge;
+        MVMuint32 lo = 0, hi = node->num_edges;
+        while (lo < hi) {
+            MVMuint32 mid = (lo + hi) / 2;
+            if (edges[mid].g < g)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        if (lo < node->num_edges && edges[lo].g == g)
+            return edges[lo].target;
+        if (state == 0)
+            return 0;
+        state = node->fail;
+    }
+}
+
+MVMStringMultiSearch * MVM_string_multi_search_create(MVMThreadContext *tc, MVMGrapheme32 *graphemes,
+    MVMint32 *lengths, MVMint32 num_needles);
+MVMStringMultiSearch * MVM_string_multi_search_from_strings(MVMThreadContext *tc, MVMObject *needles);
+void MVM_string_multi_search_consider(MVMThreadContext *tc, MVMStringMultiSearch *ms, MVMint32 state,
+    MVMint64 end_pos, MVMint64 *best_start, MVMint32 *best_needle);
+MVMint64 MVM_string_multi_search_index(MVMThreadContext *tc, MVMStringMultiSearch *ms, MVMString *haystack,
+    MVMint64 start, MVMint32 *needle);
+void MVM_string_multi_search_destroy(MVMThreadContext *tc, MVMStringMultiSearch *ms);
@@ -8,11 +8,18 @@
  * there is one, or negative if there is not (note 0 is a valid index). */
 static MVMint32 find_child_node_idx(MVMThreadContext *tc, const MVMNFGTrieNode *node, MVMCodepoint cp) {
     if (node) {
-        /* TODO: update this to do a binary search later on. */
-        MVMint32 i;
-        for (i = 0; i < node->num_entries; i++)
-            if (node->next_codes[i].code == cp)
-                return i;
+        /* Entries are sorted on codepoint, so binary search them. */
+        const MVMNFGTrieNodeEntry *entries = node->next_codes;
+        MVMint32 lo = 0, hi = node->num_entries;
+        while (lo < hi) {
+            MVMint32 mid = (lo + hi) / 2;
+            if (entries[mid].code < cp)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        if (lo < node->num_entries && entries[lo].code == cp)
+            return lo;
     }
     return -1;
 }
@@ -23,7 +30,7 @@ MVMNFGTrieNode * find_child_node(MVMThreadContext *tc, const MVMNFGTrieNode *nod
     return idx >= 0 ? node->next_codes[idx].node : NULL;
 }
 static MVMGrapheme32 lookup_synthetic(MVMThreadContext *tc, MVMCodepoint *codes, MVMint32 num_codes) {
-    MVMNFGTrieNode *cur_node        = tc->instance->nfg->grapheme_lookup;
+    MVMNFGTrieNode *cur_node        = (MVMNFGTrieNode *)MVM_load(&(tc->instance->nfg->grapheme_lookup));
     MVMCodepoint   *cur_code        = codes;
     MVMint32        codes_remaining = num_codes;
     while (cur_node && codes_remaining) {
@@ -136,8 +143,7 @@ static MVMNFGTrieNode * twiddle_trie_node(MVMThreadContext *tc, MVMNFGTrieNode *
 static void add_synthetic_to_trie(MVMThreadContext *tc, MVMCodepoint *codes, MVMint32 num_codes, MVMGrapheme32 synthetic) {
     MVMNFGState    *nfg      = tc->instance->nfg;
     MVMNFGTrieNode *new_trie = twiddle_trie_node(tc, nfg->grapheme_lookup, codes, num_codes, synthetic);
-    MVM_barrier();
-    nfg->grapheme_lookup = new_trie;
+    MVM_store(&(nfg->grapheme_lookup), new_trie);
 }
 
 /* Assumes that we are holding the lock that serializes updates, and already
@@ -221,11 +227,46 @@ static MVMGrapheme32 add_synthetic(MVMThreadContext *tc, MVMCodepoint *codes, MV
     return result;
 }
 
-/* Does a lookup of a synthetic in the trie. If we find one, returns it. If
- * not, acquires the update lock, re-checks that we really are missing the
- * synthetic, and then adds it. */
+/* Hashes a codepoint sequence to pick its slot in the per-thread cache. */
+static MVMuint32 hash_codes(MVMCodepoint *codes, MVMint32 num_codes) {
+    MVMuint32 hash = 0x811C9DC5;
+    MVMint32 i;
+    for (i = 0; i < num_codes; i++)
+        hash = (hash ^ (MVMuint32)codes[i]) * 0x01000193;
+    return hash ^ (hash >> 16);
+}
+
+/* Checks the thread's cache of recently resolved codepoint sequences. As
+ * synthetics are never removed or changed once created, a cached entry is
+ * valid for as long as its codepoints match. */
+static MVMGrapheme32 lookup_cached_synthetic(MVMThreadContext *tc, MVMNFGCacheEntry *entry,
+        MVMuint32 hash, MVMCodepoint *codes, MVMint32 num_codes) {
+    if (entry->synthetic && entry->hash == hash) {
+        MVMNFGSynthetic *synth = MVM_nfg_get_synthetic_info(tc, entry->synthetic);
+        if (synth->num_codes == num_codes
+                && memcmp(synth->codes, codes, num_codes * sizeof(MVMCodepoint)) == 0)
+            return entry->synthetic;
+    }
+    return 0;
+}
+
+/* Resolves a codepoint sequence to a synthetic. First looks in the thread's
+ * cache, then in the trie, which readers can always walk without a lock since
+ * updates copy the path they change and publish a new root. Only if we have
+ * to add the synthetic do we acquire the update lock, re-check that we really
+ * are missing it, and then add it. */
 static MVMGrapheme32 lookup_or_add_synthetic(MVMThreadContext *tc, MVMCodepoint *codes, MVMint32 num_codes, MVMint32 utf8_c8) {
-    MVMGrapheme32 result = lookup_synthetic(tc, codes, num_codes);
+    MVMuint32 hash = hash_codes(codes, num_codes);
+    MVMNFGCacheEntry *entry;
+    MVMGrapheme32 result;
+    if (!tc->nfg_cache)
+        tc->nfg_cache = MVM_calloc(MVM_NFG_CACHE_SIZE, sizeof(MVMNFGCacheEntry));
+    entry  = &(tc->nfg_cache[hash & (MVM_NFG_CACHE_SIZE - 1)]);
+    result = lookup_cached_synthetic(tc, entry, hash, codes, num_codes);
+    if (result)
+        return result;
+
+    result = lookup_synthetic(tc, codes, num_codes);
     if (!result) {
         uv_mutex_lock(&tc->instance->nfg->update_mutex);
         result = lookup_synthetic(tc, codes, num_codes);
@@ -233,6 +274,8 @@ static MVMGrapheme32 lookup_or_add_synthetic(MVMThreadContext *tc, MVMCodepoint
             result = add_synthetic(tc, codes, num_codes, utf8_c8);
         uv_mutex_unlock(&tc->instance->nfg->update_mutex);
     }
+    entry->hash      = hash;
+    entry->synthetic = result;
     return result;
 }
 
@@ -398,17 +441,21 @@ MVM_STATIC_INLINE MVMint32 codepoint_GCB_Control (MVMThreadContext *tc, MVMCodep
 /* Returns non-zero if the result of concatenating the two strings will freely
  * leave us in NFG without any further effort. */
 MVMint32 MVM_nfg_is_concat_stable(MVMThreadContext *tc, MVMString *a, MVMString *b) {
-    MVMGrapheme32 last_a;
-    MVMGrapheme32 first_b;
-    MVMGrapheme32 crlf;
-
     /* If either string is empty, we're good. */
     if (a->body.num_graphs == 0 || b->body.num_graphs == 0)
         return 1;
 
     /* Get first and last graphemes of the strings. */
-    last_a  = MVM_string_get_grapheme_at_nocheck(tc, a, a->body.num_graphs - 1);
-    first_b = MVM_string_get_grapheme_at_nocheck(tc, b, 0);
+    return MVM_nfg_is_concat_stable_graphemes(tc,
+        MVM_string_get_grapheme_at_nocheck(tc, a, a->body.num_graphs - 1),
+        MVM_string_get_grapheme_at_nocheck(tc, b, 0));
+}
+
+/* Returns non-zero if placing grapheme first_b right after grapheme last_a
+ * will leave us in NFG without any further effort. */
+MVMint32 MVM_nfg_is_concat_stable_graphemes(MVMThreadContext *tc, MVMGrapheme32 last_a, MVMGrapheme32 first_b) {
+    MVMGrapheme32 crlf;
+
     /* Put the case where we are adding a lf or crlf line ending */
     if (first_b == '\n')
         /* If we see \r + \n we need to renormalize. Otherwise we're good */
@@ -76,6 +76,14 @@ struct MVMNFGTrieNodeEntry {
     MVMNFGTrieNode *node;
 };
 
+/* An entry in a thread's cache of codepoint sequences it recently resolved
+ * to synthetics. The cache is direct mapped on the hash of the sequence. */
+struct MVMNFGCacheEntry {
+    MVMuint32     hash;
+    MVMGrapheme32 synthetic;
+};
+#define MVM_NFG_CACHE_SIZE 256
+
 /* The maximum number of codepoints we will allow in a synthetic grapheme.
  * This is a good bit higher than any real-world use case is going to run
  * in to. */
@@ -88,6 +96,7 @@ MVMGrapheme32 MVM_nfg_crlf_grapheme(MVMThreadContext *tc);
 MVMNFGSynthetic * MVM_nfg_get_synthetic_info(MVMThreadContext *tc, MVMGrapheme32 synth);
 MVMuint32 MVM_nfg_get_case_change(MVMThreadContext *tc, MVMGrapheme32 codepoint, MVMint32 case_, MVMGrapheme32 **result);
 MVMint32 MVM_nfg_is_concat_stable(MVMThreadContext *tc, MVMString *a, MVMString *b);
+MVMint32 MVM_nfg_is_concat_stable_graphemes(MVMThreadContext *tc, MVMGrapheme32 last_a, MVMGrapheme32 first_b);
 
 /* NFG subsystem initialization and cleanup. */
 void MVM_nfg_init(MVMThreadContext *tc);
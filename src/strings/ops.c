@@ -1,8 +1,8 @@
 #include "platform/memmem.h"
 #include "platform/memmem32.h"
 #include "moar.h"
+#include "strings/wyhash.h"
 #define MVM_DEBUG_STRANDS 0
-#define MVM_string_KMP_max_pattern_length 8192
 /* Max value possible for MVMuint32 MVMStringBody.num_graphs */
 #define MAX_GRAPHEMES     0xFFFFFFFFLL
 
@@ -228,6 +228,10 @@ static int string_can_be_8bit(MVMThreadContext *tc, MVMGraphemeIter *gi_orig, MV
             if (!MVM_string_buf32_can_fit_into_8bit(MVM_string_gi_active_blob_32_pos(tc, &gi), togo))
                 return 0;
         }
+        else if (MVM_string_gi_blob_type(tc, &gi) == MVM_STRING_GRAPHEME_16) {
+            if (!MVM_string_buf16_can_fit_into_8bit(MVM_string_gi_active_blob_16_pos(tc, &gi), togo))
+                return 0;
+        }
         pos += togo;
         if (num_graphs == pos || !MVM_string_gi_has_more_strands_rep(tc, &gi)) {
             break;
@@ -237,6 +241,43 @@ static int string_can_be_8bit(MVMThreadContext *tc, MVMGraphemeIter *gi_orig, MV
     return 1;
 
 }
+/* Checks if the next num_graphs graphemes in the iterator can fit into 16
+ * bits, that is they're all BMP codepoints with no synthetics among them.
+ * NOTE: GraphemeIter is not modified by this function. */
+static int string_can_be_16bit(MVMThreadContext *tc, MVMGraphemeIter *gi_orig, MVMStringIndex num_graphs) {
+    MVMStringIndex pos = 0;
+    MVMGraphemeIter gi;
+    memcpy(&gi, gi_orig, sizeof(MVMGraphemeIter));
+    while (1) {
+        MVMStringIndex strand_len = MVM_string_gi_graphs_left_in_strand(tc, &gi);
+        MVMStringIndex togo = num_graphs - pos < strand_len
+            ? num_graphs - pos
+            : strand_len;
+        switch (MVM_string_gi_blob_type(tc, &gi)) {
+            case MVM_STRING_GRAPHEME_32:
+                if (!MVM_string_buf32_can_fit_into_16bit(MVM_string_gi_active_blob_32_pos(tc, &gi), togo))
+                    return 0;
+                break;
+            case MVM_STRING_GRAPHEME_8: {
+                MVMGrapheme8 *active_blob = MVM_string_gi_active_blob_8_pos(tc, &gi);
+                MVMGrapheme8  val = 0;
+                MVMStringIndex i;
+                MVM_VECTORIZE_LOOP
+                for (i = 0; i < togo; i++)
+                    val |= active_blob[i];
+                if (val < 0)
+                    return 0;
+                break;
+            }
+        }
+        pos += togo;
+        if (num_graphs == pos || !MVM_string_gi_has_more_strands_rep(tc, &gi)) {
+            break;
+        }
+        MVM_string_gi_next_strand_rep(tc, &gi);
+    }
+    return 1;
+}
 /* Accepts an allocated string that should have body.num_graphs set but the blob
  * unallocated. This function will allocate the space for the blob and iterate
  * the supplied grapheme iterator for the length of body.num_graphs. Very fast
@@ -244,6 +285,7 @@ static int string_can_be_8bit(MVMThreadContext *tc, MVMGraphemeIter *gi_orig, MV
 static void iterate_gi_into_string(MVMThreadContext *tc, MVMGraphemeIter *gi, MVMString *result, MVMString *orig, MVMStringIndex num) {
     int result_pos = 0;
     MVMGrapheme8   *result8   = NULL;
+    MVMGrapheme16 *result16   = NULL;
     MVMGrapheme32 *result32   = NULL;
     MVMStringIndex result_graphs = MVM_string_graphs_nocheck(tc, result);
     if (!result_graphs)
@@ -272,6 +314,16 @@ static void iterate_gi_into_string(MVMThreadContext *tc, MVMGraphemeIter *gi, MV
                 }
                 break;
             }
+            case MVM_STRING_GRAPHEME_16: {
+                MVMStringIndex i;
+                MVMGrapheme16 *active_blob =
+                    MVM_string_gi_active_blob_16_pos(tc, gi);
+                MVM_VECTORIZE_LOOP
+                for (i = 0; i < to_copy; i++) {
+                    result_blob8[i] = active_blob[i];
+                }
+                break;
+            }
             case MVM_STRING_GRAPHEME_8:
             case MVM_STRING_GRAPHEME_ASCII: {
                 memcpy(
@@ -292,6 +344,58 @@ static void iterate_gi_into_string(MVMThreadContext *tc, MVMGraphemeIter *gi, MV
             MVM_string_gi_next_strand_rep(tc, gi);
         }
     }
+    else if (string_can_be_16bit(tc, gi, result_graphs)) {
+        MVMStringIndex result_pos = 0;
+        result->body.storage_type = MVM_STRING_GRAPHEME_16;
+        result16 = result->body.storage.blob_16 =
+            MVM_malloc(result_graphs * sizeof(MVMGrapheme16));
+        while (1) {
+            MVMStringIndex strand_len = MVM_string_gi_graphs_left_in_strand(tc, gi);
+            MVMStringIndex to_copy = result_graphs - result_pos < strand_len
+                ? result_graphs - result_pos
+                : strand_len;
+            MVMGrapheme16 *result_blob16 = result16 + result_pos;
+            switch (MVM_string_gi_blob_type(tc, gi)) {
+                case MVM_STRING_GRAPHEME_8:
+                case MVM_STRING_GRAPHEME_ASCII: {
+                    MVMGrapheme8  *active_blob =
+                        MVM_string_gi_active_blob_8_pos(tc, gi);
+                    MVMStringIndex i;
+                    MVM_VECTORIZE_LOOP
+                    for (i = 0; i < to_copy; i++) {
+                        result_blob16[i] = active_blob[i];
+                    }
+                    break;
+                }
+                case MVM_STRING_GRAPHEME_16: {
+                    memcpy(
+                        result_blob16,
+                        MVM_string_gi_active_blob_16_pos(tc, gi),
+                        to_copy * sizeof(MVMGrapheme16)
+                    );
+                    break;
+                }
+                case MVM_STRING_GRAPHEME_32: {
+                    MVMGrapheme32 *active_blob =
+                        MVM_string_gi_active_blob_32_pos(tc, gi);
+                    MVMStringIndex i;
+                    MVM_VECTORIZE_LOOP
+                    for (i = 0; i < to_copy; i++) {
+                        result_blob16[i] = active_blob[i];
+                    }
+                    break;
+                }
+                default:
+                    MVM_exception_throw_adhoc(tc,
+                        "Internal error, string corruption in iterate_gi_into_string\n");
+            }
+            result_pos += to_copy;
+            if (result_graphs <= result_pos || !MVM_string_gi_has_more_strands_rep(tc, gi)) {
+                break;
+            }
+            MVM_string_gi_next_strand_rep(tc, gi);
+        }
+    }
     else {
         MVMStringIndex result_pos = 0;
         result->body.storage_type            = MVM_STRING_GRAPHEME_32;
@@ -315,6 +419,17 @@ static void iterate_gi_into_string(MVMThreadContext *tc, MVMGraphemeIter *gi, MV
                     }
                     break;
                 }
+                case MVM_STRING_GRAPHEME_16: {
+                    MVMGrapheme16 *active_blob =
+                        MVM_string_gi_active_blob_16_pos(tc, gi);
+                    MVMGrapheme32 *result_blob32 = result32 + result_pos;
+                    MVMStringIndex i;
+                    MVM_VECTORIZE_LOOP
+                    for (i = 0; i < to_copy; i++) {
+                        result_blob32[i] = active_blob[i];
+                    }
+                    break;
+                }
                 case MVM_STRING_GRAPHEME_32: {
                     memcpy(
                         result32 + result_pos,
@@ -394,6 +509,9 @@ static MVMString * collapse_strands(MVMThreadContext *tc, MVMString *orig) {
                 case MVM_STRING_GRAPHEME_32:
                     copy_strands_memcpy(blob_32, MVMGrapheme32, MVM_STRING_GRAPHEME_32);
                     break;
+                case MVM_STRING_GRAPHEME_16:
+                    copy_strands_memcpy(blob_16, MVMGrapheme16, MVM_STRING_GRAPHEME_16);
+                    break;
                 case MVM_STRING_GRAPHEME_ASCII:
                 case MVM_STRING_GRAPHEME_8:
                     copy_strands_memcpy(blob_8, MVMGrapheme8, MVM_STRING_GRAPHEME_8);
@@ -468,6 +586,12 @@ static MVMString * re_nfg(MVMThreadContext *tc, MVMString *in) {
     return out;
 }
 
+/* Renormalizes a string to NFG, for producers outside of this file that
+ * assemble graphemes without checking each boundary as they go. */
+MVMString * MVM_string_renormalize(MVMThreadContext *tc, MVMString *s) {
+    return re_nfg(tc, s);
+}
+
 /* Returns nonzero if two substrings are equal, doesn't check bounds */
 MVMint64 MVM_string_substrings_equal_nocheck(MVMThreadContext *tc, MVMString *a,
         MVMint64 starta, MVMint64 length, MVMString *b, MVMint64 startb) {
@@ -482,6 +606,13 @@ MVMint64 MVM_string_substrings_equal_nocheck(MVMThreadContext *tc, MVMString *a,
                     b->body.storage.blob_32 + startb,
                     length * sizeof(MVMGrapheme32));
             break;
+        case MVM_STRING_GRAPHEME_16:
+            if (b->body.storage_type == MVM_STRING_GRAPHEME_16)
+                return 0 == memcmp(
+                    a->body.storage.blob_16 + starta,
+                    b->body.storage.blob_16 + startb,
+                    length * sizeof(MVMGrapheme16));
+            break;
         case MVM_STRING_GRAPHEME_ASCII:
         case MVM_STRING_GRAPHEME_8:
             if (b->body.storage_type == MVM_STRING_GRAPHEME_ASCII ||
@@ -538,22 +669,232 @@ static MVMint64 MVM_string_memmem_grapheme32 (MVMThreadContext *tc, MVMGrapheme3
     MVMGrapheme32 * rtrn = memmem_uint32(H_blob32 + H_start, H_graphs - H_start, n_blob32, n_graphs);
     return rtrn == NULL ? -1 : rtrn - H_blob32;
 }
-static MVMint64 MVM_string_memmem_grapheme32str (MVMThreadContext *tc, MVMString *Haystack, MVMString *needle, MVMint64 H_start, MVMStringIndex H_graphs, MVMStringIndex n_graphs) {
-    MVMGrapheme32 *needle_buf = NULL;
-    MVMint64 rtrn;
-    if (needle->body.storage_type != MVM_STRING_GRAPHEME_32) {
-        MVMStringIndex i;
-        MVMGraphemeIter n_gi;
-        needle_buf = MVM_malloc(needle->body.num_graphs * sizeof(MVMGrapheme32));
-        if (needle->body.storage_type != MVM_STRING_GRAPHEME_8) MVM_string_gi_init(tc, &n_gi, needle);
-        for (i = 0; i < needle->body.num_graphs; i++) {
-            needle_buf[i] = needle->body.storage_type == MVM_STRING_GRAPHEME_8 ? needle->body.storage.blob_8[i] : MVM_string_gi_get_grapheme(tc, &n_gi);
+/* First-and-last grapheme filtering search, for flat haystacks of 16 or 32
+ * bit graphemes and short needles. A block of candidate positions is checked
+ * against the needle's first and last graphemes in a loop the compiler can
+ * vectorize, and only the positions passing both are compared in full. */
+#define MVM_STRING_INDEX_FILTER_BLOCK 64
+#define define_filter_memmem(NAME, TYPE) \
+static MVMint64 NAME(const TYPE *H, size_t H_len, const TYPE *n, size_t n_len) { \
+    const TYPE first = n[0]; \
+    const TYPE last  = n[n_len - 1]; \
+    size_t i = 0; \
+    if (H_len < n_len) \
+        return -1; \
+    while (i + n_len <= H_len) { \
+        MVMuint8 hits[MVM_STRING_INDEX_FILTER_BLOCK]; \
+        size_t block = H_len - n_len + 1 - i; \
+        size_t j; \
+        if (MVM_STRING_INDEX_FILTER_BLOCK < block) \
+            block = MVM_STRING_INDEX_FILTER_BLOCK; \
+        MVM_VECTORIZE_LOOP \
+        for (j = 0; j < block; j++) \
+            hits[j] = (H[i + j] == first) & (H[i + j + n_len - 1] == last); \
+        for (j = 0; j < block; j++) \
+            if (hits[j] && (n_len <= 2 \
+                    || 0 == memcmp(H + i + j + 1, n + 1, (n_len - 2) * sizeof(TYPE)))) \
+                return i + j; \
+        i += block; \
+    } \
+    return -1; \
+}
+define_filter_memmem(memmem_filter_grapheme16, MVMGrapheme16)
+define_filter_memmem(memmem_filter_grapheme32, MVMGrapheme32)
+
+/* Needles shorter than this are searched for in 16-bit and 32-bit haystacks
+ * with the filter above; longer ones use Two-Way. */
+#define MVM_STRING_INDEX_TWOWAY_MIN 32
+
+/* A needle prepared for searching flat haystacks of any storage width. The
+ * copies in other widths are made the first time they are wanted, and only
+ * if the needle fits; a width it does not fit can't match. */
+typedef struct {
+    MVMString     *needle;
+    MVMStringIndex graphs;
+    MVMGrapheme32 *blob_32;
+    MVMGrapheme16 *blob_16;
+    MVMGrapheme8  *blob_8;
+    MVMuint8       owned_32, owned_16, owned_8;
+    MVMuint8       tried_16, tried_8;
+} MVMStringIndexNeedle;
+
+static void index_needle_init(MVMThreadContext *tc, MVMStringIndexNeedle *n, MVMString *needle) {
+    memset(n, 0, sizeof(MVMStringIndexNeedle));
+    n->needle = needle;
+    n->graphs = MVM_string_graphs_nocheck(tc, needle);
+    switch (needle->body.storage_type) {
+        case MVM_STRING_GRAPHEME_32:
+            n->blob_32 = needle->body.storage.blob_32;
+            break;
+        case MVM_STRING_GRAPHEME_16:
+            n->blob_16  = needle->body.storage.blob_16;
+            n->tried_16 = 1;
+            break;
+        case MVM_STRING_GRAPHEME_ASCII:
+        case MVM_STRING_GRAPHEME_8:
+            n->blob_8  = needle->body.storage.blob_8;
+            n->tried_8 = 1;
+            break;
+    }
+}
+static MVMGrapheme32 * index_needle_32(MVMThreadContext *tc, MVMStringIndexNeedle *n) {
+    if (!n->blob_32) {
+        MVMGraphemeIter gi;
+        MVMStringIndex  i;
+        n->blob_32  = MVM_malloc(n->graphs * sizeof(MVMGrapheme32));
+        n->owned_32 = 1;
+        MVM_string_gi_init(tc, &gi, n->needle);
+        for (i = 0; i < n->graphs; i++)
+            n->blob_32[i] = MVM_string_gi_get_grapheme(tc, &gi);
+    }
+    return n->blob_32;
+}
+static MVMGrapheme16 * index_needle_16(MVMThreadContext *tc, MVMStringIndexNeedle *n) {
+    if (!n->tried_16) {
+        MVMGrapheme32 *blob_32 = index_needle_32(tc, n);
+        n->tried_16 = 1;
+        if (MVM_string_buf32_can_fit_into_16bit(blob_32, n->graphs)) {
+            MVMStringIndex i;
+            n->blob_16  = MVM_malloc(n->graphs * sizeof(MVMGrapheme16));
+            n->owned_16 = 1;
+            MVM_VECTORIZE_LOOP
+            for (i = 0; i < n->graphs; i++)
+                n->blob_16[i] = blob_32[i];
+        }
+    }
+    return n->blob_16;
+}
+static MVMGrapheme8 * index_needle_8(MVMThreadContext *tc, MVMStringIndexNeedle *n) {
+    if (!n->tried_8) {
+        MVMGrapheme32 *blob_32 = index_needle_32(tc, n);
+        n->tried_8 = 1;
+        if (MVM_string_buf32_can_fit_into_8bit(blob_32, n->graphs)) {
+            MVMStringIndex i;
+            n->blob_8  = MVM_malloc(n->graphs * sizeof(MVMGrapheme8));
+            n->owned_8 = 1;
+            MVM_VECTORIZE_LOOP
+            for (i = 0; i < n->graphs; i++)
+                n->blob_8[i] = blob_32[i];
+        }
+    }
+    return n->blob_8;
+}
+static void index_needle_destroy(MVMThreadContext *tc, MVMStringIndexNeedle *n) {
+    if (n->owned_32) MVM_free(n->blob_32);
+    if (n->owned_16) MVM_free(n->blob_16);
+    if (n->owned_8)  MVM_free(n->blob_8);
+}
+
+/* Searches for the needle lying wholly within graphemes from..to of a string
+ * with flat storage, picking the algorithm by storage width and needle
+ * length. Returns the index in the flat string, or -1. */
+static MVMint64 index_in_flat(MVMThreadContext *tc, MVMString *H, MVMStringIndex from,
+        MVMStringIndex to, MVMStringIndexNeedle *n) {
+    MVMint64 found;
+    if (to < from || to - from < n->graphs)
+        return -1;
+    switch (H->body.storage_type) {
+        case MVM_STRING_GRAPHEME_32: {
+            MVMGrapheme32 *n_blob = index_needle_32(tc, n);
+            if (n->graphs < MVM_STRING_INDEX_TWOWAY_MIN) {
+                found = memmem_filter_grapheme32(H->body.storage.blob_32 + from,
+                    to - from, n_blob, n->graphs);
+            }
+            else {
+                MVMGrapheme32 *rtrn = memmem_uint32(H->body.storage.blob_32 + from,
+                    to - from, n_blob, n->graphs);
+                found = rtrn ? rtrn - (H->body.storage.blob_32 + from) : -1;
+            }
+            break;
+        }
+        case MVM_STRING_GRAPHEME_16: {
+            MVMGrapheme16 *n_blob = index_needle_16(tc, n);
+            if (!n_blob)
+                return -1;
+            if (n->graphs < MVM_STRING_INDEX_TWOWAY_MIN) {
+                found = memmem_filter_grapheme16(H->body.storage.blob_16 + from,
+                    to - from, n_blob, n->graphs);
+            }
+            else {
+                /* There's no 16-bit Two-Way, so widen the haystack to use
+                 * the 32-bit one and stay linear for long needles. */
+                MVMGrapheme16 *H_blob = H->body.storage.blob_16 + from;
+                MVMGrapheme32 *H_32   = MVM_malloc((to - from) * sizeof(MVMGrapheme32));
+                MVMGrapheme32 *rtrn;
+                MVMStringIndex i;
+                MVM_VECTORIZE_LOOP
+                for (i = 0; i < to - from; i++)
+                    H_32[i] = H_blob[i];
+                rtrn  = memmem_uint32(H_32, to - from, index_needle_32(tc, n), n->graphs);
+                found = rtrn ? rtrn - H_32 : -1;
+                MVM_free(H_32);
+            }
+            break;
+        }
+        case MVM_STRING_GRAPHEME_ASCII:
+        case MVM_STRING_GRAPHEME_8: {
+            /* The platform memmem does its own SIMD filtering and falls back
+             * to Two-Way for long needles. */
+            MVMGrapheme8 *n_blob = index_needle_8(tc, n);
+            void         *rtrn;
+            if (!n_blob)
+                return -1;
+            rtrn  = MVM_memmem(H->body.storage.blob_8 + from, to - from,
+                n_blob, n->graphs * sizeof(MVMGrapheme8));
+            found = rtrn ? (MVMGrapheme8 *)rtrn - (H->body.storage.blob_8 + from) : -1;
+            break;
+        }
+        default:
+            MVM_exception_throw_adhoc(tc, "String corruption detected: bad storage type");
+    }
+    return found < 0 ? -1 : from + found;
+}
+
+/* Searches a strand haystack without flattening it. Each strand (and each
+ * repetition of it) is searched as flat storage, then the few positions
+ * where a match could straddle its end are checked individually. */
+static MVMint64 index_in_strands(MVMThreadContext *tc, MVMString *H, MVMStringIndexNeedle *n,
+        MVMint64 start) {
+    MVMStringIndex   H_graphs = MVM_string_graphs_nocheck(tc, H);
+    MVMStringStrand *strands  = H->body.storage.strands;
+    MVMGrapheme32    n_first  = index_needle_32(tc, n)[0];
+    MVMint64         pos      = 0;
+    MVMuint16        s;
+    for (s = 0; s < H->body.num_strands; s++) {
+        MVMStringStrand *strand    = &(strands[s]);
+        MVMStringIndex   piece_len = strand->end - strand->start;
+        MVMuint32        rep;
+        for (rep = 0; rep <= strand->repetitions; rep++, pos += piece_len) {
+            MVMint64 found, cand;
+            if (pos + piece_len <= start)
+                continue;
+            found = index_in_flat(tc, strand->blob_string,
+                strand->start + (start > pos ? start - pos : 0), strand->end, n);
+            if (found != -1)
+                return pos + found - strand->start;
+            cand = pos + piece_len - n->graphs + 1;
+            if (cand < pos)   cand = pos;
+            if (cand < start) cand = start;
+            for (; cand < pos + piece_len && cand + n->graphs <= H_graphs; cand++)
+                if (MVM_string_get_grapheme_at_nocheck(tc, strand->blob_string,
+                            strand->start + (cand - pos)) == n_first
+                        && MVM_string_substrings_equal_nocheck(tc, H, cand, n->graphs, n->needle, 0))
+                    return cand;
         }
     }
-    rtrn = MVM_string_memmem_grapheme32(tc, Haystack->body.storage.blob_32, needle_buf ? needle_buf : needle->body.storage.blob_32, H_start, H_graphs, n_graphs);
-    if (needle_buf) MVM_free(needle_buf);
-    return rtrn;
+    return -1;
 }
+
+/* Checks if a strand haystack's pieces (strands, counting each repetition)
+ * are long enough compared to the needle for a strand-by-strand search. */
+static int strand_pieces_searchable(MVMThreadContext *tc, MVMString *H, MVMStringIndex n_graphs) {
+    MVMuint64 pieces = 0;
+    MVMuint16 s;
+    for (s = 0; s < H->body.num_strands; s++)
+        pieces += (MVMuint64)H->body.storage.strands[s].repetitions + 1;
+    return pieces * n_graphs <= MVM_string_graphs_nocheck(tc, H);
+}
+
 /* Returns the location of one string in another or -1  */
 MVMint64 MVM_string_index(MVMThreadContext *tc, MVMString *Haystack, MVMString *needle, MVMint64 start) {
     size_t index           = (size_t)start;
@@ -575,50 +916,19 @@ MVMint64 MVM_string_index(MVMThreadContext *tc, MVMString *Haystack, MVMString *
     if (H_graphs < n_graphs || n_graphs < 1)
         return -1;
 
-    /* Fast paths when storage types are identical. Uses memmem function, which
-     * uses Knuth-Morris-Pratt algorithm on Linux and on others
-     * Crochemore+Perrin two-way string matching */
-    switch (Haystack->body.storage_type) {
-        case MVM_STRING_GRAPHEME_32:
-            if (needle->body.storage_type == MVM_STRING_GRAPHEME_32 || needle->body.num_graphs < 100) {
-                return MVM_string_memmem_grapheme32str(tc, Haystack, needle, start, H_graphs, n_graphs);
-            }
-            break;
-        case MVM_STRING_GRAPHEME_8:
-            if (needle->body.storage_type == MVM_STRING_GRAPHEME_8 || needle->body.num_graphs < 100) {
-                void         *mm_return_8 = NULL;
-                MVMGrapheme8 *needle_buf  = NULL;
-                if (needle->body.storage_type != MVM_STRING_GRAPHEME_8) {
-                    MVMStringIndex i;
-                    MVMGraphemeIter n_gi;
-                    needle_buf = MVM_malloc(needle->body.num_graphs * sizeof(MVMGrapheme8));
-                    if (needle->body.storage_type != MVM_STRING_GRAPHEME_32) MVM_string_gi_init(tc, &n_gi, needle);
-                    for (i = 0; i < needle->body.num_graphs; i++) {
-                        MVMGrapheme32 g = needle->body.storage_type == MVM_STRING_GRAPHEME_32
-                            ? needle->body.storage.blob_32[i]
-                            : MVM_string_gi_get_grapheme(tc, &n_gi);
-                        /* Haystack is 8 bit, needle is 32 bit. if we encounter a non8bit grapheme
-                         * it's impossible to match */
-                        if (!can_fit_into_8bit(g)) {
-                            MVM_free(needle_buf);
-                            return -1;
-                        }
-                        needle_buf[i] = g;
-                    }
-                }
-                mm_return_8 = MVM_memmem(
-                    Haystack->body.storage.blob_8 + start, /* start position */
-                    (H_graphs - start) * sizeof(MVMGrapheme8), /* length of Haystack from start position to end */
-                    needle_buf ? needle_buf : needle->body.storage.blob_8, /* needle start */
-                    n_graphs * sizeof(MVMGrapheme8) /* needle length */
-                );
-                if (needle_buf) MVM_free(needle_buf);
-                if (mm_return_8 == NULL)
-                    return -1;
-                else
-                    return (MVMGrapheme8*)mm_return_8 -  Haystack->body.storage.blob_8;
-            }
-            break;
+    /* Flat haystacks are searched directly in their storage. Strand haystacks
+     * are too, strand by strand, unless the pieces are so short compared to
+     * the needle (as with many repetitions) that checking matches across
+     * their boundaries would dominate. */
+    if (Haystack->body.storage_type != MVM_STRING_STRAND || strand_pieces_searchable(tc, Haystack, n_graphs)) {
+        MVMStringIndexNeedle n;
+        MVMint64 rtrn;
+        index_needle_init(tc, &n, needle);
+        rtrn = Haystack->body.storage_type == MVM_STRING_STRAND
+            ? index_in_strands(tc, Haystack, &n, start)
+            : index_in_flat(tc, Haystack, start, H_graphs, &n);
+        index_needle_destroy(tc, &n);
+        return rtrn;
     }
     /* Minimal code version for needles of size 1 */
     if (n_graphs == 1) {
@@ -631,28 +941,9 @@ MVMint64 MVM_string_index(MVMThreadContext *tc, MVMString *Haystack, MVMString *
                 return (MVMint64)index;
             index++;
         }
+        return -1;
     }
-    else if (n_graphs <= MVM_string_KMP_max_pattern_length)
-        return knuth_morris_pratt_string_index(tc, needle, Haystack, start);
-    else {
-        int is_gic = Haystack->body.storage_type == MVM_STRING_STRAND ? 1 : 0;
-        void *Hs_or_gic = Haystack;
-        /* If Haystack is a strand allocate space for a MVMGraphemeIter_cached
-         * and initialize it */
-        if (is_gic) {
-            Hs_or_gic = alloca(sizeof(MVMGraphemeIter_cached));
-            MVM_string_gi_cached_init(tc, Hs_or_gic, Haystack, start);
-        }
-        /* For needles > MVM_string_KMP_max_pattern_length we must revert to brute force for now.
-         * Eventually we can implement brute force after it matches the whole needle OR
-         * allocate more space for the pattern on reaching the end of the pattern */
-        while (index <= H_graphs - n_graphs) {
-            if (string_equal_at_ignore_case_INTERNAL_loop(tc, Hs_or_gic, needle, index, H_graphs, n_graphs, 0, 0, is_gic) != -1)
-                return (MVMint64)index;
-            index++;
-        }
-    }
-    return -1;
+    return knuth_morris_pratt_string_index(tc, needle, Haystack, start);
 }
 
 /* Returns the location of one string in another or -1  */
@@ -1268,8 +1559,8 @@ static MVMint64 string_equal_at_ignore_case(MVMThreadContext *tc, MVMString *Hay
 /* Processes the pattern. The pattern must be able to store negative and positive
  * numbers. It must be able to store at least 1/2 the length of the needle,
  * though possibly more (though I am not sure it's possible for it to be more than
- * 1/2). */
-static void knuth_morris_pratt_process_pattern (MVMThreadContext *tc, MVMString *pat, MVMint16 *next, MVMStringIndex pat_graphs) {
+ * 1/2). We use 32-bit entries so any needle length works. */
+static void knuth_morris_pratt_process_pattern (MVMThreadContext *tc, MVMString *pat, MVMint32 *next, MVMStringIndex pat_graphs) {
     MVMint64 i = 0;
     MVMint64 j = next[0] = -1;
     while (i < pat_graphs) {
@@ -1291,11 +1582,10 @@ static MVMint64 knuth_morris_pratt_string_index (MVMThreadContext *tc, MVMString
     MVMint64 text_offset   = H_offset;
     MVMStringIndex Haystack_graphs = MVM_string_graphs_nocheck(tc, Haystack);
     MVMStringIndex needle_graphs   = MVM_string_graphs_nocheck(tc, needle);
-    MVMint16         *next = NULL;
+    MVMint32         *next = NULL;
     MVMString *flat_needle = NULL;
-    size_t next_size = (1 + needle_graphs) * sizeof(MVMint16);
+    size_t next_size = (1 + needle_graphs) * sizeof(MVMint32);
     int    next_is_malloced = 0;
-    assert(needle_graphs <= MVM_string_KMP_max_pattern_length);
     /* Empty string is found at start of string */
     if (needle_graphs == 0)
         return 0;
@@ -1819,6 +2109,17 @@ MVMString * MVM_string_decode_from_buf_config(MVMThreadContext *tc, MVMObject *b
     MVMuint8 encoding_flag;
     MVMuint8 elem_size = 0;
 
+    /* A mapped file is decoded straight from the mapping. */
+    if (IS_CONCRETE(buf) && REPR(buf)->ID == MVM_REPR_ID_MappedBuffer) {
+        MVMROOT(tc, buf, {
+            encoding_flag = MVM_string_find_encoding(tc, enc_name);
+        });
+        return MVM_string_decode_config(tc, tc->instance->VMString,
+            (char *)((MVMMappedBuffer *)buf)->body.data,
+            ((MVMMappedBuffer *)buf)->body.length,
+            encoding_flag, replacement, config);
+    }
+
     /* Ensure the source is in the correct form. */
     if (!IS_CONCRETE(buf) || REPR(buf)->ID != MVM_REPR_ID_VMArray)
         MVM_exception_throw_adhoc(tc, "decode requires a native array to read from");
@@ -1915,6 +2216,13 @@ void copy_to_32bit (MVMThreadContext *tc, MVMString *source,
                     source->body.storage.blob_8[sindex++];
             break;
         }
+        case MVM_STRING_GRAPHEME_16: {
+            MVMStringIndex sindex = 0;
+            while (sindex < source->body.num_graphs)
+                dest->body.storage.blob_32[(*position)++] =
+                    source->body.storage.blob_16[sindex++];
+            break;
+        }
         default:
             MVM_string_gi_init(tc, gi, source);
             while (MVM_string_gi_has_more(tc, gi))
@@ -2166,6 +2474,14 @@ MVMint64 MVM_string_char_at_in_string(MVMThreadContext *tc, MVMString *a, MVMint
     case MVM_STRING_GRAPHEME_32:
         return MVM_string_memmem_grapheme32(tc, Haystack->body.storage.blob_32, &search, 0, H_graphs, 1);
 
+    case MVM_STRING_GRAPHEME_16:
+        if (0 <= search && search <= 0xFFFF) {
+            MVMStringIndex i;
+            for (i = 0; i < H_graphs; i++)
+                if (Haystack->body.storage.blob_16[i] == search)
+                    return i;
+        }
+        break;
     case MVM_STRING_GRAPHEME_ASCII:
         if (can_fit_into_ascii(search)) {
             MVMStringIndex i;
@@ -2329,6 +2645,19 @@ MVMString * MVM_string_flip(MVMThreadContext *tc, MVMString *s) {
         res->body.storage.blob_8  = rbuffer;
         break;
     }
+    case MVM_STRING_GRAPHEME_16: {
+        MVMGrapheme16  *rbuffer;
+        size_t spos_l = spos, rpos_l = rpos;
+        rbuffer = MVM_malloc(sizeof(MVMGrapheme16) * sgraphs);
+        MVM_VECTORIZE_LOOP
+        while (spos_l < s->body.num_graphs)
+            rbuffer[--rpos_l] = s->body.storage.blob_16[spos_l++];
+
+        res = (MVMString *)MVM_repr_alloc_init(tc, tc->instance->VMString);
+        res->body.storage_type    = MVM_STRING_GRAPHEME_16;
+        res->body.storage.blob_16 = rbuffer;
+        break;
+    }
     default: {
         MVMGrapheme32  *rbuffer;
         rbuffer = MVM_malloc(sizeof(MVMGrapheme32) * sgraphs);
@@ -2396,6 +2725,16 @@ MVMint64 MVM_string_compare(MVMThreadContext *tc, MVMString *a, MVMString *b) {
             i++;
         }
     }
+    else if (a->body.storage_type == MVM_STRING_GRAPHEME_16 && b->body.storage_type == MVM_STRING_GRAPHEME_16) {
+        MVMGrapheme16  *a_blob16 = a->body.storage.blob_16;
+        MVMGrapheme16  *b_blob16 = b->body.storage.blob_16;
+        while (i < scanlen && a_blob16[i] == b_blob16[i]) {
+            i++;
+        }
+    }
+    else if (a->body.storage_type == MVM_STRING_GRAPHEME_16 || b->body.storage_type == MVM_STRING_GRAPHEME_16) {
+        /* Mixed widths with 16-bit storage; the iterators below handle it. */
+    }
     else {
         MVMGrapheme32 *blob32 = NULL;
         MVMGrapheme8  *blob8  = NULL;
@@ -2869,9 +3208,6 @@ MVMString * MVM_string_chr(MVMThreadContext *tc, MVMint64 cp) {
     return s;
 }
 
-/* Takes a string and computes a hash code for it, storing it in the hash code
- * cache field of the string. Hashing code is derived from the Jenkins hash
- * implementation in uthash.h. */
 typedef union {
     MVMuint32 graphs[2];
     MVMuint64 u64;
@@ -2882,7 +3218,7 @@ typedef union {
  * If this isn't set, MVM_MAYBE_TO_LITTLE_ENDIAN_32 does nothing (the default).
  * This would mainly be useful for debugging or if there were some other reason
  * someone cared that hashes were identical on different endian platforms */
-void MVM_string_compute_hash_code(MVMThreadContext *tc, MVMString *s) {
+static MVMuint64 compute_siphash(MVMThreadContext *tc, MVMString *s) {
 #if defined(MVM_HASH_FORCE_LITTLE_ENDIAN)
     const MVMuint64 key[2] = {
         MVM_MAYBE_TO_LITTLE_ENDIAN_64(tc->instance->hashSecrets[0]),
@@ -2912,6 +3248,21 @@ void MVM_string_compute_hash_code(MVMThreadContext *tc, MVMString *s) {
                     ? MVM_MAYBE_TO_LITTLE_ENDIAN_32(s->body.storage.blob_8[i]) : 0);
             break;
         }
+        case MVM_STRING_GRAPHEME_16: {
+            size_t i;
+            MVMJenHashGraphemeView gv;
+            siphash sh;
+            siphashinit(&sh, s_len * sizeof(MVMGrapheme32), key);
+            for (i = 0; i + 1 < s_len;) {
+                gv.graphs[0] = MVM_MAYBE_TO_LITTLE_ENDIAN_32(s->body.storage.blob_16[i++]);
+                gv.graphs[1] = MVM_MAYBE_TO_LITTLE_ENDIAN_32(s->body.storage.blob_16[i++]);
+                siphashadd64bits(&sh, gv.u64);
+            }
+            hash = siphashfinish_32bits(&sh,
+                i < s_len
+                    ? MVM_MAYBE_TO_LITTLE_ENDIAN_32(s->body.storage.blob_16[i]) : 0);
+            break;
+        }
 #if !defined(MVM_HASH_FORCE_LITTLE_ENDIAN)
         case MVM_STRING_GRAPHEME_32: {
             hash = siphash24(
@@ -2940,5 +3291,104 @@ void MVM_string_compute_hash_code(MVMThreadContext *tc, MVMString *s) {
             break;
         }
     }
-    s->body.cached_hash_code = hash;
+    return hash;
+}
+
+/* Feeds the graphemes of a string to the wyhash-style hash. So that equal
+ * strings hash alike whatever their storage, the hash is defined over a byte
+ * encoding of the graphemes: 0..127 as a single byte, up to 0xFFFF as 0xFE
+ * and two bytes, and anything else (including synthetics) as 0xFF and four
+ * bytes. An 8-bit string with no synthetics is already in this form, so its
+ * storage is hashed in place. */
+#define MVM_WYHASH_ENCODE_CHUNK 64
+#define wyhash_encode_grapheme(chunk, used, g) do { \
+    MVMGrapheme32 _g = (g); \
+    if (0 <= _g && _g < 0x80) { \
+        (chunk)[(used)++] = (MVMuint8)_g; \
+    } \
+    else if (0 < _g && _g <= 0xFFFF) { \
+        (chunk)[(used)++] = 0xFE; \
+        (chunk)[(used)++] = (MVMuint8)_g; \
+        (chunk)[(used)++] = (MVMuint8)(_g >> 8); \
+    } \
+    else { \
+        (chunk)[(used)++] = 0xFF; \
+        (chunk)[(used)++] = (MVMuint8)_g; \
+        (chunk)[(used)++] = (MVMuint8)(_g >> 8); \
+        (chunk)[(used)++] = (MVMuint8)(_g >> 16); \
+        (chunk)[(used)++] = (MVMuint8)((MVMuint32)_g >> 24); \
+    } \
+} while (0)
+#define define_wyhash_blob(name, type) \
+static void name(MVMWyHash *wh, const type *blob, MVMStringIndex n) { \
+    MVMuint8 chunk[MVM_WYHASH_ENCODE_CHUNK + 8]; \
+    MVMuint32 used = 0; \
+    MVMStringIndex i; \
+    for (i = 0; i < n; i++) { \
+        wyhash_encode_grapheme(chunk, used, blob[i]); \
+        if (used >= MVM_WYHASH_ENCODE_CHUNK) { \
+            MVM_wyhash_add(wh, chunk, used); \
+            used = 0; \
+        } \
+    } \
+    MVM_wyhash_add(wh, chunk, used); \
+}
+define_wyhash_blob(wyhash_blob_8, MVMGrapheme8)
+define_wyhash_blob(wyhash_blob_16, MVMGrapheme16)
+define_wyhash_blob(wyhash_blob_32, MVMGrapheme32)
+static MVMuint64 compute_wyhash(MVMThreadContext *tc, MVMString *s) {
+    MVMWyHash wh;
+    MVMStringIndex s_len = MVM_string_graphs_nocheck(tc, s);
+    MVM_wyhash_init(&wh, tc->instance->hashSecrets);
+    switch (s->body.storage_type) {
+        case MVM_STRING_GRAPHEME_ASCII:
+            MVM_wyhash_add(&wh, (MVMuint8 *)s->body.storage.blob_ascii, s_len);
+            break;
+        case MVM_STRING_GRAPHEME_8: {
+            MVMGrapheme8 *blob = s->body.storage.blob_8;
+            MVMuint8 any_synthetic = 0;
+            MVMStringIndex i;
+            MVM_VECTORIZE_LOOP
+            for (i = 0; i < s_len; i++)
+                any_synthetic |= (MVMuint8)blob[i] & 0x80;
+            if (any_synthetic)
+                wyhash_blob_8(&wh, blob, s_len);
+            else
+                MVM_wyhash_add(&wh, (MVMuint8 *)blob, s_len);
+            break;
+        }
+        case MVM_STRING_GRAPHEME_16:
+            wyhash_blob_16(&wh, s->body.storage.blob_16, s_len);
+            break;
+        case MVM_STRING_GRAPHEME_32:
+            wyhash_blob_32(&wh, s->body.storage.blob_32, s_len);
+            break;
+        default: {
+            MVMuint8 chunk[MVM_WYHASH_ENCODE_CHUNK + 8];
+            MVMuint32 used = 0;
+            MVMGraphemeIter gi;
+            MVM_string_gi_init(tc, &gi, s);
+            while (MVM_string_gi_has_more(tc, &gi)) {
+                wyhash_encode_grapheme(chunk, used, MVM_string_gi_get_grapheme(tc, &gi));
+                if (used >= MVM_WYHASH_ENCODE_CHUNK) {
+                    MVM_wyhash_add(&wh, chunk, used);
+                    used = 0;
+                }
+            }
+            MVM_wyhash_add(&wh, chunk, used);
+            break;
+        }
+    }
+    return MVM_wyhash_finish(&wh);
+}
+
+/* Takes a string and computes a hash code for it, storing it in the hash code
+ * cache field of the string. Which hash function is used is picked at startup
+ * (see MVM_STRING_HASH_DEFAULT). A hash code of 0 means none is cached yet,
+ * so it is never produced. */
+void MVM_string_compute_hash_code(MVMThreadContext *tc, MVMString *s) {
+    MVMuint64 hash = tc->instance->string_hash_function == MVM_STRING_HASH_SIPHASH
+        ? compute_siphash(tc, s)
+        : compute_wyhash(tc, s);
+    s->body.cached_hash_code = hash ? hash : 1;
 }
@@ -33,6 +33,16 @@
 #define MVM_CCLASS_NEWLINE      4096
 #define MVM_CCLASS_WORD         8192
 
+/* String hash functions. SipHash is used unless the faster wyhash-style hash
+ * is asked for, either at startup with the MVM_STRING_HASH environment
+ * variable ("siphash" or "wyhash") or when building, by defining
+ * MVM_STRING_HASH_DEFAULT as MVM_STRING_HASH_WYHASH. */
+#define MVM_STRING_HASH_SIPHASH 0
+#define MVM_STRING_HASH_WYHASH  1
+#ifndef MVM_STRING_HASH_DEFAULT
+#define MVM_STRING_HASH_DEFAULT MVM_STRING_HASH_SIPHASH
+#endif
+
 /* Checks a string is not null or non-concrete and throws if so. */
 MVM_STATIC_INLINE void MVM_string_check_arg(MVMThreadContext *tc, const MVMString *s, const char *operation) {
     if (!s || !IS_CONCRETE(s))
@@ -75,6 +85,28 @@ MVM_STATIC_INLINE int MVM_string_buf32_can_fit_into_8bit(MVMGrapheme32 *active_b
     }
     return val ? 0 : 1;
 }
+/* Checks if a 32-bit buffer only holds BMP codepoints. Synthetics are
+ * negative, so they have the high bits set and fail the check as well. */
+MVM_STATIC_INLINE int MVM_string_buf32_can_fit_into_16bit(MVMGrapheme32 *active_blob, MVMStringIndex blob_len) {
+    MVMStringIndex i;
+    MVMGrapheme32 val = 0;
+    MVM_VECTORIZE_LOOP
+    for (i = 0; i  < blob_len; i++) {
+        MVMGrapheme32 val2 = active_blob[i] & 0xffff0000;
+        val |= val2;
+    }
+    return val ? 0 : 1;
+}
+MVM_STATIC_INLINE int MVM_string_buf16_can_fit_into_8bit(MVMGrapheme16 *active_blob, MVMStringIndex blob_len) {
+    MVMStringIndex i;
+    MVMGrapheme16 val = 0;
+    MVM_VECTORIZE_LOOP
+    for (i = 0; i  < blob_len; i++) {
+        MVMGrapheme16 val2 = active_blob[i] & 0xff80;
+        val |= val2;
+    }
+    return val ? 0 : 1;
+}
 MVMGrapheme32 MVM_string_get_grapheme_at_nocheck(MVMThreadContext *tc, MVMString *a, MVMint64 index);
 MVMint64 MVM_string_equal(MVMThreadContext *tc, MVMString *a, MVMString *b);
 MVMint64 MVM_string_substrings_equal_nocheck(MVMThreadContext *tc, MVMString *a,
@@ -135,6 +167,7 @@ MVMString * MVM_string_chr(MVMThreadContext *tc, MVMint64 cp);
 MVMint64 MVM_string_grapheme_is_cclass(MVMThreadContext *tc, MVMint64 cclass, MVMGrapheme32 g);
 void MVM_string_compute_hash_code(MVMThreadContext *tc, MVMString *s);
 MVMString * MVM_string_ascii_from_buf_nocheck(MVMThreadContext *tc, MVMGrapheme8 *buf, MVMStringIndex len);
+MVMString * MVM_string_renormalize(MVMThreadContext *tc, MVMString *s);
 char * MVM_string_encoding_cname(MVMThreadContext *tc, MVMint64 encoding);
 /* If MVM_DEBUG_NFG is 1, calls to NFG_CHECK will re_nfg the given string
  * and compare num_graphs before and after the normalization.
@@ -1,5 +1,6 @@
 #include "moar.h"
 #include <math.h>
+#include "parse_num_pow5.h"
 
 /* We put a ' ' into the current code point buffer when we reach the end of the string,
  *  as it's something that can be harmlessly added to the end of a number */
@@ -47,6 +48,256 @@ int static get_cp(MVMThreadContext *tc, MVMCodepointIter *ci, MVMCodepoint *cp)
     }
 }
 
+/* Multiplies a and b, giving the high and low halves of the 128-bit result. */
+static void full_multiply(MVMuint64 a, MVMuint64 b, MVMuint64 *hi, MVMuint64 *lo) {
+#if defined(__SIZEOF_INT128__)
+    __uint128_t r = (__uint128_t)a * b;
+    *lo = (MVMuint64)r;
+    *hi = (MVMuint64)(r >> 64);
+#else
+    MVMuint64 ha = a >> 32, hb = b >> 32, la = (MVMuint32)a, lb = (MVMuint32)b;
+    MVMuint64 rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    MVMuint64 t  = rl + (rm0 << 32), c = t < rl;
+    *lo = t + (rm1 << 32);
+    c += *lo < t;
+    *hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+
+static int leading_zeroes(MVMuint64 w) {
+#if defined(__GNUC__)
+    return __builtin_clzll(w);
+#else
+    int n = 0;
+    while (!(w & 0x8000000000000000ULL)) {
+        w <<= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+/* Exact powers of ten that a double can hold, for the fast path below. */
+static const double exact_powers_of_ten[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/* Computes the double nearest to w * 10^q, correctly rounded, using the
+ * Eisel-Lemire algorithm: w is normalized and multiplied by a truncated
+ * 128-bit approximation of 5^q, which is always enough to determine the 53
+ * significant bits and the rounding direction when w has no more than 19
+ * digits. */
+static MVMnum64 decimal_to_double(MVMuint64 w, MVMint64 q, int negative) {
+    MVMuint64 hi, lo, mantissa, bits;
+    MVMint64  power2;
+    int       lz, upperbit, shift;
+    double    d;
+
+    /* When both w and 10^q are exact doubles, one multiply or divide rounds
+     * correctly by itself. */
+    if (-22 <= q && q <= 22 && w <= 0x20000000000000ULL) {
+        d = (double)w;
+        d = q < 0 ? d / exact_powers_of_ten[-q] : d * exact_powers_of_ten[q];
+        return negative ? -d : d;
+    }
+
+    if (w == 0 || q < MVM_POW5_SMALLEST_POWER) {
+        mantissa = 0;
+        power2   = 0;
+        goto done;
+    }
+    if (q > MVM_POW5_LARGEST_POWER) {
+        mantissa = 0;
+        power2   = 0x7FF;
+        goto done;
+    }
+
+    lz  = leading_zeroes(w);
+    w <<= lz;
+    full_multiply(w, MVM_pow5_128[2 * (q - MVM_POW5_SMALLEST_POWER)], &hi, &lo);
+    if ((hi & 0x1FF) == 0x1FF) {
+        /* Bits below the ones we keep are all ones, so a carry from the
+         * next 64 bits of 5^q could still change them. */
+        MVMuint64 hi2, lo2;
+        full_multiply(w, MVM_pow5_128[2 * (q - MVM_POW5_SMALLEST_POWER) + 1], &hi2, &lo2);
+        lo += hi2;
+        if (hi2 > lo)
+            hi++;
+    }
+
+    /* Keep 54 bits (the 53 we want plus one for rounding); the binary
+     * exponent comes from log2(10^q) = q * log2(10) ~= q * 217706 / 2^16. */
+    upperbit = (int)(hi >> 63);
+    shift    = upperbit + 9;
+    mantissa = hi >> shift;
+    power2   = (((152170 + 65536) * q) >> 16) + 63 + upperbit - lz + 1023;
+
+    if (power2 <= 0) {
+        /* Subnormal, or too small to be anything but zero. */
+        if (-power2 + 1 >= 64) {
+            mantissa = 0;
+            power2   = 0;
+            goto done;
+        }
+        mantissa >>= -power2 + 1;
+        mantissa  += mantissa & 1;
+        mantissa >>= 1;
+        power2     = mantissa < (1ULL << 52) ? 0 : 1;
+        goto done;
+    }
+
+    /* An exact halfway case can only happen for small q, and must round to
+     * even rather than up. */
+    if (lo <= 1 && q >= -4 && q <= 23 && (mantissa & 3) == 1
+            && (mantissa << shift) == hi)
+        mantissa &= ~1ULL;
+    mantissa  += mantissa & 1;
+    mantissa >>= 1;
+    if (mantissa >= (2ULL << 52)) {
+        mantissa = 1ULL << 52;
+        power2++;
+    }
+    mantissa &= ~(1ULL << 52);
+    if (power2 >= 0x7FF) {
+        mantissa = 0;
+        power2   = 0x7FF;
+    }
+
+  done:
+    bits = mantissa | ((MVMuint64)power2 << 52) | ((MVMuint64)(negative != 0) << 63);
+    memcpy(&d, &bits, sizeof(double));
+    return d;
+}
+
+static int is_ascii_whitespace(char c) {
+    return c == ' ' || (c <= 13 && c >= 9);
+}
+
+/* Parses a plain decimal number - optional whitespace and sign, digits with
+ * an optional fractional part, an optional exponent, optional whitespace -
+ * from a run of ASCII characters. Returns 0 without setting result if there
+ * is anything else in there (underscores, radix prefixes, NaN, Inf, Rats,
+ * non-ASCII characters) or nothing at all, so the caller can fall back to
+ * the full parser. */
+static int parse_ascii_decimal(const char *p, const char *end, MVMnum64 *result) {
+    MVMuint64   w          = 0;
+    MVMint64    q          = 0;
+    MVMint64    exponent   = 0;
+    int         negative   = 0;
+    int         digits     = 0;
+    int         sig_digits = 0;
+    const char *start;
+
+    while (p < end && is_ascii_whitespace(*p))
+        p++;
+    while (end > p && is_ascii_whitespace(end[-1]))
+        end--;
+    if (p == end)
+        return 0;
+    start = p;
+
+    if (*p == '-' || *p == '+')
+        negative = *p++ == '-';
+    while (p < end && *p >= '0' && *p <= '9') {
+        if (sig_digits || *p != '0') {
+            if (sig_digits < 19)
+                w = w * 10 + (*p - '0');
+            else
+                q++;
+            sig_digits++;
+        }
+        digits++;
+        p++;
+    }
+    if (p < end && *p == '.') {
+        int frac_digits = 0;
+        p++;
+        while (p < end && *p >= '0' && *p <= '9') {
+            if (sig_digits || *p != '0') {
+                if (sig_digits < 19) {
+                    w = w * 10 + (*p - '0');
+                    q--;
+                }
+                sig_digits++;
+            }
+            else {
+                q--;
+            }
+            frac_digits++;
+            p++;
+        }
+        if (frac_digits == 0)
+            return 0;
+        digits += frac_digits;
+    }
+    if (digits == 0)
+        return 0;
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        int exp_negative = 0;
+        int exp_digits   = 0;
+        p++;
+        if (p < end && (*p == '-' || *p == '+'))
+            exp_negative = *p++ == '-';
+        while (p < end && *p >= '0' && *p <= '9') {
+            if (exponent < 100000)
+                exponent = exponent * 10 + (*p - '0');
+            exp_digits++;
+            p++;
+        }
+        if (exp_digits == 0)
+            return 0;
+        if (exp_negative)
+            exponent = -exponent;
+    }
+    if (p != end)
+        return 0;
+
+    if (sig_digits > 19) {
+        /* Too many digits to be sure of rounding from the first 19 alone;
+         * these are rare enough to leave to strtod. */
+        size_t  len = end - start;
+        char   *buf = MVM_malloc(len + 1);
+        memcpy(buf, start, len);
+        buf[len] = '\0';
+        *result  = strtod(buf, NULL);
+        MVM_free(buf);
+        return 1;
+    }
+
+    *result = decimal_to_double(w, q + exponent, negative);
+    return 1;
+}
+
+/* Parses an integer - optional whitespace and sign, digits, optional
+ * whitespace - from a run of ASCII characters. Returns 0 if there's anything
+ * else or it doesn't fit in 64 bits. */
+static int parse_ascii_integer(const char *p, const char *end, MVMint64 *result) {
+    MVMuint64 value    = 0;
+    MVMuint64 limit;
+    int       negative = 0;
+    int       digits   = 0;
+
+    while (p < end && is_ascii_whitespace(*p))
+        p++;
+    while (end > p && is_ascii_whitespace(end[-1]))
+        end--;
+    if (p < end && (*p == '-' || *p == '+'))
+        negative = *p++ == '-';
+    limit = negative ? (MVMuint64)1 << 63 : ((MVMuint64)1 << 63) - 1;
+    while (p < end && *p >= '0' && *p <= '9') {
+        MVMuint64 digit = *p++ - '0';
+        if (value > (limit - digit) / 10)
+            return 0;
+        value = value * 10 + digit;
+        digits++;
+    }
+    if (digits == 0 || p != end)
+        return 0;
+    *result = negative ? (MVMint64)(0 - value) : (MVMint64)value;
+    return 1;
+}
+
 MVM_NO_RETURN static void parse_error(MVMThreadContext *tc, MVMString *s, const char* reason) MVM_NO_RETURN_ATTRIBUTE;
 MVM_NO_RETURN static void parse_error(MVMThreadContext *tc, MVMString *s, const char* reason) {
     char* got = MVM_string_utf8_c8_encode_C_string(tc, s);
@@ -172,7 +423,8 @@ static double parse_int_frac_exp(MVMThreadContext *tc, MVMCodepointIter *ci, MVM
     }
 
     *digits_buf_tail = '\0';
-    result = strtod(digits_buf, NULL);
+    if (radix != 10 || !parse_ascii_decimal(digits_buf, digits_buf_tail, &result))
+        result = strtod(digits_buf, NULL);
     MVM_free(digits_buf);
     return result;
 }
@@ -291,6 +543,16 @@ MVMnum64 MVM_coerce_s_n(MVMThreadContext *tc, MVMString *s) {
     MVMCodepointIter ci;
     MVMCodepoint cp;
     MVMnum64  n = 123;
+
+    /* Most numbers we're asked to parse are plain decimals in flat 8-bit
+     * strings, which can be handled without iterating codepoints. */
+    if (s->body.storage_type == MVM_STRING_GRAPHEME_ASCII
+            || s->body.storage_type == MVM_STRING_GRAPHEME_8) {
+        const char *p = (const char *)s->body.storage.blob_8;
+        if (parse_ascii_decimal(p, p + s->body.num_graphs, &n))
+            return n;
+    }
+
     MVM_string_ci_init(tc, &ci, s, 0, 0);
 
     if (get_cp(tc, &ci, &cp)) return 0;
@@ -312,3 +574,122 @@ MVMnum64 MVM_coerce_s_n(MVMThreadContext *tc, MVMString *s) {
 
     return n;
 }
+
+/* Parses one field of a buffer, falling back to decoding it as UTF-8 and
+ * using the string coercions when it isn't a plain decimal. */
+static void parse_buffer_field(MVMThreadContext *tc, const char *p, const char *end,
+        MVMint64 want_num, MVMRegister *value) {
+    if (want_num ? parse_ascii_decimal(p, end, &(value->n64)) : parse_ascii_integer(p, end, &(value->i64)))
+        return;
+    {
+        MVMString *s = MVM_string_utf8_decode(tc, tc->instance->VMString, p, end - p);
+        if (want_num)
+            value->n64 = MVM_coerce_s_n(tc, s);
+        else
+            value->i64 = MVM_coerce_s_i(tc, s);
+    }
+}
+
+/* Parses one string field. */
+static void parse_string_field(MVMThreadContext *tc, MVMString *s, MVMint64 want_num, MVMRegister *value) {
+    MVM_string_check_arg(tc, s, "parsenums");
+    if (want_num) {
+        value->n64 = MVM_coerce_s_n(tc, s);
+        return;
+    }
+    if (s->body.storage_type == MVM_STRING_GRAPHEME_ASCII
+            || s->body.storage_type == MVM_STRING_GRAPHEME_8) {
+        const char *p = (const char *)s->body.storage.blob_8;
+        if (parse_ascii_integer(p, p + s->body.num_graphs, &(value->i64)))
+            return;
+    }
+    value->i64 = MVM_coerce_s_i(tc, s);
+}
+
+/* Parses numeric fields from source and appends them to dest, which must be
+ * a native num64 or int64 array, returning how many were added. The source
+ * is either a list of strings, one field each, or a buffer of 8-bit integers
+ * whose fields are separated by the character sep; nothing is added for an
+ * empty field after the final separator, so a trailing newline is harmless.
+ * Fields that aren't plain decimals go through the usual string coercions
+ * and follow their rules (num fields that don't parse throw, int fields are
+ * parsed as strtoll would). If that throws, the fields before the bad one
+ * will already have been added. */
+MVMint64 MVM_coerce_parse_nums(MVMThreadContext *tc, MVMObject *dest, MVMObject *source, MVMint64 sep) {
+    MVMArrayREPRData *dest_rd, *source_rd;
+    MVMint64 want_num, count, added = 0;
+
+    if (!IS_CONCRETE(dest) || REPR(dest)->ID != MVM_REPR_ID_VMArray)
+        MVM_exception_throw_adhoc(tc, "parsenums requires a native array to write into");
+    dest_rd = (MVMArrayREPRData *)STABLE(dest)->REPR_data;
+    if (!dest_rd || (dest_rd->slot_type != MVM_ARRAY_N64 && dest_rd->slot_type != MVM_ARRAY_I64))
+        MVM_exception_throw_adhoc(tc, "parsenums requires a native num64 or int64 array to write into");
+    want_num = dest_rd->slot_type == MVM_ARRAY_N64;
+
+    if (!IS_CONCRETE(source) || REPR(source)->ID != MVM_REPR_ID_VMArray)
+        MVM_exception_throw_adhoc(tc, "parsenums requires a list of strings or a buffer to parse");
+    source_rd = (MVMArrayREPRData *)STABLE(source)->REPR_data;
+    if (!source_rd || (source_rd->slot_type != MVM_ARRAY_STR
+            && source_rd->slot_type != MVM_ARRAY_U8 && source_rd->slot_type != MVM_ARRAY_I8))
+        MVM_exception_throw_adhoc(tc, "parsenums requires a list of strings or a buffer of 8-bit integers to parse");
+    if (source_rd->slot_type != MVM_ARRAY_STR && (sep < 0 || sep > 255))
+        MVM_exception_throw_adhoc(tc, "parsenums separator must be a single byte, got %"PRId64, sep);
+
+    /* Count the fields, so that room for them all can be made up front. */
+    if (source_rd->slot_type == MVM_ARRAY_STR) {
+        count = ((MVMArray *)source)->body.elems;
+    }
+    else {
+        MVMArrayBody *body = &((MVMArray *)source)->body;
+        const char   *p    = (const char *)body->slots.u8 + body->start;
+        const char   *end  = p + body->elems;
+        count = 0;
+        while (p < end) {
+            const char *next = memchr(p, (int)sep, end - p);
+            count++;
+            if (!next)
+                break;
+            p = next + 1;
+        }
+    }
+    if (count == 0)
+        return 0;
+    {
+        MVMint64 elems = ((MVMArray *)dest)->body.elems;
+        MVM_repr_pos_set_elems(tc, dest, elems + count);
+        MVM_repr_pos_set_elems(tc, dest, elems);
+    }
+
+    MVMROOT2(tc, dest, source, {
+        MVMint64 pos = 0;
+        while (added < count) {
+            MVMRegister   value;
+            MVMArrayBody *dest_body;
+            if (source_rd->slot_type == MVM_ARRAY_STR) {
+                parse_string_field(tc, ((MVMArray *)source)->body.slots.s[((MVMArray *)source)->body.start + added],
+                    want_num, &value);
+            }
+            else {
+                /* The slots are not moved by GC, so these stay valid even
+                 * if a fallback allocates. */
+                MVMArrayBody *body = &((MVMArray *)source)->body;
+                const char   *p    = (const char *)body->slots.u8 + body->start + pos;
+                const char   *end  = (const char *)body->slots.u8 + body->start + body->elems;
+                const char   *next = memchr(p, (int)sep, end - p);
+                if (next)
+                    end = next;
+                pos += end - p + 1;
+                parse_buffer_field(tc, p, end, want_num, &value);
+            }
+            dest_body = &((MVMArray *)dest)->body;
+            if (want_num)
+                dest_body->slots.n64[dest_body->start + dest_body->elems] = value.n64;
+            else
+                dest_body->slots.i64[dest_body->start + dest_body->elems] = value.i64;
+            dest_body->elems++;
+            added++;
+        }
+    });
+
+    return added;
+}
@@ -1 +1,2 @@
 MVMnum64 MVM_coerce_s_n(MVMThreadContext *tc, MVMString *s);
+MVMint64 MVM_coerce_parse_nums(MVMThreadContext *tc, MVMObject *dest, MVMObject *source, MVMint64 sep);
@@ -501,8 +501,8 @@ static MVMint64 collation_return_by_quaternary(MVMThreadContext *tc, level_eval
                                      level_eval_settings->s.quaternary.s2.Same ;
     }
 }
-/* MVM_unicode_string_compare implements the Unicode Collation Algorthm */
-MVMint64 MVM_unicode_string_compare(MVMThreadContext *tc, MVMString *a, MVMString *b,
+/* string_compare implements the Unicode Collation Algorthm */
+static MVMint64 string_compare(MVMThreadContext *tc, MVMString *a, MVMString *b,
          MVMint64 collation_mode, MVMint64 lang_mode, MVMint64 country_mode) {
     MVMStringIndex alen, blen;
     /* Iteration variables */
@@ -676,6 +676,220 @@ MVMint64 MVM_unicode_string_compare(MVMThreadContext *tc, MVMString *a, MVMStrin
     return collation_return_by_quaternary(tc, &level_eval_settings, alen, blen, compare_by_cp_rtrn);
 }
 
+/* A sort key under construction. */
+struct collation_key_buf {
+    MVMuint8 *bytes;
+    MVMuint64 used;
+    MVMuint64 size;
+};
+static void key_buf_append(struct collation_key_buf *buf, MVMuint32 unit, int unit_bytes) {
+    if (buf->size < buf->used + unit_bytes) {
+        buf->size  = buf->size * 2 + unit_bytes;
+        buf->bytes = MVM_realloc(buf->bytes, buf->size);
+    }
+    while (unit_bytes--)
+        buf->bytes[buf->used++] = (MVMuint8)(unit >> (8 * unit_bytes));
+}
+/* Computes the direction a collation level sorts in under the given
+ * collation_mode: 1 for forwards, -1 for reversed, 0 if it's ignored. */
+static int collation_level_direction(MVMint64 collation_mode, MVMint64 positive, MVMint64 negative) {
+    return (collation_mode & positive ? 1 : 0) - (collation_mode & negative ? 1 : 0);
+}
+/* Produces a sort key for a string, such that comparing the keys of two
+ * strings bytewise (as memcmp does) orders them the same way unicmp_s does
+ * with the same collation_mode.
+ *
+ * The key holds, for each of the primary, secondary and tertiary levels
+ * that are enabled, the non-ignorable weights as 16-bit big-endian units
+ * followed by a 0 unit; then, if the quaternary level is enabled, the
+ * codepoints (plus one) as 24-bit units followed by a 0 unit. A reversed
+ * level has its weights complemented so that it compares backwards. The
+ * terminator of a weight level is left as 0 even then, since unicmp_s
+ * sorts a string before any other that it is a prefix of at those levels
+ * whatever their direction; the length tie-break of the quaternary level
+ * is reversed along with it, so its terminator is complemented.
+ *
+ * unicmp_s orders the empty string against any other by the quaternary
+ * level alone, so the key starts with a byte that is 1 for a non-empty
+ * string, while the empty string's key is just a 0 byte (or a 2 if the
+ * quaternary level is reversed). With the quaternary level ignored,
+ * unicmp_s finds the empty string equal to every other; no sort key can
+ * do that, so it sorts first. */
+#define COLLATION_KEY_EMPTY     0
+#define COLLATION_KEY_NON_EMPTY 1
+#define COLLATION_KEY_EMPTY_REV 2
+static void build_collation_key(MVMThreadContext *tc, MVMString *s, MVMint64 collation_mode,
+        struct collation_key_buf *key_out) {
+    static const MVMint64 level_modes[3][2] = {
+        { MVM_COLLATION_PRIMARY_POSITIVE,   MVM_COLLATION_PRIMARY_NEGATIVE },
+        { MVM_COLLATION_SECONDARY_POSITIVE, MVM_COLLATION_SECONDARY_NEGATIVE },
+        { MVM_COLLATION_TERTIARY_POSITIVE,  MVM_COLLATION_TERTIARY_NEGATIVE }
+    };
+    struct collation_key_buf key = { NULL, 0, 0 };
+    collation_stack stack;
+    MVMCodepointIter ci;
+    MVMint64 i;
+    int level, direction;
+
+    if (MVM_string_graphs_nocheck(tc, s) == 0) {
+        direction = collation_level_direction(collation_mode,
+            MVM_COLLATION_QUATERNARY_POSITIVE, MVM_COLLATION_QUATERNARY_NEGATIVE);
+        key_buf_append(&key, direction < 0 ? COLLATION_KEY_EMPTY_REV : COLLATION_KEY_EMPTY, 1);
+        *key_out = key;
+        return;
+    }
+
+    /* Gather all of the collation elements of the string. */
+    init_stack(tc, &stack);
+    MVM_string_ci_init(tc, &ci, s, 0, 0);
+    while (grab_from_stack(tc, &ci, &stack, "key"))
+        ;
+    DEBUG_PRINT_STACK(tc, &stack, "key", "After grabbing all of the string");
+
+    /* Emit the weights level by level. Values on the stack are one higher
+     * than in DUCET, so collation_zero is ignorable and anything else gives
+     * a non-zero DUCET weight that fits in 16 bits. */
+    key.size  = 1 + (stack.stack_top + 2) * 2 * 3;
+    key.bytes = MVM_malloc(key.size);
+    key_buf_append(&key, COLLATION_KEY_NON_EMPTY, 1);
+    for (level = 0; level < 3; level++) {
+        MVMuint32 flip;
+        direction = collation_level_direction(collation_mode,
+            level_modes[level][0], level_modes[level][1]);
+        if (!direction)
+            continue;
+        flip = direction < 0 ? 0xFFFF : 0;
+        for (i = 0; i <= stack.stack_top; i++) {
+            MVMuint32 weight = stack.keys[i].a[level];
+            if (weight > collation_zero)
+                key_buf_append(&key, (weight - 1) ^ flip, 2);
+        }
+        key_buf_append(&key, 0, 2);
+    }
+    cleanup_stack(tc, &stack);
+
+    /* Ties are broken by codepoint, with a shorter string sorting first. */
+    direction = collation_level_direction(collation_mode,
+        MVM_COLLATION_QUATERNARY_POSITIVE, MVM_COLLATION_QUATERNARY_NEGATIVE);
+    if (direction) {
+        MVMuint32 flip = direction < 0 ? 0xFFFFFF : 0;
+        MVM_string_ci_init(tc, &ci, s, 0, 0);
+        while (MVM_string_ci_has_more(tc, &ci))
+            key_buf_append(&key, (MVM_string_ci_get_codepoint(tc, &ci) + 1) ^ flip, 3);
+        key_buf_append(&key, flip, 3);
+    }
+
+    *key_out = key;
+}
+
+/* Compares two keys made by build_collation_key with the given
+ * collation_mode, giving -1, 0 or 1. This is done bytewise, except that the
+ * empty string is equal to any other if the quaternary level is ignored, as
+ * in unicmp_s. */
+static MVMint64 compare_collation_keys(struct collation_key_buf *a, struct collation_key_buf *b,
+        MVMint64 collation_mode) {
+    MVMuint64 common = a->used < b->used ? a->used : b->used;
+    int       cmp;
+    if (!collation_level_direction(collation_mode,
+                MVM_COLLATION_QUATERNARY_POSITIVE, MVM_COLLATION_QUATERNARY_NEGATIVE)
+            && (a->bytes[0] == COLLATION_KEY_EMPTY || b->bytes[0] == COLLATION_KEY_EMPTY))
+        return 0;
+    cmp = memcmp(a->bytes, b->bytes, common);
+    if (cmp)
+        return cmp < 0 ? -1 : 1;
+    return a->used < b->used ? -1 : a->used > b->used ? 1 : 0;
+}
+
+#ifdef COLLATION_KEY_CHECK
+/* Panics if the collation keys of two strings order them differently to
+ * unicmp_s. */
+static void check_collation_keys(MVMThreadContext *tc, MVMString *a, MVMString *b,
+        MVMint64 collation_mode, MVMint64 result) {
+    struct collation_key_buf key_a, key_b;
+    MVMint64 key_result;
+    build_collation_key(tc, a, collation_mode, &key_a);
+    build_collation_key(tc, b, collation_mode, &key_b);
+    key_result = compare_collation_keys(&key_a, &key_b, collation_mode);
+    MVM_free(key_a.bytes);
+    MVM_free(key_b.bytes);
+    if (key_result != result)
+        MVM_panic(1, "unicmp_s gave %"PRId64" but the collation keys give %"PRId64
+            " with collation_mode %"PRId64, result, key_result, collation_mode);
+}
+
+/* Checks the keys of the empty string against those of "a", both ways
+ * round, with the quaternary level forwards, reversed and ignored. */
+static void check_empty_collation_keys(MVMThreadContext *tc) {
+    static const MVMint64 modes[3] = {
+        MVM_COLLATION_PRIMARY_POSITIVE | MVM_COLLATION_SECONDARY_POSITIVE
+            | MVM_COLLATION_TERTIARY_POSITIVE | MVM_COLLATION_QUATERNARY_POSITIVE,
+        MVM_COLLATION_PRIMARY_POSITIVE | MVM_COLLATION_SECONDARY_POSITIVE
+            | MVM_COLLATION_TERTIARY_POSITIVE | MVM_COLLATION_QUATERNARY_NEGATIVE,
+        MVM_COLLATION_PRIMARY_POSITIVE | MVM_COLLATION_SECONDARY_POSITIVE
+            | MVM_COLLATION_TERTIARY_POSITIVE
+    };
+    MVMString *empty = tc->instance->str_consts.empty;
+    MVMString *a     = MVM_string_ascii_decode_nt(tc, tc->instance->VMString, "a");
+    int i;
+    for (i = 0; i < 3; i++) {
+        check_collation_keys(tc, empty, a, modes[i],
+            string_compare(tc, empty, a, modes[i], 0, 0));
+        check_collation_keys(tc, a, empty, modes[i],
+            string_compare(tc, a, empty, modes[i], 0, 0));
+    }
+}
+#endif
+
+/* MVM_unicode_string_compare implements the Unicode Collation Algorthm. If
+ * built with COLLATION_KEY_CHECK, it also checks that the sort keys of the
+ * two strings order them the same way, and panics if they don't. */
+MVMint64 MVM_unicode_string_compare(MVMThreadContext *tc, MVMString *a, MVMString *b,
+         MVMint64 collation_mode, MVMint64 lang_mode, MVMint64 country_mode) {
+    MVMint64 result;
+#ifdef COLLATION_KEY_CHECK
+    static int checked_empty = 0;
+    if (!checked_empty) {
+        checked_empty = 1;
+        MVMROOT2(tc, a, b, {
+            check_empty_collation_keys(tc);
+        });
+    }
+#endif
+    result = string_compare(tc, a, b, collation_mode, lang_mode, country_mode);
+#ifdef COLLATION_KEY_CHECK
+    check_collation_keys(tc, a, b, collation_mode, result);
+#endif
+    return result;
+}
+
+/* Produces a sort key for a string, which compares bytewise the way the
+ * string does under unicmp_s with the same collation_mode; see
+ * build_collation_key. This lets a caller compute the collation elements of each
+ * string once, rather than on every comparison. The key is written into
+ * buf, which must be an empty 8-bit native int array. */
+MVMObject * MVM_unicode_string_collation_key(MVMThreadContext *tc, MVMString *s,
+         MVMint64 collation_mode, MVMint64 lang_mode, MVMint64 country_mode, MVMObject *buf) {
+    struct collation_key_buf key;
+    MVMArrayREPRData *buf_rd;
+
+    MVM_string_check_arg(tc, s, "unicollkey");
+    if (!IS_CONCRETE(buf) || REPR(buf)->ID != MVM_REPR_ID_VMArray)
+        MVM_exception_throw_adhoc(tc, "unicollkey requires a native array to write into");
+    buf_rd = (MVMArrayREPRData *)STABLE(buf)->REPR_data;
+    if (!buf_rd || (buf_rd->slot_type != MVM_ARRAY_U8 && buf_rd->slot_type != MVM_ARRAY_I8))
+        MVM_exception_throw_adhoc(tc, "unicollkey requires an 8-bit native int array");
+    if (((MVMArray *)buf)->body.slots.any)
+        MVM_exception_throw_adhoc(tc, "unicollkey requires an empty array");
+    build_collation_key(tc, s, collation_mode, &key);
+
+    /* Stash the key in the VMArray. */
+    ((MVMArray *)buf)->body.slots.u8 = key.bytes;
+    ((MVMArray *)buf)->body.start    = 0;
+    ((MVMArray *)buf)->body.ssize    = key.size;
+    ((MVMArray *)buf)->body.elems    = key.used;
+    return buf;
+}
+
 /* Looks up a codepoint by name. Lazily constructs a hash. */
 MVMGrapheme32 MVM_unicode_lookup_by_name(MVMThreadContext *tc, MVMString *name) {
     MVMuint64 size;
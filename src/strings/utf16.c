@@ -291,8 +291,23 @@ static MVMString * MVM_string_utf16_decode_main(MVMThreadContext *tc,
         result->body.storage.blob_32[str_pos++] = MVM_unicode_normalizer_get_grapheme(tc, &norm);
     MVM_unicode_normalizer_cleanup(tc, &norm);
 
-    result->body.storage_type = MVM_STRING_GRAPHEME_32;
-    result->body.num_graphs   = str_pos;
+    /* Most UTF-16 text stays within the BMP, so try to store it in 16 bits. */
+    if (MVM_string_buf32_can_fit_into_16bit(result->body.storage.blob_32, str_pos)) {
+        MVMGrapheme32 *old_buffer = result->body.storage.blob_32;
+        MVMGrapheme16 *new_buffer = MVM_malloc(sizeof(MVMGrapheme16) * str_pos);
+        size_t i;
+        MVM_VECTORIZE_LOOP
+        for (i = 0; i < str_pos; i++) {
+            new_buffer[i] = old_buffer[i];
+        }
+        MVM_free(old_buffer);
+        result->body.storage.blob_16 = new_buffer;
+        result->body.storage_type    = MVM_STRING_GRAPHEME_16;
+    }
+    else {
+        result->body.storage_type = MVM_STRING_GRAPHEME_32;
+    }
+    result->body.num_graphs = str_pos;
 
     return result;
 }
@@ -168,6 +168,26 @@ static MVMint32 utf8_encode(MVMuint8 *bp, MVMCodepoint cp) {
 
 #define UTF8_MAXINC (32 * 1024 * 1024)
 
+/* Finds how many bytes at the start of the buffer are ASCII other than \r
+ * (which may be part of a \r\n grapheme). These are graphemes as they are,
+ * so need neither the UTF-8 DFA nor the normalizer, provided the last of them
+ * isn't followed by something it could combine with. Checks a machine word
+ * at a time where it can. */
+static size_t ascii_run_length(const MVMuint8 *bytes, size_t length) {
+    size_t i = 0;
+    while (i + 8 <= length) {
+        MVMuint64 word, cr;
+        memcpy(&word, bytes + i, 8);
+        cr = word ^ 0x0D0D0D0D0D0D0D0DULL;
+        if ((word | ((cr - 0x0101010101010101ULL) & ~cr)) & 0x8080808080808080ULL)
+            break;
+        i += 8;
+    }
+    while (i < length && bytes[i] < 0x80 && bytes[i] != '\r')
+        i++;
+    return i;
+}
+
 /* Decodes the specified number of bytes of utf8 into an NFG string, creating
  * a result of the specified type. The type must have the MVMString REPR. */
 MVMString * MVM_string_utf8_decode(MVMThreadContext *tc, const MVMObject *result_type, const char *utf8, size_t bytes) {
@@ -176,20 +196,49 @@ MVMString * MVM_string_utf8_decode(MVMThreadContext *tc, const MVMObject *result
     MVMCodepoint codepoint;
     MVMint32 line_ending = 0;
     MVMint32 state = 0;
-    MVMint32 bufsize = bytes;
-    MVMGrapheme32 *buffer = MVM_malloc(sizeof(MVMGrapheme32) * bufsize);
+    MVMint32 bufsize;
+    MVMGrapheme32 *buffer;
     size_t orig_bytes;
     const char *orig_utf8;
     MVMint32 line;
     MVMint32 col;
     MVMint32 ready;
+    size_t ascii_run;
 
     /* Need to normalize to NFG as we decode. */
     MVMNormalizer norm;
+
+    /* Most input is plain ASCII. If all of it is, then it can be copied into
+     * 8-bit storage as it is. */
+    ascii_run = ascii_run_length((const MVMuint8 *)utf8, bytes);
+    if (ascii_run == bytes) {
+        MVMGrapheme8 *blob = MVM_malloc(bytes ? bytes : 1);
+        memcpy(blob, utf8, bytes);
+        result->body.storage.blob_8 = blob;
+        result->body.storage_type   = MVM_STRING_GRAPHEME_8;
+        result->body.num_graphs     = bytes;
+        return result;
+    }
+
+    /* Otherwise, take the ASCII we did find as it is, apart from the final
+     * char, which may combine with what comes after it. */
+    bufsize = bytes;
+    buffer = MVM_malloc(sizeof(MVMGrapheme32) * bufsize);
+    if (ascii_run > 1) {
+        const MVMuint8 *ascii = (const MVMuint8 *)utf8;
+        MVMint32 i;
+        count = (MVMint32)ascii_run - 1;
+        MVM_VECTORIZE_LOOP
+        for (i = 0; i < count; i++)
+            buffer[i] = ascii[i];
+    }
+
     MVM_unicode_normalizer_init(tc, &norm, MVM_NORMALIZE_NFG);
 
     orig_bytes = bytes;
     orig_utf8 = utf8;
+    utf8  += count;
+    bytes -= count;
 
     for (; bytes; ++utf8, --bytes) {
         switch(MVM_EXPECT(decode_utf8_byte(&state, &codepoint, (MVMuint8)*utf8), UTF8_ACCEPT)) {
@@ -274,6 +323,17 @@ MVMString * MVM_string_utf8_decode(MVMThreadContext *tc, const MVMObject *result
         MVM_free(buffer);
         result->body.storage.blob_8  = new_buffer;
         result->body.storage_type    = MVM_STRING_GRAPHEME_8;
+    }
+    /* Failing that, text that stays within the BMP takes 16 bits. */
+    else if (MVM_string_buf32_can_fit_into_16bit(buffer, count)) {
+        MVMGrapheme16 *new_buffer = MVM_malloc(sizeof(MVMGrapheme16) * count);
+        MVM_VECTORIZE_LOOP
+        for (ready = 0; ready < count; ready++) {
+            new_buffer[ready] = buffer[ready];
+        }
+        MVM_free(buffer);
+        result->body.storage.blob_16 = new_buffer;
+        result->body.storage_type    = MVM_STRING_GRAPHEME_16;
     } else {
         /* just keep the same buffer as the MVMString's buffer.  Later
          * we can add heuristics to resize it if we have enough free
@@ -391,6 +451,33 @@ MVMuint32 MVM_string_utf8_decodestream(MVMThreadContext *tc, MVMDecodeStream *ds
             }
 
             while (pos < cur_bytes->length) {
+                /* Take any run of plain ASCII without going through the
+                 * DFA; each char just replaces the lagging codepoint. */
+                if (state == UTF8_ACCEPT) {
+                    MVMint32 run_end = pos + (MVMint32)ascii_run_length(
+                        (MVMuint8 *)bytes + pos, cur_bytes->length - pos);
+                    while (pos < run_end) {
+                        if (count == bufsize) {
+                            MVM_string_decodestream_add_chars(tc, ds, buffer, bufsize);
+                            buffer = MVM_malloc(bufsize * sizeof(MVMGrapheme32));
+                            count = 0;
+                        }
+                        buffer[count++] = lag_codepoint;
+                        total++;
+                        if (MVM_string_decode_stream_maybe_sep(tc, seps, lag_codepoint) ||
+                                (stopper_chars && *stopper_chars == total)) {
+                            reached_stopper = 1;
+                            last_accept_bytes = lag_last_accept_bytes;
+                            last_accept_pos = lag_last_accept_pos;
+                            goto done;
+                        }
+                        lag_codepoint = (MVMuint8)bytes[pos++];
+                        lag_last_accept_bytes = cur_bytes;
+                        lag_last_accept_pos = pos;
+                    }
+                    if (pos == cur_bytes->length)
+                        break;
+                }
                 switch(MVM_EXPECT(decode_utf8_byte(&state, &codepoint, bytes[pos++]), UTF8_ACCEPT)) {
                 case UTF8_ACCEPT: {
                     /* If we hit something that needs the normalizer, we put
@@ -510,16 +597,127 @@ MVMuint32 MVM_string_utf8_decodestream(MVMThreadContext *tc, MVMDecodeStream *ds
     return reached_stopper;
 }
 
+/* Where we are encoding to. There are always 4 bytes of space beyond the
+ * limit. */
+typedef struct {
+    MVMuint8 *result;
+    size_t    result_pos;
+    size_t    result_limit;
+    MVMuint8 *repl_bytes;
+    MVMuint64 repl_length;
+} UTF8EncodeTarget;
+
+static void grow_target(MVMThreadContext *tc, UTF8EncodeTarget *t, size_t needed) {
+    size_t new_limit = t->result_limit;
+    while (t->result_pos + needed > new_limit)
+        new_limit = new_limit * 2 + 8;
+    t->result       = MVM_realloc(t->result, new_limit + 4);
+    t->result_limit = new_limit;
+}
+MVM_STATIC_INLINE void ensure_target_space(MVMThreadContext *tc, UTF8EncodeTarget *t, size_t needed) {
+    if (t->result_pos + needed > t->result_limit)
+        grow_target(tc, t, needed);
+}
+
+/* Handles a codepoint that cannot be encoded, either by using the replacement
+ * or by throwing. */
+static void encode_unencodable(MVMThreadContext *tc, UTF8EncodeTarget *t, MVMCodepoint cp) {
+    if (t->repl_bytes) {
+        ensure_target_space(tc, t, t->repl_length);
+        memcpy(t->result + t->result_pos, t->repl_bytes, t->repl_length);
+        t->result_pos += t->repl_length;
+    }
+    else {
+        MVM_free(t->result);
+        MVM_string_utf8_throw_encoding_exception(tc, cp);
+    }
+}
+
+/* Encodes a codepoint that may need more than one byte. */
+static void encode_cp(MVMThreadContext *tc, UTF8EncodeTarget *t, MVMCodepoint cp) {
+    MVMint32 bytes;
+    ensure_target_space(tc, t, 4);
+    bytes = utf8_encode(t->result + t->result_pos, cp);
+    if (bytes)
+        t->result_pos += bytes;
+    else
+        encode_unencodable(tc, t, cp);
+}
+
+/* Encodes a synthetic by encoding each of its codepoints. */
+static void encode_synthetic(MVMThreadContext *tc, UTF8EncodeTarget *t, MVMGrapheme32 g) {
+    MVMNFGSynthetic *synth = MVM_nfg_get_synthetic_info(tc, g);
+    MVMint32 i;
+    for (i = 0; i < synth->num_codes; i++)
+        encode_cp(tc, t, synth->codes[i]);
+}
+
+/* Encodes a range of graphemes from a string with flat storage. With 8-bit
+ * storage, everything is ASCII unless it's a synthetic, so unless there are
+ * any of those we can just copy. 16-bit storage never holds synthetics. */
+static void encode_flat_range(MVMThreadContext *tc, UTF8EncodeTarget *t, MVMString *blob,
+        MVMStringIndex from, MVMStringIndex to) {
+    MVMStringIndex i;
+    if (blob->body.storage_type == MVM_STRING_GRAPHEME_32) {
+        MVMGrapheme32 *graphs = blob->body.storage.blob_32;
+        for (i = from; i < to; i++) {
+            MVMGrapheme32 g = graphs[i];
+            if (g >= 0 && g < 0x80) {
+                ensure_target_space(tc, t, 1);
+                t->result[t->result_pos++] = (MVMuint8)g;
+            }
+            else if (g >= 0) {
+                encode_cp(tc, t, g);
+            }
+            else {
+                encode_synthetic(tc, t, g);
+            }
+        }
+    }
+    else if (blob->body.storage_type == MVM_STRING_GRAPHEME_16) {
+        MVMGrapheme16 *graphs = blob->body.storage.blob_16;
+        for (i = from; i < to; i++) {
+            if (graphs[i] < 0x80) {
+                ensure_target_space(tc, t, 1);
+                t->result[t->result_pos++] = (MVMuint8)graphs[i];
+            }
+            else {
+                encode_cp(tc, t, graphs[i]);
+            }
+        }
+    }
+    else {
+        MVMGrapheme8 *graphs = blob->body.storage.blob_8;
+        MVMGrapheme8  any_synthetic = 0;
+        MVM_VECTORIZE_LOOP
+        for (i = from; i < to; i++)
+            any_synthetic |= graphs[i];
+        if (any_synthetic >= 0) {
+            ensure_target_space(tc, t, to - from);
+            memcpy(t->result + t->result_pos, graphs + from, to - from);
+            t->result_pos += to - from;
+        }
+        else {
+            for (i = from; i < to; i++) {
+                if (graphs[i] >= 0) {
+                    ensure_target_space(tc, t, 1);
+                    t->result[t->result_pos++] = (MVMuint8)graphs[i];
+                }
+                else {
+                    encode_synthetic(tc, t, graphs[i]);
+                }
+            }
+        }
+    }
+}
+
 /* Encodes the specified string to UTF-8. */
 char * MVM_string_utf8_encode_substr(MVMThreadContext *tc,
         MVMString *str, MVMuint64 *output_size, MVMint64 start, MVMint64 length,
         MVMString *replacement, MVMint32 translate_newlines) {
-    MVMuint8        *result = NULL;
-    size_t           result_pos, result_limit;
+    UTF8EncodeTarget t;
     MVMCodepointIter ci;
     MVMStringIndex   strgraphs  = MVM_string_graphs(tc, str);
-    MVMuint8        *repl_bytes = NULL;
-    MVMuint64        repl_length;
 
     if (start < 0 || start > strgraphs)
         MVM_exception_throw_adhoc(tc, "start out of range");
@@ -528,47 +726,52 @@ char * MVM_string_utf8_encode_substr(MVMThreadContext *tc,
     if (length < 0 || start + length > strgraphs)
         MVM_exception_throw_adhoc(tc, "length out of range");
 
+    t.repl_bytes = NULL;
+    t.repl_length = 0;
     if (replacement)
-        repl_bytes = (MVMuint8 *) MVM_string_utf8_encode_substr(tc,
-            replacement, &repl_length, 0, -1, NULL, translate_newlines);
+        t.repl_bytes = (MVMuint8 *) MVM_string_utf8_encode_substr(tc,
+            replacement, &(t.repl_length), 0, -1, NULL, translate_newlines);
 
     /* Guesstimate that we'll be within 2 bytes for most chars most of the
      * time, and give ourselves 4 bytes breathing space. */
-    result_limit = 2 * length;
-    result       = MVM_malloc(result_limit + 4);
-    result_pos   = 0;
-
-    /* Iterate the codepoints and encode them. */
-    MVM_string_ci_init(tc, &ci, str, translate_newlines, 0);
-    while (MVM_string_ci_has_more(tc, &ci)) {
-        MVMint32 bytes;
-        MVMCodepoint cp = MVM_string_ci_get_codepoint(tc, &ci);
-        if (result_pos >= result_limit) {
-            result_limit *= 2;
-            result = MVM_realloc(result, result_limit + 4);
-        }
-        bytes = utf8_encode(result + result_pos, cp);
-        if (bytes)
-            result_pos += bytes;
-        else if (replacement) {
-            if (repl_length >= result_limit || result_pos >= result_limit - repl_length) {
-                result_limit += repl_length;
-                result = MVM_realloc(result, result_limit + 4);
+    t.result_pos   = 0;
+    t.result_limit = 2 * length;
+    t.result       = MVM_malloc(t.result_limit + 4);
+
+    if (!translate_newlines && start == 0 && length == strgraphs) {
+        /* Work directly on the storage of the string or of its strands. */
+        if (str->body.storage_type == MVM_STRING_STRAND) {
+            MVMuint16 i;
+            for (i = 0; i < str->body.num_strands; i++) {
+                MVMStringStrand *strand = &(str->body.storage.strands[i]);
+                MVMuint32 rep;
+                for (rep = 0; rep <= strand->repetitions; rep++)
+                    encode_flat_range(tc, &t, strand->blob_string, strand->start, strand->end);
             }
-            memcpy(result + result_pos, repl_bytes, repl_length);
-            result_pos += repl_length;
         }
         else {
-            MVM_free(result);
-            MVM_free(repl_bytes);
-            MVM_string_utf8_throw_encoding_exception(tc, cp);
+            encode_flat_range(tc, &t, str, 0, strgraphs);
+        }
+    }
+    else {
+        /* Iterate the codepoints and encode them. */
+        MVM_string_ci_init(tc, &ci, str, translate_newlines, 0);
+        while (MVM_string_ci_has_more(tc, &ci)) {
+            MVMCodepoint cp = MVM_string_ci_get_codepoint(tc, &ci);
+            if (cp >= 0 && cp < 0x80) {
+                ensure_target_space(tc, &t, 1);
+                t.result[t.result_pos++] = (MVMuint8)cp;
+            }
+            else {
+                encode_cp(tc, &t, cp);
+            }
         }
     }
 
     if (output_size)
-        *output_size = (MVMuint64)result_pos;
-    MVM_free(repl_bytes);
-    return (char *)result;
+        *output_size = (MVMuint64)t.result_pos;
+    MVM_free(t.repl_bytes);
+    return (char *)t.result;
 }
 
 /* Encodes the specified string to UTF-8. */
@@ -581,13 +784,10 @@ char * MVM_string_utf8_encode(MVMThreadContext *tc, MVMString *str, MVMuint64 *o
 /* Encodes the specified string to a UTF-8 C string. */
 char * MVM_string_utf8_encode_C_string(MVMThreadContext *tc, MVMString *str) {
     MVMuint64 output_size;
-    char * result = NULL;
-    char * utf8_string = MVM_string_utf8_encode(tc, str, &output_size, 0);
+    char * result = MVM_string_utf8_encode(tc, str, &output_size, 0);
     /* this is almost always called from error-handling code. Don't care if it
-     * contains embedded NULs. XXX TODO: Make sure all uses of this free what it returns */
-    result = MVM_malloc(output_size + 1);
-    memcpy(result, utf8_string, output_size);
-    MVM_free(utf8_string);
+     * contains embedded NULs. XXX TODO: Make sure all uses of this free what it returns.
+     * There are always 4 bytes of slack beyond the result, so room for the NUL. */
     result[output_size] = (char)0;
     return result;
 }
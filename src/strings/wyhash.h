@@ -0,0 +1,97 @@
+/* A fast keyed hash in the style of wyhash, built around a 64x64->128 bit
+ * multiply whose halves are folded together. Input is consumed in 16 byte
+ * blocks; it can be fed incrementally, and a stream of bytes gives the same
+ * result however it is split up, which lets callers hash data they have to
+ * produce on the fly the same way as data already in memory. */
+
+#define MVM_WYHASH_P0 0xa0761d6478bd642fULL
+#define MVM_WYHASH_P1 0xe7037ed1a0b428dbULL
+#define MVM_WYHASH_P2 0x8ebc6af09c88c6e3ULL
+#define MVM_WYHASH_BLOCK 16
+
+struct MVMWyHash {
+    MVMuint64 seed;
+    MVMuint64 key1;
+    MVMuint64 len;
+    MVMuint32 used;
+    MVMuint8  buf[MVM_WYHASH_BLOCK];
+};
+typedef struct MVMWyHash MVMWyHash;
+
+/* Multiplies a and b, leaving the low half of the result in a and the high
+ * half in b. */
+MVM_STATIC_INLINE void MVM_wyhash_mum(MVMuint64 *a, MVMuint64 *b) {
+#if defined(__SIZEOF_INT128__)
+    __uint128_t r = (__uint128_t)*a * *b;
+    *a = (MVMuint64)r;
+    *b = (MVMuint64)(r >> 64);
+#else
+    MVMuint64 ha = *a >> 32, hb = *b >> 32, la = (MVMuint32)*a, lb = (MVMuint32)*b;
+    MVMuint64 rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    MVMuint64 t  = rl + (rm0 << 32), c = t < rl, lo, hi;
+    lo = t + (rm1 << 32);
+    c += lo < t;
+    hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+    *a = lo;
+    *b = hi;
+#endif
+}
+MVM_STATIC_INLINE MVMuint64 MVM_wyhash_mix(MVMuint64 a, MVMuint64 b) {
+    MVM_wyhash_mum(&a, &b);
+    return a ^ b;
+}
+MVM_STATIC_INLINE MVMuint64 MVM_wyhash_read64(const MVMuint8 *p) {
+    MVMuint64 v;
+    memcpy(&v, p, sizeof(MVMuint64));
+    return v;
+}
+
+MVM_STATIC_INLINE void MVM_wyhash_init(MVMWyHash *wh, const MVMuint64 key[2]) {
+    wh->seed = key[0] ^ MVM_wyhash_mix(key[0] ^ MVM_WYHASH_P0, key[1] ^ MVM_WYHASH_P1);
+    wh->key1 = key[1];
+    wh->len  = 0;
+    wh->used = 0;
+}
+MVM_STATIC_INLINE MVMuint64 MVM_wyhash_block(MVMuint64 seed, const MVMuint8 *p) {
+    return MVM_wyhash_mix(MVM_wyhash_read64(p) ^ MVM_WYHASH_P1,
+        MVM_wyhash_read64(p + 8) ^ seed);
+}
+MVM_STATIC_INLINE void MVM_wyhash_add(MVMWyHash *wh, const MVMuint8 *p, size_t n) {
+    wh->len += n;
+    if (wh->used) {
+        size_t take = MVM_WYHASH_BLOCK - wh->used;
+        if (take > n)
+            take = n;
+        memcpy(wh->buf + wh->used, p, take);
+        wh->used += take;
+        p += take;
+        n -= take;
+        if (wh->used < MVM_WYHASH_BLOCK)
+            return;
+        wh->seed = MVM_wyhash_block(wh->seed, wh->buf);
+        wh->used = 0;
+    }
+    while (n >= MVM_WYHASH_BLOCK) {
+        wh->seed = MVM_wyhash_block(wh->seed, p);
+        p += MVM_WYHASH_BLOCK;
+        n -= MVM_WYHASH_BLOCK;
+    }
+    if (n) {
+        memcpy(wh->buf, p, n);
+        wh->used = n;
+    }
+}
+MVM_STATIC_INLINE MVMuint64 MVM_wyhash_finish(MVMWyHash *wh) {
+    MVMuint64 a, b;
+    memset(wh->buf + wh->used, 0, MVM_WYHASH_BLOCK - wh->used);
+    a = MVM_wyhash_read64(wh->buf) ^ MVM_WYHASH_P1;
+    b = MVM_wyhash_read64(wh->buf + 8) ^ wh->seed;
+    MVM_wyhash_mum(&a, &b);
+    return MVM_wyhash_mix(a ^ MVM_WYHASH_P0 ^ wh->len, b ^ MVM_WYHASH_P2 ^ wh->key1);
+}
+MVM_STATIC_INLINE MVMuint64 MVM_wyhash(const MVMuint8 *p, size_t n, const MVMuint64 key[2]) {
+    MVMWyHash wh;
+    MVM_wyhash_init(&wh, key);
+    MVM_wyhash_add(&wh, p, n);
+    return MVM_wyhash_finish(&wh);
+}
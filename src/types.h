@@ -38,6 +38,7 @@ typedef struct MVMDecoderBody MVMDecoderBody;
 typedef struct MVMDLLRegistry MVMDLLRegistry;
 typedef struct MVMDLLSym MVMDLLSym;
 typedef struct MVMDLLSymBody MVMDLLSymBody;
+typedef struct MVMEventLoop MVMEventLoop;
 typedef struct MVMException MVMException;
 typedef struct MVMExceptionBody MVMExceptionBody;
 typedef struct MVMExtOpRecord MVMExtOpRecord;
@@ -77,11 +78,15 @@ typedef struct MVMLexicalRegistry MVMLexicalRegistry;
 typedef struct MVMLoadedCompUnitName MVMLoadedCompUnitName;
 typedef struct MVMNFA MVMNFA;
 typedef struct MVMNFABody MVMNFABody;
+typedef struct MVMNFADFA MVMNFADFA;
+typedef struct MVMNFADFAState MVMNFADFAState;
+typedef struct MVMNFADFATransition MVMNFADFATransition;
 typedef struct MVMNFAStateInfo MVMNFAStateInfo;
 typedef struct MVMNFGState MVMNFGState;
 typedef struct MVMNFGSynthetic MVMNFGSynthetic;
 typedef struct MVMNFGTrieNode MVMNFGTrieNode;
 typedef struct MVMNFGTrieNodeEntry MVMNFGTrieNodeEntry;
+typedef struct MVMNFGCacheEntry MVMNFGCacheEntry;
 typedef struct MVMNativeCall MVMNativeCall;
 typedef struct MVMNativeCallBody MVMNativeCallBody;
 typedef struct MVMNativeRef MVMNativeRef;
@@ -218,6 +223,12 @@ typedef struct MVMStaticFrameSpeshBody MVMStaticFrameSpeshBody;
 typedef struct MVMStorageSpec MVMStorageSpec;
 typedef struct MVMString MVMString;
 typedef struct MVMStringBody MVMStringBody;
+typedef struct MVMStringBuilder MVMStringBuilder;
+typedef struct MVMStringBuilderBody MVMStringBuilderBody;
+typedef struct MVMMultiSearch MVMMultiSearch;
+typedef struct MVMMultiSearchBody MVMMultiSearchBody;
+typedef struct MVMMappedBuffer MVMMappedBuffer;
+typedef struct MVMMappedBufferBody MVMMappedBufferBody;
 typedef struct MVMStringConsts MVMStringConsts;
 typedef struct MVMStringStrand MVMStringStrand;
 typedef struct MVMGraphemeIter MVMGraphemeIter;
@@ -231,6 +242,10 @@ typedef struct MVMUnicodeGraphemeNameRegistry MVMUnicodeGraphemeNameRegistry;
 typedef struct MVMUninstantiable MVMUninstantiable;
 typedef struct MVMWorkThread MVMWorkThread;
 typedef struct MVMIOOps MVMIOOps;
+typedef struct MVMIOUring MVMIOUring;
+typedef struct MVMDNSCache MVMDNSCache;
+typedef struct MVMDNSCacheEntry MVMDNSCacheEntry;
+typedef struct MVMIOUringRequest MVMIOUringRequest;
 typedef struct MVMIOClosable MVMIOClosable;
 typedef struct MVMIOSyncReadable MVMIOSyncReadable;
 typedef struct MVMIOSyncWritable MVMIOSyncWritable;
@@ -245,6 +260,9 @@ typedef struct MVMDecodeStream MVMDecodeStream;
 typedef struct MVMDecodeStreamBytes MVMDecodeStreamBytes;
 typedef struct MVMDecodeStreamChars MVMDecodeStreamChars;
 typedef struct MVMDecodeStreamSeparators MVMDecodeStreamSeparators;
+typedef struct MVMStringMultiSearch MVMStringMultiSearch;
+typedef struct MVMStringMultiSearchNode MVMStringMultiSearchNode;
+typedef struct MVMStringMultiSearchEdge MVMStringMultiSearchEdge;
 typedef struct MVMNativeCallback MVMNativeCallback;
 typedef struct MVMNativeCallbackCacheHead MVMNativeCallbackCacheHead;
 typedef struct MVMJitGraph MVMJitGraph;
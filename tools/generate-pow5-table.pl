@@ -0,0 +1,59 @@
+#!/usr/bin/env perl
+use 5.014;
+use warnings; use strict;
+use Math::BigInt;
+# Generates src/strings/parse_num_pow5.h, the table of 128-bit truncated
+# powers of five used by the Eisel-Lemire number parser in parse_num.c.
+#
+# For each q from -342 to 308 it holds 5**q scaled by a power of two so that
+# its most significant bit is bit 127, as two 64-bit halves. Negative powers
+# are rounded up, non-negative ones truncated.
+#
+# Run from the root of the repository:
+#     perl tools/generate-pow5-table.pl > src/strings/parse_num_pow5.h
+
+my $smallest = -342;
+my $largest  = 308;
+my $two64    = Math::BigInt->new(1)->blsft(64);
+my $two127   = Math::BigInt->new(1)->blsft(127);
+my $two128   = Math::BigInt->new(1)->blsft(128);
+
+sub halves {
+    my ($n) = @_;
+    my ($hi, $lo) = $n->copy->bdiv($two64);
+    return sprintf("0x%016sULL, 0x%016sULL", lc substr($hi->as_hex, 2), lc substr($lo->as_hex, 2));
+}
+
+my @rows;
+for my $q ($smallest .. -1) {
+    my $power5 = Math::BigInt->new(5)->bpow(-$q);
+    my $z = 0;
+    $z++ while Math::BigInt->new(1)->blsft($z) < $power5;
+    my $c;
+    if ($q >= -27) {
+        $c = Math::BigInt->new(1)->blsft($z + 127)->bdiv($power5)->binc;
+    }
+    else {
+        $c = Math::BigInt->new(1)->blsft(2 * $z + 128)->bdiv($power5)->binc;
+        $c->brsft(1) while $c >= $two128;
+    }
+    push @rows, halves($c);
+}
+for my $q (0 .. $largest) {
+    my $power5 = Math::BigInt->new(5)->bpow($q);
+    $power5->blsft(1) while $power5 < $two127;
+    $power5->brsft(1) while $power5 >= $two128;
+    push @rows, halves($power5);
+}
+
+print <<"END";
+/* Generated by tools/generate-pow5-table.pl; do not edit by hand.
+ *
+ * Powers of five from 5^$smallest to 5^$largest, each scaled by a power of two
+ * so its most significant bit is bit 127, as (high, low) 64-bit halves. */
+#define MVM_POW5_SMALLEST_POWER $smallest
+#define MVM_POW5_LARGEST_POWER  $largest
+static const MVMuint64 MVM_pow5_128[] = {
+END
+print "    $_,\n" for @rows;
+print "};\n";